@@ -0,0 +1,62 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+
+namespace Config
+{
+// Keeps the value of a setting until the config changes, for settings that are read too often
+// to look them up in every layer and parse them each time (e.g. every frame). As long as nothing
+// has changed, reading the value is a single atomic load and compare.
+//
+// A CachedValue can be read from any thread. Looking up the value after a change has the same
+// restrictions as Config::Get.
+template <typename T>
+class CachedValue
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "CachedValue only supports types that fit in a std::atomic");
+
+public:
+  explicit CachedValue(const ConfigInfo<T>& info) : m_info(info) {}
+
+  CachedValue(const CachedValue&) = delete;
+  CachedValue& operator=(const CachedValue&) = delete;
+
+  T Get()
+  {
+    if (m_version.load(std::memory_order_acquire) != GetConfigVersion())
+      Update();
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+  operator T() { return Get(); }
+
+private:
+  void Update()
+  {
+    std::lock_guard<std::mutex> lock(m_update_mutex);
+
+    // Read the version first, so that a change while we look up the value is noticed next time.
+    const u64 version = GetConfigVersion();
+    if (m_version.load(std::memory_order_relaxed) == version)
+      return;
+
+    m_value.store(Config::Get(m_info), std::memory_order_relaxed);
+    m_version.store(version, std::memory_order_release);
+  }
+
+  const ConfigInfo<T> m_info;
+  std::atomic<T> m_value{};
+  std::atomic<u64> m_version{0};
+  std::mutex m_update_mutex;
+};
+}
@@ -3,17 +3,26 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
-#include <list>
+#include <atomic>
 #include <map>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Config/Config.h"
 
 namespace Config
 {
+namespace detail
+{
+// Starts above 0 so that a CachedValue is never considered up to date before its first Get.
+std::atomic<u64> g_config_version{1};
+}
+
 static Layers s_layers;
-static std::list<ConfigChangedCallback> s_callbacks;
+static std::vector<std::pair<ConfigChangedCallbackID, ConfigChangedCallback>> s_callbacks;
+static ConfigChangedCallbackID s_next_callback_id = 0;
 
 void InvokeConfigChangedCallbacks();
 
@@ -50,15 +59,28 @@ bool LayerExists(LayerType layer)
   return s_layers.find(layer) != s_layers.end();
 }
 
-void AddConfigChangedCallback(ConfigChangedCallback func)
+ConfigChangedCallbackID AddConfigChangedCallback(ConfigChangedCallback func)
 {
-  s_callbacks.emplace_back(func);
+  const ConfigChangedCallbackID id = s_next_callback_id++;
+  s_callbacks.emplace_back(id, std::move(func));
+  return id;
+}
+
+void RemoveConfigChangedCallback(ConfigChangedCallbackID id)
+{
+  s_callbacks.erase(std::remove_if(s_callbacks.begin(), s_callbacks.end(),
+                                   [id](const auto& callback) { return callback.first == id; }),
+                    s_callbacks.end());
 }
 
 void InvokeConfigChangedCallbacks()
 {
-  for (const auto& callback : s_callbacks)
-    callback();
+  ++detail::g_config_version;
+
+  // Callbacks may add or remove callbacks, so don't iterate over s_callbacks directly.
+  const auto callbacks = s_callbacks;
+  for (const auto& callback : callbacks)
+    callback.second();
 }
 
 // Explicit load and save of layers
@@ -84,11 +106,13 @@ void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  ++detail::g_config_version;
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  ++detail::g_config_version;
 }
 
 static const std::map<System, std::string> system_to_name = {
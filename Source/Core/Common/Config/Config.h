@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
@@ -18,6 +19,7 @@ namespace Config
 {
 using Layers = std::map<LayerType, std::unique_ptr<Layer>>;
 using ConfigChangedCallback = std::function<void()>;
+using ConfigChangedCallbackID = size_t;
 
 // Layer management
 Layers* GetLayers();
@@ -27,9 +29,18 @@ Layer* GetLayer(LayerType layer);
 void RemoveLayer(LayerType layer);
 bool LayerExists(LayerType layer);
 
-void AddConfigChangedCallback(ConfigChangedCallback func);
+// The returned ID can be used to remove the callback again, e.g. when its owner is destroyed.
+ConfigChangedCallbackID AddConfigChangedCallback(ConfigChangedCallback func);
+void RemoveConfigChangedCallback(ConfigChangedCallbackID id);
 void InvokeConfigChangedCallbacks();
 
+// Changes whenever any value in any layer might have changed, so that anything derived from the
+// config can be cached until then. See CachedValue.
+inline u64 GetConfigVersion()
+{
+  return detail::g_config_version.load(std::memory_order_acquire);
+}
+
 // Explicit load and save of layers
 void Load();
 void Save();
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -40,6 +41,9 @@ inline std::optional<std::string> TryParse(const std::string& str_value)
 {
   return str_value;
 }
+
+// Incremented after any change to any layer. Use Config::GetConfigVersion to read it.
+extern std::atomic<u64> g_config_version;
 }
 
 template <typename T>
@@ -128,6 +132,7 @@ public:
       return;
     m_is_dirty = true;
     current_value = new_value;
+    ++detail::g_config_version;
   }
 
   Section GetSection(System system, const std::string& section);
@@ -0,0 +1,90 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ForkJoinPool.h"
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ForkJoinPool::ForkJoinPool(size_t num_threads, const std::string& name) : m_name(name)
+{
+  m_threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+    m_threads.emplace_back(&ForkJoinPool::ThreadLoop, this, i + 1);
+}
+
+ForkJoinPool::~ForkJoinPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_wake.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+void ForkJoinPool::Run(size_t num_tasks, const TaskFunction& func)
+{
+  if (num_tasks == 0)
+    return;
+
+  if (m_threads.empty() || num_tasks == 1)
+  {
+    for (size_t task = 0; task < num_tasks; ++task)
+      func(task, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_func = &func;
+    m_num_tasks = num_tasks;
+    m_next_task.store(0, std::memory_order_relaxed);
+    m_busy_threads = m_threads.size();
+    ++m_batch;
+  }
+  m_wake.notify_all();
+
+  RunTasks(0);
+
+  // Every thread has to check in, even if the batch was over before it woke up, so that none of
+  // them is still looking at func when we return.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_busy_threads == 0; });
+  m_func = nullptr;
+}
+
+void ForkJoinPool::ThreadLoop(size_t worker)
+{
+  SetCurrentThreadName(m_name.c_str());
+
+  u64 last_batch = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] { return m_shutdown || m_batch != last_batch; });
+      if (m_shutdown)
+        return;
+      last_batch = m_batch;
+    }
+
+    RunTasks(worker);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_busy_threads == 0)
+      m_done.notify_one();
+  }
+}
+
+void ForkJoinPool::RunTasks(size_t worker)
+{
+  size_t task;
+  while ((task = m_next_task.fetch_add(1, std::memory_order_relaxed)) < m_num_tasks)
+    (*m_func)(task, worker);
+}
+}  // namespace Common
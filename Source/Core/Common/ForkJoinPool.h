@@ -0,0 +1,63 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// A fixed set of threads that run one batch of tasks at a time, for work that has to be finished
+// before the caller can continue (e.g. everything the DSP mixes for one audio frame).
+//
+// The calling thread works on the batch too, so a batch never waits for a thread to wake up
+// before it can make progress, and a pool without threads simply runs everything inline.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+class ForkJoinPool
+{
+public:
+  // Called with the task index and the index of the worker running it. Worker 0 is the thread
+  // that called Run(); the pool's own threads are 1 to GetWorkerCount() - 1.
+  using TaskFunction = std::function<void(size_t task, size_t worker)>;
+
+  ForkJoinPool(size_t num_threads, const std::string& name);
+  ~ForkJoinPool();
+
+  ForkJoinPool(const ForkJoinPool&) = delete;
+  ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+  size_t GetWorkerCount() const { return m_threads.size() + 1; }
+
+  // Runs func for every task in [0, num_tasks) and returns once all of them are done. Tasks are
+  // handed out in order, but may run concurrently and finish in any order.
+  void Run(size_t num_tasks, const TaskFunction& func);
+
+private:
+  void ThreadLoop(size_t worker);
+  void RunTasks(size_t worker);
+
+  std::vector<std::thread> m_threads;
+  std::string m_name;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  bool m_shutdown = false;
+  u64 m_batch = 0;
+  size_t m_busy_threads = 0;
+
+  const TaskFunction* m_func = nullptr;
+  size_t m_num_tasks = 0;
+  std::atomic<size_t> m_next_task{0};
+};
+}  // namespace Common
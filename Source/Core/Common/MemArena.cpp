@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <set>
@@ -24,7 +25,12 @@
 #include <unistd.h>
 #ifdef ANDROID
 #include <linux/ashmem.h>
+#endif
+#ifdef __linux__
+#include <linux/fs.h>
+#include <linux/userfaultfd.h>
 #include <sys/ioctl.h>
+#include <sys/syscall.h>
 #endif
 #endif
 
@@ -52,6 +58,129 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 }
 #endif
 
+#ifdef __linux__
+// Older kernel headers lack the userfaultfd write protection and PAGEMAP_SCAN definitions.
+// The values are part of the kernel ABI.
+#ifndef UFFD_USER_MODE_ONLY
+#define UFFD_USER_MODE_ONLY 1
+#endif
+#ifndef UFFD_FEATURE_WP_HUGETLBFS_SHMEM
+#define UFFD_FEATURE_WP_HUGETLBFS_SHMEM (1 << 12)
+#endif
+#ifndef UFFD_FEATURE_WP_UNPOPULATED
+#define UFFD_FEATURE_WP_UNPOPULATED (1 << 13)
+#endif
+#ifndef UFFD_FEATURE_WP_ASYNC
+#define UFFD_FEATURE_WP_ASYNC (1 << 15)
+#endif
+#ifndef PAGEMAP_SCAN
+struct page_region
+{
+  u64 start;
+  u64 end;
+  u64 categories;
+};
+
+struct pm_scan_arg
+{
+  u64 size;
+  u64 flags;
+  u64 start;
+  u64 end;
+  u64 walk_end;
+  u64 vec;
+  u64 vec_len;
+  u64 max_pages;
+  u64 category_inverted;
+  u64 category_mask;
+  u64 category_anyof_mask;
+  u64 return_mask;
+};
+
+#define PAGEMAP_SCAN _IOWR('f', 16, struct pm_scan_arg)
+#define PAGE_IS_WRITTEN (1 << 3)
+#endif
+
+static int OpenWriteProtectFD()
+{
+  const int uffd =
+      static_cast<int>(syscall(SYS_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY));
+  if (uffd < 0)
+    return -1;
+
+  // Asynchronous write protection: the kernel resolves the faults by itself and only records
+  // that the page was written, so nobody has to service the descriptor.
+  uffdio_api api = {};
+  api.api = UFFD_API;
+  api.features =
+      UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_HUGETLBFS_SHMEM | UFFD_FEATURE_WP_UNPOPULATED;
+  if (ioctl(uffd, UFFDIO_API, &api) < 0)
+  {
+    close(uffd);
+    return -1;
+  }
+  return uffd;
+}
+
+static int GetPagemapFD()
+{
+  static const int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+  return pagemap;
+}
+
+// Write protects [address, address + size) again, so that only later writes are reported.
+static bool ProtectRange(int uffd, void* address, size_t size, bool register_range)
+{
+  if (register_range)
+  {
+    uffdio_register reg = {};
+    reg.range.start = reinterpret_cast<uintptr_t>(address);
+    reg.range.len = size;
+    reg.mode = UFFDIO_REGISTER_MODE_WP;
+    if (ioctl(uffd, UFFDIO_REGISTER, &reg) < 0)
+      return false;
+  }
+
+  uffdio_writeprotect protect = {};
+  protect.range.start = reinterpret_cast<uintptr_t>(address);
+  protect.range.len = size;
+  protect.mode = UFFDIO_WRITEPROTECT_MODE_WP;
+  return ioctl(uffd, UFFDIO_WRITEPROTECT, &protect) >= 0;
+}
+
+// Marks the pages of [address, address + num_pages * page size) that were written since they
+// were last protected. Returns false if the page map can't be read.
+static bool ScanWrittenPages(const u8* address, size_t num_pages, std::vector<bool>* out,
+                             size_t out_offset)
+{
+  const size_t page_size = MemArena::GetPageSize();
+  const u64 start = reinterpret_cast<uintptr_t>(address);
+  const u64 end = start + num_pages * page_size;
+  std::vector<page_region> regions((num_pages + 1) / 2);
+
+  pm_scan_arg arg = {};
+  arg.size = sizeof(arg);
+  arg.start = start;
+  arg.end = end;
+  arg.vec = reinterpret_cast<uintptr_t>(regions.data());
+  arg.vec_len = regions.size();
+  arg.category_mask = PAGE_IS_WRITTEN;
+  arg.return_mask = PAGE_IS_WRITTEN;
+  const int count = ioctl(GetPagemapFD(), PAGEMAP_SCAN, &arg);
+  if (count < 0)
+    return false;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const size_t first = static_cast<size_t>(regions[i].start - start) / page_size;
+    const size_t last = static_cast<size_t>(regions[i].end - start) / page_size;
+    for (size_t page = first; page < last; ++page)
+      (*out)[out_offset + page] = true;
+  }
+  return true;
+}
+#endif
+
 void MemArena::GrabSHMSegment(size_t size)
 {
 #ifdef _WIN32
@@ -81,6 +210,16 @@ void MemArena::GrabSHMSegment(size_t size)
 
 void MemArena::ReleaseSHMSegment()
 {
+  m_views.clear();
+  m_released_dirty_pages.clear();
+  m_dirty_tracking = false;
+#ifdef __linux__
+  if (m_uffd >= 0)
+  {
+    close(m_uffd);
+    m_uffd = -1;
+  }
+#endif
 #ifdef _WIN32
   CloseHandle(hMemoryMapping);
   hMemoryMapping = 0;
@@ -104,6 +243,12 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
   }
   else
   {
+    m_views.push_back({static_cast<u8*>(retval), offset, size});
+#ifdef __linux__
+    // Pages written through a new view have to be reported too.
+    if (m_dirty_tracking && !ProtectRange(m_uffd, retval, size, true))
+      ERROR_LOG(MEMMAP, "Failed to track writes to a new view");
+#endif
     return retval;
   }
 #endif
@@ -111,6 +256,31 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
 
 void MemArena::ReleaseView(void* view, size_t size)
 {
+  auto it = std::find_if(m_views.begin(), m_views.end(),
+                         [view](const View& v) { return v.base == view; });
+  if (it != m_views.end())
+  {
+    // The write tracking goes away with the mapping, so remember the dirty pages for the next
+    // query.
+    if (m_dirty_tracking)
+    {
+      const size_t page_size = GetPageSize();
+      const size_t first_page = static_cast<size_t>(it->offset) / page_size;
+      const size_t num_pages = (it->size + page_size - 1) / page_size;
+      if (m_released_dirty_pages.size() < first_page + num_pages)
+        m_released_dirty_pages.resize(first_page + num_pages);
+
+      std::vector<bool> dirty;
+      CollectDirtyPages(*it, it->offset, num_pages * page_size, &dirty);
+      for (size_t i = 0; i < num_pages; ++i)
+      {
+        if (dirty[i])
+          m_released_dirty_pages[first_page + i] = true;
+      }
+    }
+    m_views.erase(it);
+  }
+
 #ifdef _WIN32
   UnmapViewOfFile(view);
 #else
@@ -118,6 +288,123 @@ void MemArena::ReleaseView(void* view, size_t size)
 #endif
 }
 
+size_t MemArena::GetPageSize()
+{
+#ifdef _WIN32
+  return 0x1000;
+#else
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+#endif
+}
+
+bool MemArena::IsDirtyTrackingSupported()
+{
+#ifdef __linux__
+  // Needs asynchronous userfaultfd write protection and PAGEMAP_SCAN (Linux 6.7). Check with a
+  // scratch page that protecting a present page works and that a later write shows up.
+  static const bool supported = [] {
+    const int uffd = OpenWriteProtectFD();
+    if (uffd < 0)
+      return false;
+
+    const size_t page_size = GetPageSize();
+    void* page = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+    bool result = false;
+    if (page != MAP_FAILED)
+    {
+      std::vector<bool> dirty(1);
+      *static_cast<volatile u8*>(page) = 1;
+      if (ProtectRange(uffd, page, page_size, true) &&
+          ScanWrittenPages(static_cast<u8*>(page), 1, &dirty, 0) && !dirty[0])
+      {
+        *static_cast<volatile u8*>(page) = 2;
+        result = ScanWrittenPages(static_cast<u8*>(page), 1, &dirty, 0) && dirty[0];
+      }
+      munmap(page, page_size);
+    }
+    close(uffd);
+    return result;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+bool MemArena::ResetDirtyPages()
+{
+  if (!IsDirtyTrackingSupported())
+    return false;
+
+#ifdef __linux__
+  // Only the views of this arena are tracked, the rest of the process is left alone.
+  const bool register_views = m_uffd < 0;
+  if (register_views)
+  {
+    m_uffd = OpenWriteProtectFD();
+    if (m_uffd < 0)
+      return false;
+  }
+  for (const View& view : m_views)
+  {
+    if (!ProtectRange(m_uffd, view.base, view.size, register_views))
+      return false;
+  }
+#endif
+  m_released_dirty_pages.assign(m_released_dirty_pages.size(), false);
+  m_dirty_tracking = true;
+  return true;
+}
+
+void MemArena::CollectDirtyPages(const View& view, s64 offset, size_t size,
+                                 std::vector<bool>* out) const
+{
+  const size_t page_size = GetPageSize();
+  out->assign(size / page_size, false);
+
+  const s64 start = std::max(offset, view.offset);
+  const s64 end =
+      std::min(offset + static_cast<s64>(size), view.offset + static_cast<s64>(view.size));
+  if (start >= end)
+    return;
+
+#ifdef __linux__
+  const size_t num_pages = static_cast<size_t>(end - start) / page_size;
+  const size_t first_page = static_cast<size_t>(start - offset) / page_size;
+  if (!ScanWrittenPages(view.base + (start - view.offset), num_pages, out, first_page))
+  {
+    // Without the page map we can't prove anything was left untouched.
+    std::fill(out->begin(), out->end(), true);
+  }
+#endif
+}
+
+bool MemArena::GetDirtyPages(s64 offset, size_t size, std::vector<bool>* out) const
+{
+  if (!m_dirty_tracking)
+    return false;
+
+  const size_t page_size = GetPageSize();
+  const size_t first_page = static_cast<size_t>(offset) / page_size;
+  out->assign(size / page_size, false);
+  for (size_t i = 0; i < out->size() && first_page + i < m_released_dirty_pages.size(); ++i)
+    (*out)[i] = m_released_dirty_pages[first_page + i];
+
+  std::vector<bool> view_dirty;
+  for (const View& view : m_views)
+  {
+    CollectDirtyPages(view, offset, size, &view_dirty);
+    for (size_t i = 0; i < out->size(); ++i)
+    {
+      if (view_dirty[i])
+        (*out)[i] = true;
+    }
+  }
+  return true;
+}
+
 u8* MemArena::FindMemoryBase()
 {
 #if _ARCH_32
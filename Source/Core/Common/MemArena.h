@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -25,13 +26,41 @@ public:
   void* CreateView(s64 offset, size_t size, void* base = nullptr);
   void ReleaseView(void* view, size_t size);
 
+  // Dirty page tracking. A page of the segment counts as dirty if it has been written through any
+  // of its views since the last ResetDirtyPages(). The views are write protected with userfaultfd
+  // and scanned with PAGEMAP_SCAN, so this needs Linux 6.7 and is unavailable elsewhere.
+  static bool IsDirtyTrackingSupported();
+  static size_t GetPageSize();
+  bool ResetDirtyPages();
+  // Resizes out to one entry per page of [offset, offset + size) and marks the dirty ones.
+  // offset and size must be page aligned. Returns false if tracking is unavailable.
+  bool GetDirtyPages(s64 offset, size_t size, std::vector<bool>* out) const;
+
   // This finds 1 GB in 32-bit, 16 GB in 64-bit.
   static u8* FindMemoryBase();
 
 private:
+  struct View
+  {
+    u8* base;
+    s64 offset;
+    size_t size;
+  };
+
+  void CollectDirtyPages(const View& view, s64 offset, size_t size, std::vector<bool>* out) const;
+
 #ifdef _WIN32
   HANDLE hMemoryMapping;
 #else
   int fd;
 #endif
+#ifdef __linux__
+  // userfaultfd the views are registered with for write tracking
+  int m_uffd = -1;
+#endif
+
+  std::vector<View> m_views;
+  // Dirty pages of views that have already been released, indexed by segment page.
+  std::vector<bool> m_released_dirty_pages;
+  bool m_dirty_tracking = false;
 };
@@ -14,6 +14,10 @@
 #include <sys/time.h>
 #endif
 
+#ifdef __APPLE__
+#include <mach/mach_time.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
@@ -62,6 +66,38 @@ u64 Timer::GetTimeUs()
 #endif
 }
 
+u64 Timer::GetTimeNs()
+{
+#ifdef _WIN32
+  LARGE_INTEGER time;
+  static const u64 freq = [] {
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    return u64(f.QuadPart);
+  }();
+  QueryPerformanceCounter(&time);
+  // Split the conversion to avoid overflowing the 64-bit intermediate
+  const u64 ticks = u64(time.QuadPart);
+  return (ticks / freq) * 1000000000 + (ticks % freq) * 1000000000 / freq;
+#elif defined __APPLE__
+  // gettimeofday is wall clock time, which jumps when the clock is adjusted.
+  // clock_gettime_nsec_np would need 10.12, so use the mach timebase directly.
+  static const mach_timebase_info_data_t timebase = [] {
+    mach_timebase_info_data_t info;
+    mach_timebase_info(&info);
+    return info;
+  }();
+  const u64 ticks = mach_absolute_time();
+  // Split the conversion to avoid overflowing the 64-bit intermediate
+  return (ticks / timebase.denom) * timebase.numer +
+         (ticks % timebase.denom) * timebase.numer / timebase.denom;
+#else
+  struct timespec t;
+  (void)clock_gettime(CLOCK_MONOTONIC, &t);
+  return ((u64)t.tv_sec * 1000000000 + (u64)t.tv_nsec);
+#endif
+}
+
 // --------------------------------------------
 // Initiate, Start, Stop, and Update the time
 // --------------------------------------------
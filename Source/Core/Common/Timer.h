@@ -38,6 +38,8 @@ public:
 
   static u32 GetTimeMs();
   static u64 GetTimeUs();
+  // Monotonic clock with nanosecond units, for pacing that needs sub-millisecond precision
+  static u64 GetTimeNs();
 
   // Arbitrarily chosen value (38 years) that is subtracted in GetDoubleTime()
   // to increase sub-second precision of the resulting double timestamp
@@ -44,6 +44,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PrimeHack/HackConfig.h"
 
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
@@ -72,7 +73,7 @@ BootParameters::GenerateFromFile(const std::string& path,
   std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
   static const std::unordered_set<std::string> disc_image_extensions = {
-    { ".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".dol", ".elf" } };
+    { ".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".dcz", ".dol", ".elf" } };
   if (disc_image_extensions.find(extension) != disc_image_extensions.end() || is_drive)
   {
     std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolumeFromFilename(path);
@@ -440,6 +441,7 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
 
   PatchEngine::LoadPatches();
   HLE::PatchFixedFunctions();
+  prime::GetHackManager()->dispatch(prime::HackEvent::BOOT);
   return true;
 }
 
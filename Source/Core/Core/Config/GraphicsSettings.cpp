@@ -45,9 +45,18 @@ const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "Cache
                                                 true};
 const ConfigInfo<bool> GFX_WAIT_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "WaitForCachedHiresTextures"},
                                                 true};
+const ConfigInfo<int> GFX_HIRES_UPLOAD_BUDGET{{System::GFX, "Settings", "HiresUploadBudget"}, 0};
+const ConfigInfo<int> GFX_HIRES_ROOM_PREFETCH_BUDGET{
+    {System::GFX, "Settings", "HiresRoomPrefetchBudget"}, 256};
+const ConfigInfo<int> GFX_HIRES_TEXTURE_CACHE_BUDGET{
+    {System::GFX, "Settings", "HiresTextureCacheBudget"}, 0};
+const ConfigInfo<bool> GFX_HIRES_TEXTURE_COMPRESSION{
+    {System::GFX, "Settings", "CompressHiresTextures"}, false};
 const ConfigInfo<bool> GFX_DUMP_EFB_TARGET{{System::GFX, "Settings", "DumpEFBTarget"}, false};
 const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES{{System::GFX, "Settings", "DumpFramesAsImages"},
                                                  false};
+const ConfigInfo<bool> GFX_DUMP_FRAMES_DROP_WHEN_BEHIND{
+    {System::GFX, "Settings", "DumpFramesDropWhenBehind"}, false};
 const ConfigInfo<bool> GFX_FREE_LOOK{{System::GFX, "Settings", "FreeLook"}, false};
 const ConfigInfo<bool> GFX_COMPILE_SHADERS_ON_STARTUP{ { System::GFX, "Settings", "CompileShaderOnStartup" }, true };
 const ConfigInfo<bool> GFX_USE_BLACK_FRAME_INSERTION{ {System::GFX, "Settings", "UseBlackFrameInsertion"}, false};
@@ -172,6 +181,7 @@ const ConfigInfo<int> GFX_HACK_BBOX_MODE{{System::GFX, "Hacks", "BoundingBoxMode
 const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE{{System::GFX, "Hacks", "ForceProgressive"}, true};
 const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM{{System::GFX, "Hacks", "EFBToTextureEnable"},
                                                      true};
+const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES{{System::GFX, "Hacks", "DeferEFBCopies"}, false};
 const ConfigInfo<bool> GFX_HACK_COPY_EFB_SCALED{{System::GFX, "Hacks", "EFBScaledCopy"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES{
     {System::GFX, "Hacks", "EFBEmulateFormatChanges"}, false};
@@ -214,5 +224,7 @@ const ConfigInfo<int> ARMPOSITION_UPDOWN{{System::GFX, "PrimeHack Misc", "ArmPos
 const ConfigInfo<int> ARMPOSITION_FORWARDBACK{{System::GFX, "PrimeHack Misc", "ArmPosition_FORWARDBACK"}, -35};
 
 const ConfigInfo<bool> TOGGLE_PRIMEHACK_INFO{{System::GFX, "Settings", "primehackInfo"}, false};
+const ConfigInfo<std::string> PRIMEHACK_INFO_EXPORT{
+    {System::GFX, "Settings", "primehackInfoExport"}, ""};
 
 }  // namespace Config
@@ -38,8 +38,13 @@ extern const ConfigInfo<bool> GFX_HIRES_MATERIAL_MAPS;
 extern const ConfigInfo<bool> GFX_HIRES_MATERIAL_MAPS_BUILD;
 extern const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES;
 extern const ConfigInfo<bool> GFX_WAIT_CACHE_HIRES_TEXTURES;
+extern const ConfigInfo<int> GFX_HIRES_UPLOAD_BUDGET;
+extern const ConfigInfo<int> GFX_HIRES_ROOM_PREFETCH_BUDGET;
+extern const ConfigInfo<int> GFX_HIRES_TEXTURE_CACHE_BUDGET;
+extern const ConfigInfo<bool> GFX_HIRES_TEXTURE_COMPRESSION;
 extern const ConfigInfo<bool> GFX_DUMP_EFB_TARGET;
 extern const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES;
+extern const ConfigInfo<bool> GFX_DUMP_FRAMES_DROP_WHEN_BEHIND;
 extern const ConfigInfo<bool> GFX_FREE_LOOK;
 extern const ConfigInfo<bool> GFX_COMPILE_SHADERS_ON_STARTUP;
 extern const ConfigInfo<bool> GFX_USE_BLACK_FRAME_INSERTION;
@@ -133,6 +138,7 @@ extern const ConfigInfo<bool> GFX_HACK_EFB_FAST_ACCESS_ENABLE;
 extern const ConfigInfo<int> GFX_HACK_BBOX_MODE;
 extern const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE;
 extern const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
+extern const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES;
 extern const ConfigInfo<bool> GFX_HACK_COPY_EFB_SCALED;
 extern const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
 extern const ConfigInfo<bool> GFX_HACK_VERTEX_ROUDING;
@@ -170,6 +176,7 @@ extern const ConfigInfo<int> ARMPOSITION_UPDOWN;
 extern const ConfigInfo<int> ARMPOSITION_FORWARDBACK;
 
 extern const ConfigInfo<bool> TOGGLE_PRIMEHACK_INFO;
+extern const ConfigInfo<std::string> PRIMEHACK_INFO_EXPORT;
 
 
 }  // namespace Config
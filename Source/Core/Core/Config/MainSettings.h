@@ -18,6 +18,8 @@ extern const ConfigInfo<bool> MAIN_FASTMEM;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const ConfigInfo<bool> MAIN_DSP_HLE;
 extern const ConfigInfo<int> MAIN_TIMING_VARIANCE;
+extern const ConfigInfo<bool> MAIN_PRECISE_FRAME_PACING;
+extern const ConfigInfo<int> MAIN_FRAME_PACING_SLACK;
 extern const ConfigInfo<bool> MAIN_CPU_THREAD;
 extern const ConfigInfo<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const ConfigInfo<std::string> MAIN_DEFAULT_ISO;
@@ -53,6 +55,7 @@ extern const ConfigInfo<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const ConfigInfo<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const ConfigInfo<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const ConfigInfo<bool> MAIN_FAST_DISC_SPEED;
+extern const ConfigInfo<bool> MAIN_DVD_PREFETCH;
 extern const ConfigInfo<bool> MAIN_DCBZ;
 extern const ConfigInfo<bool> MAIN_LOW_DCBZ_HACK;
 extern const ConfigInfo<bool> MAIN_FPRF;
@@ -72,6 +75,7 @@ extern const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS;
 
 extern const ConfigInfo<bool> MAIN_DSP_CAPTURE_LOG;
 extern const ConfigInfo<bool> MAIN_DSP_JIT;
+extern const ConfigInfo<bool> MAIN_DSP_PARALLEL_AX;
 extern const ConfigInfo<bool> MAIN_DUMP_AUDIO;
 extern const ConfigInfo<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const ConfigInfo<bool> MAIN_DUMP_UCODE;
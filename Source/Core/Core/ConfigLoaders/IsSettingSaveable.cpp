@@ -47,8 +47,13 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HIRES_MATERIAL_MAPS_BUILD.location,
       Config::GFX_CACHE_HIRES_TEXTURES.location,
       Config::GFX_WAIT_CACHE_HIRES_TEXTURES.location,
+      Config::GFX_HIRES_UPLOAD_BUDGET.location,
+      Config::GFX_HIRES_ROOM_PREFETCH_BUDGET.location,
+      Config::GFX_HIRES_TEXTURE_CACHE_BUDGET.location,
+      Config::GFX_HIRES_TEXTURE_COMPRESSION.location,
       Config::GFX_DUMP_EFB_TARGET.location,
       Config::GFX_DUMP_FRAMES_AS_IMAGES.location,
+      Config::GFX_DUMP_FRAMES_DROP_WHEN_BEHIND.location,
       Config::GFX_FREE_LOOK.location,
       Config::GFX_COMPILE_SHADERS_ON_STARTUP.location,
       Config::GFX_USE_FFV1.location,
@@ -134,6 +139,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HACK_BBOX_MODE.location,
       Config::GFX_HACK_FORCE_PROGRESSIVE.location,
       Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location,
+      Config::GFX_HACK_DEFER_EFB_COPIES.location,
       Config::GFX_HACK_COPY_EFB_SCALED.location,
       Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES.location,
       Config::GFX_HACK_VERTEX_ROUDING.location,
@@ -154,6 +160,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
 
      // Graphics.PrimeHack
       Config::TOGGLE_PRIMEHACK_INFO.location,
+      Config::PRIMEHACK_INFO_EXPORT.location,
       Config::TOGGLE_ARM_REPOSITION.location,
       Config::AUTO_EFB.location,
       Config::LOCKCAMERA_IN_PUZZLES.location,
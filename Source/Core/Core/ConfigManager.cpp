@@ -39,6 +39,7 @@
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PrimeHack/HackConfig.h"
 #include "Core/TitleDatabase.h"
 #include "VideoCommon/HiresTextures.h"
 
@@ -237,6 +238,9 @@ void SConfig::SaveCoreSettings(IniFile& ini)
 
   core->Set("SkipIPL", bHLE_BS2);
   core->Set("TimingVariance", iTimingVariance);
+  core->Set("PreciseFramePacing", bPreciseFramePacing);
+  core->Set("FramePacingSlack", iFramePacingSlack);
+  core->Set("DVDPrefetch", bDVDPrefetch);
   core->Set("CPUCore", iCPUCore);
   core->Set("Fastmem", bFastmem);
   core->Set("CPUThread", bCPUThread);
@@ -560,6 +564,8 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("Fastmem", &bFastmem, true);
   core->Get("DSPHLE", &bDSPHLE, true);
   core->Get("TimingVariance", &iTimingVariance, 40);
+  core->Get("PreciseFramePacing", &bPreciseFramePacing, false);
+  core->Get("FramePacingSlack", &iFramePacingSlack, 200);
   core->Get("CPUThread", &bCPUThread, true);
   core->Get("SyncOnSkipIdle", &bSyncGPUOnSkipIdleHack, true);
   core->Get("DefaultISO", &m_strDefaultISO);
@@ -600,6 +606,7 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("SyncGpuMinDistance", &iSyncGpuMinDistance, -200000);
   core->Get("SyncGpuOverclock", &fSyncGpuOverclock, 1.0f);
   core->Get("FastDiscSpeed", &bFastDiscSpeed, false);
+  core->Get("DVDPrefetch", &bDVDPrefetch, false);
   core->Get("DCBZ", &bDCBZOFF, false);
   core->Get("LowDCBZHack", &bLowDCBZHack, false);
   core->Get("FPRF", &bFPRF, false);
@@ -810,6 +817,7 @@ void SConfig::SetRunningGameMetadata(const std::string& game_id, u64 title_id, u
     CBoot::LoadMapFromFilename();
     HLE::Reload();
     PatchEngine::Reload();
+    prime::GetHackManager()->dispatch(prime::HackEvent::BOOT);
     HiresTexture::Update();
     DolphinAnalytics::Instance()->ReportGameStart();
   }
@@ -831,6 +839,8 @@ void SConfig::LoadDefaults()
   bEnableCheats = true;	
   iCPUCore = PowerPC::DefaultCPUCore();
   iTimingVariance = 40;
+  bPreciseFramePacing = false;
+  iFramePacingSlack = 200;
   bCPUThread = false;
   bSyncGPUOnSkipIdleHack = true;
   bRunCompareServer = false;
@@ -848,6 +858,7 @@ void SConfig::LoadDefaults()
   iBBDumpPort = -1;
   bSyncGPU = false;
   bFastDiscSpeed = false;
+  bDVDPrefetch = false;
   m_strWiiSDCardPath = File::GetUserPath(F_WIISDCARD_IDX);
   bEnableMemcardSdWriting = true;
   SelectedLanguage = 0;
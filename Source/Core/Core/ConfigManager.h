@@ -96,6 +96,8 @@ struct SConfig
   bool bAccurateNaNs = false;
 
   int iTimingVariance = 40;  // in milli secounds
+  bool bPreciseFramePacing = false;
+  int iFramePacingSlack = 200;  // in micro seconds
   bool bCPUThread = true;
   bool bDSPThread = false;
   bool bDSPHLE = true;
@@ -119,6 +121,7 @@ struct SConfig
   bool bLowDCBZHack = false;
   int iBBDumpPort = 0;
   bool bFastDiscSpeed = false;
+  bool bDVDPrefetch = false;
   int iVideoRate = 8;
   bool bHalfAudioRate = false;
 
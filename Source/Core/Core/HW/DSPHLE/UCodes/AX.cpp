@@ -4,13 +4,19 @@
 
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -421,21 +427,38 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
   }
 }
 
+bool AXUCode::UseVoiceWorkers()
+{
+  if (!Config::Get(Config::MAIN_DSP_PARALLEL_AX))
+  {
+    m_voice_workers.reset();
+    return false;
+  }
+
+  if (!m_voice_workers)
+  {
+    // The calling thread takes part as well. Leave a core for the GPU thread, and don't go wide:
+    // a voice is only a few microseconds of work.
+    const size_t cores = std::thread::hardware_concurrency();
+    const size_t num_threads = std::min<size_t>(cores > 2 ? cores - 2 : 0, 3);
+    m_voice_workers = std::make_unique<ParallelVoiceMixer>(num_threads, "AX Voice Worker");
+  }
+  return m_voice_workers->GetWorkerCount() > 1;
+}
+
 void AXUCode::ProcessPBList(u32 pb_addr)
 {
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   const u32 spms = 32;
 
-  AXPB pb;
+  int* const buses[] = {m_samples_left,       m_samples_right,       m_samples_surround,
+                        m_samples_auxA_left,  m_samples_auxA_right,  m_samples_auxA_surround,
+                        m_samples_auxB_left,  m_samples_auxB_right,  m_samples_auxB_surround};
 
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
-                          m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
-                          m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const auto process_pb = [this, spms](AXPB& pb, int* const* pb_buses) {
+    AXBuffers buffers;
+    std::copy_n(pb_buses, ArraySize(buffers.ptrs), buffers.ptrs);
 
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
@@ -451,10 +474,48 @@ void AXUCode::ProcessPBList(u32 pb_addr)
       for (size_t i = 0; i < ArraySize(buffers.ptrs); ++i)
         buffers.ptrs[i] += spms;
     }
+  };
+
+  if (!UseVoiceWorkers())
+  {
+    AXPB pb;
+
+    while (pb_addr)
+    {
+      ReadPB(pb_addr, pb, m_crc);
+      process_pb(pb, buses);
+      WritePB(pb_addr, pb, m_crc);
+      pb_addr = HILO_TO_32(pb.next_pb);
+    }
+    return;
+  }
+
+  // PBs are read and written back on this thread, in list order. Updates can change next_pb, so
+  // they are applied to a copy to find the next PB the same way the loop above does.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPB> pbs;
+  while (pb_addr)
+  {
+    AXPB pb;
+    ReadPB(pb_addr, pb, m_crc);
+    pb_addrs.push_back(pb_addr);
+    pbs.push_back(pb);
 
-    WritePB(pb_addr, pb, m_crc);
+    u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, (u16*)&pb, pb.updates.num_updates, updates);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
+
+  u32 bus_sizes[ArraySize(buses)];
+  std::fill_n(bus_sizes, ArraySize(bus_sizes), spms * 5);
+  m_voice_workers->Mix(pbs.size(), buses, bus_sizes, ArraySize(buses),
+                       [&](size_t voice, int* const* voice_buses) {
+                         process_pb(pbs[voice], voice_buses);
+                       });
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(pb_addrs[i], pbs[i], m_crc);
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
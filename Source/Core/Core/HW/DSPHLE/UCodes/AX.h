@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
@@ -20,6 +22,7 @@ namespace DSP
 namespace HLE
 {
 class DSPHLE;
+class ParallelVoiceMixer;
 
 // We can't directly use the mixer_control field from the PB because it does
 // not mean the same in all AX versions. The AX UCode converts the
@@ -112,6 +115,10 @@ protected:
   // Apply updates to a PB. Generic, used in AX GC and AX Wii.
   void ApplyUpdatesForMs(int curr_ms, u16* pb, u16* num_updates, u16* updates);
 
+  // Voices can be processed on worker threads (Config::MAIN_DSP_PARALLEL_AX). Returns false if
+  // the PB list should be processed serially instead.
+  bool UseVoiceWorkers();
+
   virtual void HandleCommandList();
   void SignalWorkEnd();
 
@@ -130,6 +137,9 @@ protected:
   // Handle save states for main AX.
   void DoAXState(PointerWrap& p);
 
+  // Set up by UseVoiceWorkers.
+  std::unique_ptr<ParallelVoiceMixer> m_voice_workers;
+
 private:
   enum CmdType
   {
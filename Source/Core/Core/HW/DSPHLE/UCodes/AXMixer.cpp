@@ -0,0 +1,316 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
+
+#include "Common/Assert.h"
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#include "Common/MathUtil.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace DSP
+{
+namespace HLE
+{
+void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
+{
+  u16& volume = pvol[0];
+  u16 volume_delta = pvol[1];
+
+  // If volume ramping is disabled, set volume_delta to 0. That way, the
+  // mixing loop can avoid testing if volume ramping is enabled at each step,
+  // and just add volume_delta.
+  if (!ramp)
+    volume_delta = 0;
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = MathUtil::Clamp((s32)sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+void MixAddMultiGeneric(const s16* input, u32 count, const AXMixTarget* targets,
+                        size_t num_targets)
+{
+  for (size_t t = 0; t < num_targets; ++t)
+    MixAdd(targets[t].out, input, count, targets[t].volume, targets[t].dpop, targets[t].ramp);
+}
+
+// The SIMD versions below rely on a s16 sample times a u16 volume always fitting in a s32, so
+// the product can be computed with a 32-bit multiply without changing the result.
+
+#ifdef _M_X86
+
+FUNCTION_TARGET_SSR41
+static u32 MixAddMultiSSE41(const s16* input, u32 count, const AXMixTarget* targets,
+                            size_t num_targets)
+{
+  const u32 vector_count = count & ~3u;
+  if (vector_count == 0)
+    return 0;
+
+  __m128i volumes[MAX_MIX_TARGETS];
+  __m128i steps[MAX_MIX_TARGETS];
+  for (size_t t = 0; t < num_targets; ++t)
+  {
+    const int volume = targets[t].volume[0];
+    const int delta = targets[t].ramp ? targets[t].volume[1] : 0;
+    volumes[t] = _mm_and_si128(_mm_setr_epi32(volume, volume + delta, volume + 2 * delta,
+                                              volume + 3 * delta),
+                               _mm_set1_epi32(0xFFFF));
+    steps[t] = _mm_set1_epi32(4 * delta);
+  }
+
+  const __m128i min_sample = _mm_set1_epi32(-32767);
+  const __m128i max_sample = _mm_set1_epi32(32767);
+  const __m128i volume_mask = _mm_set1_epi32(0xFFFF);
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const __m128i samples =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+    for (size_t t = 0; t < num_targets; ++t)
+    {
+      __m128i mixed = _mm_srai_epi32(_mm_mullo_epi32(samples, volumes[t]), 15);
+      mixed = _mm_min_epi32(_mm_max_epi32(mixed, min_sample), max_sample);
+
+      __m128i* out = reinterpret_cast<__m128i*>(targets[t].out + i);
+      _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), mixed));
+      volumes[t] = _mm_and_si128(_mm_add_epi32(volumes[t], steps[t]), volume_mask);
+
+      if (i + 4 == vector_count)
+        *targets[t].dpop = static_cast<s16>(_mm_extract_epi32(mixed, 3));
+    }
+  }
+
+  for (size_t t = 0; t < num_targets; ++t)
+    targets[t].volume[0] = static_cast<u16>(_mm_cvtsi128_si32(volumes[t]));
+  return vector_count;
+}
+
+FUNCTION_TARGET_AVX2
+static u32 MixAddMultiAVX2(const s16* input, u32 count, const AXMixTarget* targets,
+                           size_t num_targets)
+{
+  const u32 vector_count = count & ~7u;
+  if (vector_count == 0)
+    return 0;
+
+  __m256i volumes[MAX_MIX_TARGETS];
+  __m256i steps[MAX_MIX_TARGETS];
+  for (size_t t = 0; t < num_targets; ++t)
+  {
+    const int volume = targets[t].volume[0];
+    const int delta = targets[t].ramp ? targets[t].volume[1] : 0;
+    volumes[t] = _mm256_and_si256(
+        _mm256_add_epi32(_mm256_set1_epi32(volume),
+                         _mm256_mullo_epi32(_mm256_set1_epi32(delta),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))),
+        _mm256_set1_epi32(0xFFFF));
+    steps[t] = _mm256_set1_epi32(8 * delta);
+  }
+
+  const __m256i min_sample = _mm256_set1_epi32(-32767);
+  const __m256i max_sample = _mm256_set1_epi32(32767);
+  const __m256i volume_mask = _mm256_set1_epi32(0xFFFF);
+  for (u32 i = 0; i < vector_count; i += 8)
+  {
+    const __m256i samples =
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+    for (size_t t = 0; t < num_targets; ++t)
+    {
+      __m256i mixed = _mm256_srai_epi32(_mm256_mullo_epi32(samples, volumes[t]), 15);
+      mixed = _mm256_min_epi32(_mm256_max_epi32(mixed, min_sample), max_sample);
+
+      __m256i* out = reinterpret_cast<__m256i*>(targets[t].out + i);
+      _mm256_storeu_si256(out, _mm256_add_epi32(_mm256_loadu_si256(out), mixed));
+      volumes[t] = _mm256_and_si256(_mm256_add_epi32(volumes[t], steps[t]), volume_mask);
+
+      if (i + 8 == vector_count)
+        *targets[t].dpop = static_cast<s16>(_mm256_extract_epi32(mixed, 7));
+    }
+  }
+
+  for (size_t t = 0; t < num_targets; ++t)
+    targets[t].volume[0] = static_cast<u16>(_mm256_cvtsi256_si32(volumes[t]));
+  return vector_count;
+}
+
+#elif defined(_M_ARM_64)
+
+static u32 MixAddMultiNEON(const s16* input, u32 count, const AXMixTarget* targets,
+                           size_t num_targets)
+{
+  const u32 vector_count = count & ~3u;
+  if (vector_count == 0)
+    return 0;
+
+  static const s32 lanes[4] = {0, 1, 2, 3};
+  int32x4_t volumes[MAX_MIX_TARGETS];
+  int32x4_t steps[MAX_MIX_TARGETS];
+  for (size_t t = 0; t < num_targets; ++t)
+  {
+    const s32 volume = targets[t].volume[0];
+    const s32 delta = targets[t].ramp ? targets[t].volume[1] : 0;
+    volumes[t] = vandq_s32(vmlaq_n_s32(vdupq_n_s32(volume), vld1q_s32(lanes), delta),
+                           vdupq_n_s32(0xFFFF));
+    steps[t] = vdupq_n_s32(4 * delta);
+  }
+
+  const int32x4_t min_sample = vdupq_n_s32(-32767);
+  const int32x4_t max_sample = vdupq_n_s32(32767);
+  const int32x4_t volume_mask = vdupq_n_s32(0xFFFF);
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t samples = vmovl_s16(vld1_s16(input + i));
+    for (size_t t = 0; t < num_targets; ++t)
+    {
+      int32x4_t mixed = vshrq_n_s32(vmulq_s32(samples, volumes[t]), 15);
+      mixed = vminq_s32(vmaxq_s32(mixed, min_sample), max_sample);
+
+      vst1q_s32(targets[t].out + i, vaddq_s32(vld1q_s32(targets[t].out + i), mixed));
+      volumes[t] = vandq_s32(vaddq_s32(volumes[t], steps[t]), volume_mask);
+
+      if (i + 4 == vector_count)
+        *targets[t].dpop = static_cast<s16>(vgetq_lane_s32(mixed, 3));
+    }
+  }
+
+  for (size_t t = 0; t < num_targets; ++t)
+    targets[t].volume[0] = static_cast<u16>(vgetq_lane_s32(volumes[t], 0));
+  return vector_count;
+}
+
+#endif
+
+bool IsMixAddPathSupported(MixAddPath path)
+{
+  switch (path)
+  {
+  case MixAddPath::Generic:
+    return true;
+#ifdef _M_X86
+  case MixAddPath::SSE41:
+    return cpu_info.bSSE4_1;
+  case MixAddPath::AVX2:
+    return cpu_info.bAVX2;
+#elif defined(_M_ARM_64)
+  case MixAddPath::NEON:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+void MixAddMulti(const s16* input, u32 count, const AXMixTarget* targets, size_t num_targets)
+{
+  MixAddPath path = MixAddPath::Generic;
+#ifdef _M_X86
+  if (cpu_info.bAVX2)
+    path = MixAddPath::AVX2;
+  else if (cpu_info.bSSE4_1)
+    path = MixAddPath::SSE41;
+#elif defined(_M_ARM_64)
+  path = MixAddPath::NEON;
+#endif
+  MixAddMultiWithPath(path, input, count, targets, num_targets);
+}
+
+void MixAddMultiWithPath(MixAddPath path, const s16* input, u32 count,
+                         const AXMixTarget* targets, size_t num_targets)
+{
+  if (num_targets == 0)
+    return;
+  if (num_targets > MAX_MIX_TARGETS)
+  {
+    MixAddMultiGeneric(input, count, targets, num_targets);
+    return;
+  }
+
+  u32 done = 0;
+  switch (path)
+  {
+#ifdef _M_X86
+  case MixAddPath::AVX2:
+    done = MixAddMultiAVX2(input, count, targets, num_targets);
+    break;
+  case MixAddPath::SSE41:
+    done = MixAddMultiSSE41(input, count, targets, num_targets);
+    break;
+#elif defined(_M_ARM_64)
+  case MixAddPath::NEON:
+    done = MixAddMultiNEON(input, count, targets, num_targets);
+    break;
+#endif
+  default:
+    break;
+  }
+
+  // Mix whatever doesn't fill a whole vector; this also updates the volume and dpop values.
+  if (done < count)
+  {
+    for (size_t t = 0; t < num_targets; ++t)
+    {
+      MixAdd(targets[t].out + done, input + done, count - done, targets[t].volume, targets[t].dpop,
+             targets[t].ramp);
+    }
+  }
+}
+ParallelVoiceMixer::ParallelVoiceMixer(size_t num_threads, const std::string& name)
+    : m_pool(num_threads, name)
+{
+}
+
+void ParallelVoiceMixer::Mix(size_t num_voices, int* const* buses, const u32* bus_sizes,
+                             size_t num_buses, const MixVoiceFunction& mix_voice)
+{
+  ASSERT(num_buses <= MAX_BUSES);
+
+  // Old AX Wii versions advance the Wii remote buses by a full millisecond of main bus samples,
+  // which runs past their end into the next bus. The buses are laid out in the same order here,
+  // plus some slack so that running past the last one stays inside the worker's own samples.
+  constexpr size_t BUS_SLACK = 64;
+  size_t worker_samples = BUS_SLACK;
+  for (size_t i = 0; i < num_buses; ++i)
+    worker_samples += bus_sizes[i];
+
+  const size_t num_workers = m_pool.GetWorkerCount();
+  m_worker_buses.assign(worker_samples * num_workers, 0);
+
+  m_pool.Run(num_voices, [&](size_t voice, size_t worker) {
+    int* worker_buses[MAX_BUSES];
+    int* samples = &m_worker_buses[worker * worker_samples];
+    for (size_t i = 0; i < num_buses; ++i)
+    {
+      worker_buses[i] = samples;
+      samples += bus_sizes[i];
+    }
+    mix_voice(voice, worker_buses);
+  });
+
+  for (size_t worker = 0; worker < num_workers; ++worker)
+  {
+    const int* samples = &m_worker_buses[worker * worker_samples];
+    for (size_t i = 0; i < num_buses; ++i)
+    {
+      for (u32 j = 0; j < bus_sizes[i]; ++j)
+        buses[i][j] += samples[j];
+      samples += bus_sizes[i];
+    }
+  }
+}
+}  // namespace HLE
+}  // namespace DSP
@@ -0,0 +1,85 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Volume-ramped mixing of AX voices into the output buses.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/ForkJoinPool.h"
+
+namespace DSP
+{
+namespace HLE
+{
+// AX mixes at most 12 buses per voice (3 main, 3 for each of 3 aux buses on the Wii).
+constexpr size_t MAX_MIX_TARGETS = 12;
+
+struct AXMixTarget
+{
+  int* out;
+  // Current volume and volume delta, the volume is updated after mixing.
+  u16* volume;
+  s16* dpop;
+  bool ramp;
+};
+
+// Add samples to an output buffer, with optional volume ramping.
+void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp);
+
+// Same as calling MixAdd for each target, but the input is only read once. Uses SIMD when
+// available; the results are identical to MixAdd.
+void MixAddMulti(const s16* input, u32 count, const AXMixTarget* targets, size_t num_targets);
+
+// The plain C++ version of MixAddMulti, exposed for tests.
+void MixAddMultiGeneric(const s16* input, u32 count, const AXMixTarget* targets,
+                        size_t num_targets);
+
+// The implementations MixAddMulti picks from. Tests force each one the host can run, as
+// MixAddMulti only ever uses the best one.
+enum class MixAddPath
+{
+  Generic,
+  SSE41,
+  AVX2,
+  NEON,
+};
+
+bool IsMixAddPathSupported(MixAddPath path);
+
+// MixAddMulti with the given implementation, which has to be supported.
+void MixAddMultiWithPath(MixAddPath path, const s16* input, u32 count,
+                         const AXMixTarget* targets, size_t num_targets);
+
+// Mixes the voices of a PB list on several threads. Each worker mixes into its own zeroed copy of
+// the buses, which are added to the real buses afterwards. Mixing only ever adds integers, so the
+// result is exactly the same as mixing the voices one after the other.
+class ParallelVoiceMixer
+{
+public:
+  // AX Wii has the most buses: main, aux A/B/C and 8 for the Wii remotes.
+  static constexpr size_t MAX_BUSES = 20;
+
+  using MixVoiceFunction = std::function<void(size_t voice, int* const* buses)>;
+
+  ParallelVoiceMixer(size_t num_threads, const std::string& name);
+
+  size_t GetWorkerCount() const { return m_pool.GetWorkerCount(); }
+
+  // Runs mix_voice for every voice, with buses that have the given sizes.
+  void Mix(size_t num_voices, int* const* buses, const u32* bus_sizes, size_t num_buses,
+           const MixVoiceFunction& mix_voice);
+
+private:
+  Common::ForkJoinPool m_pool;
+  // One set of buses per worker.
+  std::vector<int> m_worker_buses;
+};
+}  // namespace HLE
+}  // namespace DSP
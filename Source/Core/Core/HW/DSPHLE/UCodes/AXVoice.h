@@ -20,6 +20,7 @@
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
@@ -163,9 +164,10 @@ void DumpPB(const PB_TYPE& pb)
 }
 #endif
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
-static bool acc_end_reached;
+// Simulated accelerator state. Voices may be processed on several threads at once (see
+// AXUCode::MixVoicesInParallel), so every thread gets its own accelerator.
+static thread_local PB_TYPE* acc_pb;
+static thread_local bool acc_end_reached;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -212,7 +214,8 @@ protected:
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local std::unique_ptr<Accelerator> s_accelerator =
+    std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -396,32 +399,6 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
-// Add samples to an output buffer, with optional volume ramping.
-void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
-{
-  u16& volume = pvol[0];
-  u16 volume_delta = pvol[1];
-
-  // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = MathUtil::Clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
-}
-
 // Execute a low pass filter on the samples using one history value. Returns
 // the new history value.
 s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
@@ -465,46 +442,35 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
 #define MIX_ON(C) (0 != (mctrl & MIX_##C))
 #define RAMP_ON(C) (0 != (mctrl & MIX_##C##_RAMP))
+#define MIX_TARGET(C, name)                                                                        \
+  if (MIX_ON(C))                                                                                   \
+    targets[num_targets++] = {buffers.name, &pb.mixer.name, &pb.dpop.name, RAMP_ON(C)}
+
+  // All buses are mixed in one pass over the samples.
+  AXMixTarget targets[MAX_MIX_TARGETS];
+  size_t num_targets = 0;
 
-  if (MIX_ON(L))
-    MixAdd(buffers.left, samples, count, &pb.mixer.left, &pb.dpop.left, RAMP_ON(L));
-  if (MIX_ON(R))
-    MixAdd(buffers.right, samples, count, &pb.mixer.right, &pb.dpop.right, RAMP_ON(R));
-  if (MIX_ON(S))
-    MixAdd(buffers.surround, samples, count, &pb.mixer.surround, &pb.dpop.surround, RAMP_ON(S));
-
-  if (MIX_ON(AUXA_L))
-    MixAdd(buffers.auxA_left, samples, count, &pb.mixer.auxA_left, &pb.dpop.auxA_left,
-           RAMP_ON(AUXA_L));
-  if (MIX_ON(AUXA_R))
-    MixAdd(buffers.auxA_right, samples, count, &pb.mixer.auxA_right, &pb.dpop.auxA_right,
-           RAMP_ON(AUXA_R));
-  if (MIX_ON(AUXA_S))
-    MixAdd(buffers.auxA_surround, samples, count, &pb.mixer.auxA_surround, &pb.dpop.auxA_surround,
-           RAMP_ON(AUXA_S));
-
-  if (MIX_ON(AUXB_L))
-    MixAdd(buffers.auxB_left, samples, count, &pb.mixer.auxB_left, &pb.dpop.auxB_left,
-           RAMP_ON(AUXB_L));
-  if (MIX_ON(AUXB_R))
-    MixAdd(buffers.auxB_right, samples, count, &pb.mixer.auxB_right, &pb.dpop.auxB_right,
-           RAMP_ON(AUXB_R));
-  if (MIX_ON(AUXB_S))
-    MixAdd(buffers.auxB_surround, samples, count, &pb.mixer.auxB_surround, &pb.dpop.auxB_surround,
-           RAMP_ON(AUXB_S));
+  MIX_TARGET(L, left);
+  MIX_TARGET(R, right);
+  MIX_TARGET(S, surround);
+
+  MIX_TARGET(AUXA_L, auxA_left);
+  MIX_TARGET(AUXA_R, auxA_right);
+  MIX_TARGET(AUXA_S, auxA_surround);
+
+  MIX_TARGET(AUXB_L, auxB_left);
+  MIX_TARGET(AUXB_R, auxB_right);
+  MIX_TARGET(AUXB_S, auxB_surround);
 
 #ifdef AX_WII
-  if (MIX_ON(AUXC_L))
-    MixAdd(buffers.auxC_left, samples, count, &pb.mixer.auxC_left, &pb.dpop.auxC_left,
-           RAMP_ON(AUXC_L));
-  if (MIX_ON(AUXC_R))
-    MixAdd(buffers.auxC_right, samples, count, &pb.mixer.auxC_right, &pb.dpop.auxC_right,
-           RAMP_ON(AUXC_R));
-  if (MIX_ON(AUXC_S))
-    MixAdd(buffers.auxC_surround, samples, count, &pb.mixer.auxC_surround, &pb.dpop.auxC_surround,
-           RAMP_ON(AUXC_S));
+  MIX_TARGET(AUXC_L, auxC_left);
+  MIX_TARGET(AUXC_R, auxC_right);
+  MIX_TARGET(AUXC_S, auxC_surround);
 #endif
 
+  MixAddMulti(samples, count, targets, num_targets);
+
+#undef MIX_TARGET
 #undef MIX_ON
 #undef RAMP_ON
 
@@ -535,30 +501,23 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #define WMCHAN_MIX_ON(n) (0 != ((pb.remote_mixer_control >> (2 * n)) & 3))
 #define WMCHAN_MIX_RAMP(n) (0 != ((pb.remote_mixer_control >> (2 * n)) & 2))
 
-    if (WMCHAN_MIX_ON(0))
-      MixAdd(buffers.wm_main0, wm_samples, wm_count, &pb.remote_mixer.main0, &pb.remote_dpop.main0,
-             WMCHAN_MIX_RAMP(0));
-    if (WMCHAN_MIX_ON(1))
-      MixAdd(buffers.wm_aux0, wm_samples, wm_count, &pb.remote_mixer.aux0, &pb.remote_dpop.aux0,
-             WMCHAN_MIX_RAMP(1));
-    if (WMCHAN_MIX_ON(2))
-      MixAdd(buffers.wm_main1, wm_samples, wm_count, &pb.remote_mixer.main1, &pb.remote_dpop.main1,
-             WMCHAN_MIX_RAMP(2));
-    if (WMCHAN_MIX_ON(3))
-      MixAdd(buffers.wm_aux1, wm_samples, wm_count, &pb.remote_mixer.aux1, &pb.remote_dpop.aux1,
-             WMCHAN_MIX_RAMP(3));
-    if (WMCHAN_MIX_ON(4))
-      MixAdd(buffers.wm_main2, wm_samples, wm_count, &pb.remote_mixer.main2, &pb.remote_dpop.main2,
-             WMCHAN_MIX_RAMP(4));
-    if (WMCHAN_MIX_ON(5))
-      MixAdd(buffers.wm_aux2, wm_samples, wm_count, &pb.remote_mixer.aux2, &pb.remote_dpop.aux2,
-             WMCHAN_MIX_RAMP(5));
-    if (WMCHAN_MIX_ON(6))
-      MixAdd(buffers.wm_main3, wm_samples, wm_count, &pb.remote_mixer.main3, &pb.remote_dpop.main3,
-             WMCHAN_MIX_RAMP(6));
-    if (WMCHAN_MIX_ON(7))
-      MixAdd(buffers.wm_aux3, wm_samples, wm_count, &pb.remote_mixer.aux3, &pb.remote_dpop.aux3,
-             WMCHAN_MIX_RAMP(7));
+#define WMCHAN_MIX_TARGET(n, buffer, name)                                                         \
+  if (WMCHAN_MIX_ON(n))                                                                            \
+    wm_targets[num_wm_targets++] = {buffers.buffer, &pb.remote_mixer.name, &pb.remote_dpop.name,   \
+                                    WMCHAN_MIX_RAMP(n)}
+
+    AXMixTarget wm_targets[8];
+    size_t num_wm_targets = 0;
+    WMCHAN_MIX_TARGET(0, wm_main0, main0);
+    WMCHAN_MIX_TARGET(1, wm_aux0, aux0);
+    WMCHAN_MIX_TARGET(2, wm_main1, main1);
+    WMCHAN_MIX_TARGET(3, wm_aux1, aux1);
+    WMCHAN_MIX_TARGET(4, wm_main2, main2);
+    WMCHAN_MIX_TARGET(5, wm_aux2, aux2);
+    WMCHAN_MIX_TARGET(6, wm_main3, main3);
+    WMCHAN_MIX_TARGET(7, wm_aux3, aux3);
+    MixAddMulti(wm_samples, wm_count, wm_targets, num_wm_targets);
+#undef WMCHAN_MIX_TARGET
   }
 #undef WMCHAN_MIX_RAMP
 #undef WMCHAN_MIX_ON
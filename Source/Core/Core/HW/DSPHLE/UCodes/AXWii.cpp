@@ -6,6 +6,9 @@
 
 #include "Core/HW/DSPHLE/UCodes/AXWii.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -439,19 +442,17 @@ void AXWiiUCode::ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 update
 
 void AXWiiUCode::ProcessPBList(u32 pb_addr)
 {
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  int* const buses[] = {m_samples_left,      m_samples_right,      m_samples_surround,
+                        m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                        m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                        m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                        m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                        m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                        m_samples_wm3,       m_samples_aux3};
+
+  const auto process_pb = [this](AXPBWii& pb, int* const* pb_buses) {
+    AXBuffers buffers;
+    std::copy_n(pb_buses, ArraySize(buffers.ptrs), buffers.ptrs);
 
     u16 num_updates[3];
     u16 updates[1024];
@@ -475,10 +476,56 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_available ? m_coeffs : nullptr);
     }
+  };
+
+  if (!UseVoiceWorkers())
+  {
+    AXPBWii pb;
+
+    while (pb_addr)
+    {
+      ReadPB(pb_addr, pb, m_crc);
+      process_pb(pb, buses);
+      WritePB(pb_addr, pb, m_crc);
+      pb_addr = HILO_TO_32(pb.next_pb);
+    }
+    return;
+  }
+
+  // See AXUCode::ProcessPBList: updates are applied to a copy of each PB to find the next one.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPBWii> pbs;
+  while (pb_addr)
+  {
+    AXPBWii pb;
+    ReadPB(pb_addr, pb, m_crc);
+    pb_addrs.push_back(pb_addr);
+    pbs.push_back(pb);
 
-    WritePB(pb_addr, pb, m_crc);
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+    if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, (u16*)&pb, num_updates, updates);
+      ReinjectUpdatesFields(pb, num_updates, updates_addr);
+    }
     pb_addr = HILO_TO_32(pb.next_pb);
   }
+
+  // 3ms at 32 samples per millisecond for the main and aux buses, 6 per millisecond for the
+  // Wii remotes.
+  u32 bus_sizes[ArraySize(buses)];
+  std::fill_n(bus_sizes, 12, 32 * 3);
+  std::fill_n(bus_sizes + 12, ArraySize(bus_sizes) - 12, 6 * 3);
+  m_voice_workers->Mix(pbs.size(), buses, bus_sizes, ArraySize(buses),
+                       [&](size_t voice, int* const* voice_buses) {
+                         process_pb(pbs[voice], voice_buses);
+                       });
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(pb_addrs[i], pbs[i], m_crc);
 }
 
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
@@ -0,0 +1,193 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/DVD/DVDPrefetch.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+#include "Core/ConfigManager.h"
+
+#include "DiscIO/Volume.h"
+
+namespace DVDPrefetch
+{
+struct ReadEntry
+{
+  u64 partition;
+  u64 offset;
+  u32 length;
+  u32 padding;
+};
+static_assert(sizeof(ReadEntry) == 24, "ReadEntry is stored in profiles as-is");
+
+static constexpr u32 PROFILE_MAGIC = 0x46505644;  // "DVPF"
+static constexpr u32 PROFILE_VERSION = 1;
+static constexpr size_t MAX_RECORDED_READS = 1 << 16;
+// How far ahead of the game we are allowed to get, in reads and in bytes.
+static constexpr size_t LOOKAHEAD_READS = 16;
+static constexpr u64 LOOKAHEAD_BYTES = 8 * 1024 * 1024;
+// Reads are matched at ECC block granularity, since that is what the game's reads get split into.
+static constexpr u64 BLOCK_SIZE = 0x8000;
+
+static std::string s_game_id;
+static std::vector<ReadEntry> s_profile;
+// Maps a block to every position in s_profile that starts in it.
+static std::unordered_map<u64, std::vector<u32>> s_profile_index;
+static std::vector<ReadEntry> s_recording;
+
+static std::deque<ReadEntry> s_pending;
+// Position in s_profile after the last read that matched it.
+static size_t s_position = 0;
+// Position in s_profile up to which predictions have already been queued.
+static size_t s_queued_end = 0;
+
+static u64 GetKey(u64 partition, u64 offset)
+{
+  // Partition offsets are far apart and blocks are small, so mixing them is good enough for a key.
+  return (partition * 0x9E3779B97F4A7C15ULL) ^ (offset / BLOCK_SIZE);
+}
+
+static std::string GetProfilePath(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "DVDPrefetch" DIR_SEP + game_id + ".bin";
+}
+
+static void LoadProfile()
+{
+  s_profile.clear();
+  s_profile_index.clear();
+
+  File::IOFile file(GetProfilePath(s_game_id), "rb");
+  if (!file)
+    return;
+
+  u32 magic = 0;
+  u32 version = 0;
+  u32 count = 0;
+  if (!file.ReadArray(&magic, 1) || !file.ReadArray(&version, 1) || !file.ReadArray(&count, 1) ||
+      magic != PROFILE_MAGIC || version != PROFILE_VERSION || count > MAX_RECORDED_READS)
+  {
+    return;
+  }
+
+  s_profile.resize(count);
+  if (!file.ReadArray(s_profile.data(), count))
+  {
+    s_profile.clear();
+    return;
+  }
+
+  for (u32 i = 0; i < count; ++i)
+    s_profile_index[GetKey(s_profile[i].partition, s_profile[i].offset)].push_back(i);
+
+  INFO_LOG(DVDINTERFACE, "Loaded DVD prefetch profile for %s (%u reads)", s_game_id.c_str(),
+           count);
+}
+
+static void SaveProfile()
+{
+  if (s_game_id.empty() || s_recording.empty())
+    return;
+
+  // This session's reads come first, followed by the reads of earlier sessions that didn't come up
+  // this time. That way a short session doesn't throw away what longer ones saw, and once the
+  // profile is full, the parts of the game that haven't been played for the longest are dropped.
+  std::unordered_set<u64> recorded_keys;
+  for (const ReadEntry& entry : s_recording)
+    recorded_keys.insert(GetKey(entry.partition, entry.offset));
+  for (const ReadEntry& entry : s_profile)
+  {
+    if (s_recording.size() >= MAX_RECORDED_READS)
+      break;
+    if (!recorded_keys.count(GetKey(entry.partition, entry.offset)))
+      s_recording.push_back(entry);
+  }
+
+  const std::string path = GetProfilePath(s_game_id);
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  if (!file)
+    return;
+
+  const u32 header[] = {PROFILE_MAGIC, PROFILE_VERSION, static_cast<u32>(s_recording.size())};
+  file.WriteArray(header, 3);
+  file.WriteArray(s_recording.data(), s_recording.size());
+}
+
+void SetVolume(const DiscIO::Volume* volume)
+{
+  SaveProfile();
+
+  s_recording.clear();
+  s_pending.clear();
+  s_position = 0;
+  s_queued_end = 0;
+  s_game_id = volume ? volume->GetGameID() : "";
+  if (!s_game_id.empty())
+    LoadProfile();
+}
+
+void RecordRead(const DiscIO::Partition& partition, u64 offset, u32 length)
+{
+  if (!SConfig::GetInstance().bDVDPrefetch || s_game_id.empty())
+    return;
+
+  if (s_recording.size() < MAX_RECORDED_READS)
+    s_recording.push_back({partition.offset, offset, length, 0});
+
+  const auto it = s_profile_index.find(GetKey(partition.offset, offset));
+  if (it == s_profile_index.end())
+    return;
+
+  // Prefer the first occurrence at or after the previous match, so that loops in the profile
+  // (e.g. revisiting a room) don't make us jump back to the start every time.
+  const std::vector<u32>& positions = it->second;
+  const auto next = std::lower_bound(positions.begin(), positions.end(), s_position);
+  const size_t position = next != positions.end() ? *next : positions.front();
+  s_position = position + 1;
+
+  // Skip whatever an earlier prediction already queued.
+  size_t start = position + 1;
+  if (s_queued_end > start && s_queued_end - start <= LOOKAHEAD_READS)
+    start = s_queued_end;
+  const size_t end = std::min(position + 1 + LOOKAHEAD_READS, s_profile.size());
+
+  u64 queued_bytes = 0;
+  for (const ReadEntry& entry : s_pending)
+    queued_bytes += entry.length;
+
+  size_t i = start;
+  for (; i < end && queued_bytes < LOOKAHEAD_BYTES; ++i)
+  {
+    s_pending.push_back(s_profile[i]);
+    queued_bytes += s_profile[i].length;
+  }
+  s_queued_end = std::max(start, i);
+}
+
+bool PopPrefetch(DiscIO::Partition* partition, u64* offset, u32* length)
+{
+  if (s_pending.empty())
+    return false;
+
+  const ReadEntry& entry = s_pending.front();
+  *partition = DiscIO::Partition(entry.partition);
+  *offset = entry.offset;
+  *length = entry.length;
+  s_pending.pop_front();
+  return true;
+}
+
+}  // namespace DVDPrefetch
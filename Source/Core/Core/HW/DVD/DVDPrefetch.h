@@ -0,0 +1,31 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+struct Partition;
+class Volume;
+}
+
+// Speculative host-side prefetching of disc reads. The sequence of reads a game makes is recorded
+// into a per-game profile, and on later runs the reads that followed the current one last time
+// are performed ahead of time so that the host's caches are warm when the game gets to them.
+// This only affects host I/O; emulated disc timing is still entirely up to DVDMath.
+//
+// Everything here runs on the DVD thread, or on the CPU thread while the DVD thread is idle.
+namespace DVDPrefetch
+{
+// Saves the profile of the previous volume (if any) and loads the one for the new volume.
+void SetVolume(const DiscIO::Volume* volume);
+
+void RecordRead(const DiscIO::Partition& partition, u64 offset, u32 length);
+
+// Returns the next predicted read, if there is one that hasn't been performed yet.
+bool PopPrefetch(DiscIO::Partition* partition, u64* offset, u32* length);
+
+}  // namespace DVDPrefetch
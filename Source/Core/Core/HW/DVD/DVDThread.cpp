@@ -4,8 +4,8 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <cinttypes>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -27,6 +27,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetch.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -74,6 +75,7 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
 
 static void FinishRead(u64 id, s64 cycles_late);
+static void RecycleBuffer(std::vector<u8> buffer);
 static CoreTiming::EventType* s_finish_read;
 
 static u64 s_next_id = 0;
@@ -85,7 +87,17 @@ static Common::Flag s_dvd_thread_exiting(false);  // Is set by CPU thread
 
 static Common::SPSCQueue<ReadRequest, false> s_request_queue;
 static Common::SPSCQueue<ReadResult, false> s_result_queue;
-static std::map<u64, ReadResult> s_result_map;
+// Results that FinishRead had to pop while looking for another one. Requests are serviced in
+// order and mostly finish in order, so this rarely holds more than a couple of entries.
+// It has the same savestate layout as the std::map<u64, ReadResult> that was used before.
+static std::vector<std::pair<u64, ReadResult>> s_result_map;
+
+// Read buffers handed back by the CPU thread once it is done with them, so that the DVD thread
+// doesn't have to allocate a new one for every request.
+static constexpr u32 MAX_POOLED_BUFFERS = 8;
+static Common::SPSCQueue<std::vector<u8>> s_buffer_pool;
+// Only used by the DVD thread
+static std::vector<u8> s_prefetch_buffer;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
@@ -97,6 +109,7 @@ void Start()
   s_result_queue_expanded.Reset();
   s_request_queue.Clear();
   s_result_queue.Clear();
+  s_buffer_pool.Clear();
 
   // This is reset on every launch for determinism, but it doesn't matter
   // much, because this will never get exposed to the emulated game.
@@ -115,6 +128,7 @@ static void StartDVDThread()
 void Stop()
 {
   StopDVDThread();
+  DVDPrefetch::SetVolume(nullptr);
   s_disc.reset();
 }
 
@@ -139,11 +153,11 @@ void DoState(PointerWrap& p)
   WaitUntilIdle();
 
   // Move all results from s_result_queue to s_result_map because
-  // PointerWrap::Do supports std::map but not Common::SPSCQueue.
+  // PointerWrap::Do supports std::vector but not Common::SPSCQueue.
   // This won't affect the behavior of FinishRead.
   ReadResult result;
   while (s_result_queue.Pop(result))
-    s_result_map.emplace(result.first.id, std::move(result));
+    s_result_map.emplace_back(result.first.id, std::move(result));
 
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
@@ -178,6 +192,7 @@ void DoState(PointerWrap& p)
 void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  DVDPrefetch::SetVolume(disc.get());
   s_disc = std::move(disc);
 }
 
@@ -287,7 +302,8 @@ static void FinishRead(u64 id, s64 cycles_late)
   // When this function is called again later, it will check the map for
   // the wanted ReadResult before it starts searching through the queue.
   ReadResult result;
-  auto it = s_result_map.find(id);
+  auto it = std::find_if(s_result_map.begin(), s_result_map.end(),
+                         [id](const auto& entry) { return entry.first == id; });
   if (it != s_result_map.end())
   {
     result = std::move(it->second);
@@ -303,7 +319,7 @@ static void FinishRead(u64 id, s64 cycles_late)
       if (result.first.id == id)
         break;
       else
-        s_result_map.emplace(result.first.id, std::move(result));
+        s_result_map.emplace_back(result.first.id, std::move(result));
     }
   }
   // We have now obtained the right ReadResult.
@@ -333,6 +349,39 @@ static void FinishRead(u64 id, s64 cycles_late)
   // Notify the emulated software that the command has been executed
   DVDInterface::FinishExecutingCommand(request.reply_type, DVDInterface::INT_TCINT, cycles_late,
     buffer);
+
+  RecycleBuffer(std::move(result.second));
+}
+
+static void RecycleBuffer(std::vector<u8> buffer)
+{
+  if (buffer.capacity() != 0 && s_buffer_pool.Size() < MAX_POOLED_BUFFERS)
+    s_buffer_pool.Push(std::move(buffer));
+}
+
+// Uses the time between requests to perform the reads the game is predicted to make next, so
+// that they hit the host's caches when they really happen. Bails out as soon as a real request
+// arrives, checking in small chunks so that a long prefetch doesn't hold it up.
+static void Prefetch()
+{
+  constexpr u32 CHUNK_SIZE = 0x40000;
+
+  DiscIO::Partition partition;
+  u64 offset;
+  u32 length;
+  while (s_disc && DVDPrefetch::PopPrefetch(&partition, &offset, &length))
+  {
+    for (u32 done = 0; done < length; done += CHUNK_SIZE)
+    {
+      if (!s_request_queue.Empty() || s_dvd_thread_exiting.IsSet())
+        return;
+
+      const u32 chunk_length = std::min(CHUNK_SIZE, length - done);
+      s_prefetch_buffer.resize(chunk_length);
+      if (!s_disc->Read(offset + done, chunk_length, s_prefetch_buffer.data(), partition))
+        break;
+    }
+  }
 }
 
 static void DVDThread()
@@ -350,8 +399,11 @@ static void DVDThread()
     while (s_request_queue.Pop(request))
     {
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
+      DVDPrefetch::RecordRead(request.partition, request.dvd_offset, request.length);
 
-      std::vector<u8> buffer(request.length);
+      std::vector<u8> buffer;
+      s_buffer_pool.Pop(buffer);
+      buffer.resize(request.length);
       if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
         buffer.resize(0);
 
@@ -363,6 +415,8 @@ static void DVDThread()
       if (s_dvd_thread_exiting.IsSet())
         return;
     }
+
+    Prefetch();
   }
 }
 }
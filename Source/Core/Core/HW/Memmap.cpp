@@ -12,8 +12,10 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "Common/ChunkFile.h"
+#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
@@ -164,6 +166,11 @@ static PhysicalMemoryRegion physical_regions[] = {
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+static bool s_incremental_state = false;
+// Dirty pages of each physical region, collected once per incremental state so that the measure
+// and write passes of a save record the same pages.
+static std::vector<std::vector<u32>> s_dirty_pages;
+
 void Init()
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -263,9 +270,69 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+static void CollectDirtyPages()
+{
+  s_dirty_pages.assign(ArraySize(physical_regions), {});
+  const size_t page_size = MemArena::GetPageSize();
+  std::vector<bool> dirty;
+  for (size_t i = 0; i < ArraySize(physical_regions); ++i)
+  {
+    const PhysicalMemoryRegion& region = physical_regions[i];
+    if (!*region.out_pointer)
+      continue;
+
+    // Leaving pages out would make restoring the state corrupt memory, so if the dirty pages
+    // can't be read, record the whole region.
+    if (!g_arena.GetDirtyPages(region.shm_position, region.size, &dirty))
+      dirty.assign(region.size / page_size, true);
+
+    for (u32 page = 0; page < dirty.size(); ++page)
+    {
+      if (dirty[page])
+        s_dirty_pages[i].push_back(page);
+    }
+  }
+}
+
+// Records only the pages of a region that were written since the last ResetDirtyPages().
+static void DoDirtyPages(PointerWrap& p, const PhysicalMemoryRegion& region, size_t index)
+{
+  u8* const data = *region.out_pointer;
+  u32 page_size = static_cast<u32>(MemArena::GetPageSize());
+  std::vector<u32> pages;
+  if (p.GetMode() != PointerWrap::MODE_READ)
+    pages = s_dirty_pages[index];
+
+  p.Do(page_size);
+  p.Do(pages);
+  for (u32 page : pages)
+  {
+    if (static_cast<u64>(page + 1) * page_size > region.size)
+    {
+      p.SetMode(PointerWrap::MODE_MEASURE);
+      return;
+    }
+    p.DoArray(data + page * page_size, page_size);
+  }
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
+
+  bool incremental = s_incremental_state;
+  p.Do(incremental);
+  if (incremental)
+  {
+    for (size_t i = 0; i < ArraySize(physical_regions); ++i)
+    {
+      if (*physical_regions[i].out_pointer)
+        DoDirtyPages(p, physical_regions[i], i);
+    }
+    p.DoMarker("Memory dirty pages");
+    return;
+  }
+
   p.DoArray(m_pRAM, RAM_SIZE);
   p.DoArray(m_pL1Cache, L1_CACHE_SIZE);
   p.DoMarker("Memory RAM");
@@ -277,6 +344,25 @@ void DoState(PointerWrap& p)
   p.DoMarker("Memory EXRAM");
 }
 
+bool IsDirtyTrackingSupported()
+{
+  return MemArena::IsDirtyTrackingSupported();
+}
+
+bool ResetDirtyPages()
+{
+  return g_arena.ResetDirtyPages();
+}
+
+void SetIncrementalState(bool incremental)
+{
+  s_incremental_state = incremental && IsDirtyTrackingSupported();
+  if (s_incremental_state)
+    CollectDirtyPages();
+  else
+    s_dirty_pages.clear();
+}
+
 void Shutdown()
 {
   m_IsInitialized = false;
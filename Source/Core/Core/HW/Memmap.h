@@ -64,6 +64,12 @@ void Init();
 void Shutdown();
 void DoState(PointerWrap& p);
 
+// Incremental states only contain the pages written since the last ResetDirtyPages(), so they
+// can only be loaded on top of the state that was current at that point.
+bool IsDirtyTrackingSupported();
+bool ResetDirtyPages();
+void SetIncrementalState(bool incremental);
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
@@ -45,8 +45,11 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <thread>
 
 #include "Common/Atomic.h"
 #include "Common/CommonTypes.h"
@@ -91,6 +94,9 @@ static int s_ipc_hle_period;
 // Custom RTC
 static s64 s_localtime_rtc_offset = 0;
 
+// Host time (GetTimeNs) at which the next throttle slice is due when precise pacing is enabled
+static u64 s_pacing_target_ns = 0;
+
 u32 GetTicksPerSecond()
 {
   return s_cpu_core_clock;
@@ -195,8 +201,70 @@ static void PatchEngineCallback(u64 userdata, s64 cycles_late)
   CoreTiming::ScheduleEvent(next_schedule, et_PatchEngine, cycles_pruned);
 }
 
+// Sleeps until slack_ns before the deadline, then spins the rest of the way.
+// The OS scheduler can't be trusted to wake us up on time, but it is good enough to get close.
+static void WaitUntilNs(u64 target_ns, u64 slack_ns)
+{
+  const u64 now = Common::Timer::GetTimeNs();
+  if (target_ns > now + slack_ns)
+    std::this_thread::sleep_for(std::chrono::nanoseconds(target_ns - now - slack_ns));
+
+  while (Common::Timer::GetTimeNs() < target_ns)
+    Common::YieldCPU();
+}
+
+// Same contract as ThrottleCallback, but tracks the deadline on the nanosecond clock so that
+// rounding to whole milliseconds doesn't show up as frame time jitter.
+static void PreciseThrottleCallback(s64 cyclesLate)
+{
+  constexpr u64 SLICE_NS = 1000000;
+
+  Fifo::GpuMaySleep();
+
+  const u64 time = Common::Timer::GetTimeNs();
+
+  const s64 diff = static_cast<s64>(s_pacing_target_ns - time);
+  const SConfig& config = SConfig::GetInstance();
+  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  u32 next_event = GetTicksPerSecond() / 1000;
+  if (frame_limiter)
+  {
+    if (config.m_EmulationSpeed != 1.0f)
+      next_event = u32(next_event * config.m_EmulationSpeed);
+    const s64 max_fallback = static_cast<s64>(config.iTimingVariance) * 1000000;
+    if (std::abs(diff) > max_fallback)
+    {
+      DEBUG_LOG(COMMON, "system too %s, %lld us skipped", diff < 0 ? "slow" : "fast",
+                static_cast<long long>((std::abs(diff) - max_fallback) / 1000));
+      s_pacing_target_ns = time - max_fallback;
+    }
+    else if (diff > 0)
+    {
+      // The slack has to be well below the length of a slice, or we never sleep and the CPU
+      // thread spins for as long as the limiter is on.
+      const u64 slack_ns = std::min<u64>(
+          static_cast<u64>(std::max(config.iFramePacingSlack, 0)) * 1000, SLICE_NS / 2);
+      WaitUntilNs(s_pacing_target_ns, slack_ns);
+    }
+  }
+  else
+  {
+    s_pacing_target_ns = time;
+  }
+  s_pacing_target_ns += SLICE_NS;
+
+  // Keep the millisecond timestamp current so the coarse throttle can take over seamlessly.
+  CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, Common::Timer::GetTimeMs());
+}
+
 static void ThrottleCallback(u64 last_time, s64 cyclesLate)
 {
+  if (SConfig::GetInstance().bPreciseFramePacing)
+  {
+    PreciseThrottleCallback(cyclesLate);
+    return;
+  }
+
   // Allow the GPU thread to sleep. Setting this flag here limits the wakeups to 1 kHz.
   Fifo::GpuMaySleep();
 
@@ -282,6 +350,7 @@ void Init()
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   CoreTiming::ScheduleEvent(0, et_DSP);
   CoreTiming::ScheduleEvent(s_audio_dma_period, et_AudioDMA);
+  s_pacing_target_ns = Common::Timer::GetTimeNs();
   CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeMs());
 
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField(), et_PatchEngine);
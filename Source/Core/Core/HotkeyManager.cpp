@@ -153,6 +153,8 @@ const std::string hotkey_labels[] = {
     _trans("Undo Save State"),
     _trans("Save State"),
     _trans("Load State"),
+    _trans("Save Quick Snapshot"),
+    _trans("Load Quick Snapshot"),
     _trans("Reload Post-Processing Shaders"),
 
     _trans("Toggle Noclip"),
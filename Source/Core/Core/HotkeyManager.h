@@ -151,6 +151,8 @@ enum Hotkey
   HK_UNDO_SAVE_STATE,
   HK_SAVE_STATE_FILE,
   HK_LOAD_STATE_FILE,
+  HK_SAVE_SNAPSHOT,
+  HK_LOAD_SNAPSHOT,
   HK_RELOAD_POSTPROCESS_SHADERS,
 
   HK_NOCLIP_TOGGLE,
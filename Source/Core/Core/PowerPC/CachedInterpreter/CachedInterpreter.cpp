@@ -11,6 +11,7 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/HostHooks.h"
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -143,6 +144,12 @@ static void WritePC(UGeckoInstruction data)
   NPC = data.hex + 4;
 }
 
+static void RunHostHook(UGeckoInstruction data)
+{
+  PC = data.hex;
+  HostHooks::Run(data.hex);
+}
+
 static void WriteBrokenBlockNPC(UGeckoInstruction data)
 {
   NPC = data.hex;
@@ -208,6 +215,9 @@ void CachedInterpreter::Jit(u32 address)
   {
     js.downcountAmount += ops[i].opinfo->numCycles;
 
+    if (HostHooks::Find(ops[i].address))
+      m_code.emplace_back(RunHostHook, ops[i].address);
+
     u32 function = HLE::GetFirstFunctionIndex(ops[i].address);
     if (function != 0)
     {
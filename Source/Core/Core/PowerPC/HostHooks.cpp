@@ -0,0 +1,52 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/HostHooks.h"
+
+#include <map>
+
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HostHooks
+{
+// std::map keeps the Hook objects at stable addresses, compiled code refers to them directly.
+static std::map<u32, Hook> s_hooks;
+
+void Add(u32 address, Callback callback, void* userdata)
+{
+  s_hooks[address] = Hook{callback, userdata};
+  JitInterface::InvalidateICache(address, 4, true);
+}
+
+void Remove(u32 address)
+{
+  if (s_hooks.erase(address))
+    JitInterface::InvalidateICache(address, 4, true);
+}
+
+void Clear()
+{
+  for (const auto& hook : s_hooks)
+    JitInterface::InvalidateICache(hook.first, 4, true);
+  s_hooks.clear();
+}
+
+const Hook* Find(u32 address)
+{
+  auto iter = s_hooks.find(address);
+  return iter != s_hooks.end() ? &iter->second : nullptr;
+}
+
+bool IsEmpty()
+{
+  return s_hooks.empty();
+}
+
+void Run(u32 address)
+{
+  if (const Hook* hook = Find(address))
+    hook->callback(hook->userdata, address);
+}
+}  // namespace HostHooks
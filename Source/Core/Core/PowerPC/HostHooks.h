@@ -0,0 +1,38 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Native callbacks that run right before the guest instruction at a given address executes.
+//
+// The JITs compile a direct call to the callback into the block containing the address. Guest
+// registers are written back to PowerPC::ppcState before the call and reloaded afterwards, so the
+// callback may read and modify registers and memory. It must not change control flow (PC/NPC).
+// The interpreters check for hooks before each instruction, like a breakpoint.
+//
+// Hooks may only be added or removed from the CPU thread.
+namespace HostHooks
+{
+using Callback = void (*)(void* userdata, u32 address);
+
+struct Hook
+{
+  Callback callback;
+  void* userdata;
+};
+
+// Replaces any hook already installed at address.
+void Add(u32 address, Callback callback, void* userdata);
+void Remove(u32 address);
+void Clear();
+
+// The returned hook stays valid until it is removed; blocks referencing it are invalidated then.
+const Hook* Find(u32 address);
+bool IsEmpty();
+
+// Runs the hook at address, if any. Used by the interpreters.
+void Run(u32 address);
+}  // namespace HostHooks
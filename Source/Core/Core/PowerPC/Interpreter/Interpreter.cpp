@@ -20,6 +20,7 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/Host.h"
+#include "Core/PowerPC/HostHooks.h"
 #include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -101,6 +102,9 @@ static void Trace(UGeckoInstruction& inst)
 
 int Interpreter::SingleStepInner()
 {
+  if (!HostHooks::IsEmpty())
+    HostHooks::Run(PC);
+
   u32 function = HLE::GetFirstFunctionIndex(PC);
   if (function != 0)
   {
@@ -14,6 +14,7 @@
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PrimeHack/HackConfig.h"
 
 /*
 
@@ -165,6 +166,8 @@ static void SetSR(int index, u32 value)
   DEBUG_LOG(POWERPC, "%08x: MMU: Segment register %i set to %08x", PowerPC::ppcState.pc, index,
             value);
   PowerPC::ppcState.sr[index] = value;
+
+  prime::GetHackManager()->dispatch(prime::HackEvent::SR_UPDATE);
 }
 
 void Interpreter::mtsr(UGeckoInstruction inst)
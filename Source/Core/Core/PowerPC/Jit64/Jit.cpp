@@ -320,6 +320,19 @@ void Jit64::HLEFunction(UGeckoInstruction _inst)
   ABI_PopRegistersAndAdjustStack({}, 0);
 }
 
+void Jit64::HostHookCall(const HostHooks::Hook& hook)
+{
+  // Spill the guest registers so the callback sees them in ppcState; they are reloaded lazily
+  // afterwards, which picks up any changes it made. Unlike HLE, the block continues normally.
+  FlushCarry();
+  gpr.Flush();
+  fpr.Flush();
+  MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPC(hook.callback, hook.userdata, js.compilerPC);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+}
+
 void Jit64::DoNothing(UGeckoInstruction _inst)
 {
   // Yup, just don't do anything.
@@ -866,6 +879,9 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
         SetJumpTarget(noBreakpoint);
       }
 
+      if (const HostHooks::Hook* hook = HostHooks::Find(ops[i].address))
+        HostHookCall(*hook);
+
       // If we have an input register that is going to be used again, load it pre-emptively,
       // even if the instruction doesn't strictly need it in a register, to avoid redundant
       // loads later. Of course, don't do this if we're already out of registers.
@@ -25,6 +25,7 @@
 #include "Core/PowerPC/Jit64/GPRRegCache.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
+#include "Core/PowerPC/HostHooks.h"
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -82,6 +83,7 @@ public:
   void FinalizeCarryOverflow(bool oe, bool inv = false);
   void FinalizeCarry(Gen::CCFlags cond);
   void FinalizeCarry(bool ca);
+  void FlushCarry();
   void ComputeRC(const Gen::OpArg& arg, bool needs_test = true, bool needs_sext = true);
 
   // Use to extract bytes from a register using the regcache. offset is in bytes.
@@ -125,6 +127,7 @@ public:
   void FallBackToInterpreter(UGeckoInstruction _inst);
   void DoNothing(UGeckoInstruction _inst);
   void HLEFunction(UGeckoInstruction _inst);
+  void HostHookCall(const HostHooks::Hook& hook);
 
   void DynaRunTable4(UGeckoInstruction _inst);
   void DynaRunTable19(UGeckoInstruction _inst);
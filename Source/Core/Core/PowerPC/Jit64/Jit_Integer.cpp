@@ -116,6 +116,18 @@ void Jit64::FinalizeCarry(bool ca)
   }
 }
 
+// Stores a carry kept in the host flags for the next instruction, before something clobbers them.
+void Jit64::FlushCarry()
+{
+  if (!js.carryFlagSet)
+    return;
+
+  JitSetCAIf(js.carryFlagInverted ? CC_NC : CC_C);
+  UnlockFlags();
+  js.carryFlagSet = false;
+  js.carryFlagInverted = false;
+}
+
 void Jit64::FinalizeCarryOverflow(bool oe, bool inv)
 {
   if (oe)
@@ -216,6 +216,21 @@ void JitArm64::HLEFunction(UGeckoInstruction inst)
   gpr.Unlock(WA);
 }
 
+void JitArm64::HostHookCall(const HostHooks::Hook& hook)
+{
+  // Spill the guest registers so the callback sees them in ppcState; they are reloaded lazily
+  // afterwards. Nothing else is live in caller-saved registers once everything is flushed.
+  FlushCarry();
+  gpr.Flush(FlushMode::FLUSH_ALL);
+  fpr.Flush(FlushMode::FLUSH_ALL);
+
+  MOVI2R(W1, js.compilerPC);
+  STR(INDEX_UNSIGNED, W1, PPC_REG, PPCSTATE_OFF(pc));
+  MOVP2R(X0, hook.userdata);
+  MOVP2R(X30, hook.callback);
+  BLR(X30);
+}
+
 void JitArm64::DoNothing(UGeckoInstruction inst)
 {
   // Yup, just don't do anything.
@@ -771,6 +786,9 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
         js.firstFPInstructionFound = true;
       }
 
+      if (const HostHooks::Hook* hook = HostHooks::Find(ops[i].address))
+        HostHookCall(*hook);
+
       CompileInstruction(ops[i]);
       if (!CanMergeNextInstructions(1) || js.op[1].opinfo->type != ::OpType::Integer)
         FlushCarry();
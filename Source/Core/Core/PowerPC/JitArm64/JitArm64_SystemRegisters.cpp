@@ -11,6 +11,7 @@
 #include "Core/PowerPC/JitArm64/Jit.h"
 #include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PrimeHack/HackConfig.h"
 
 using namespace Arm64Gen;
 
@@ -118,6 +119,13 @@ void JitArm64::mtsr(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
 
+  // Let the interpreter notify mods watching segment register writes
+  if (prime::GetHackManager()->has_subscribers(prime::HackEvent::SR_UPDATE))
+  {
+    FallBackToInterpreter(inst);
+    return;
+  }
+
   gpr.BindToRegister(inst.RS, true);
   STR(INDEX_UNSIGNED, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF(sr[inst.SR]));
 }
@@ -146,6 +154,12 @@ void JitArm64::mtsrin(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
 
+  if (prime::GetHackManager()->has_subscribers(prime::HackEvent::SR_UPDATE))
+  {
+    FallBackToInterpreter(inst);
+    return;
+  }
+
   u32 b = inst.RB, d = inst.RD;
   gpr.BindToRegister(d, d == b);
 
@@ -17,6 +17,7 @@
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PrimeHack/HackConfig.h"
 
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -166,6 +167,13 @@ BatTable dbat_table;
 
 static void GenerateDSIException(u32 _EffectiveAddress, bool _bWrite);
 
+// Makes sure EFB copies the video backend hasn't written to RAM yet are visible to the CPU.
+static void ResolveDeferredEFBCopies(u32 address, u32 size)
+{
+  if (g_video_backend->HasDeferredEFBCopies(address, size))
+    g_video_backend->Video_ResolveDeferredEFBCopies(address, size);
+}
+
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
 static T ReadFromHardware(u32 em_address)
 {
@@ -212,6 +220,8 @@ static T ReadFromHardware(u32 em_address)
     // Handle RAM; the masking intentionally discards bits (essentially creating
     // mirrors of memory).
     // TODO: Only the first REALRAM_SIZE is supposed to be backed by actual memory.
+    if (flag == XCheckTLBFlag::Read)
+      ResolveDeferredEFBCopies(em_address & Memory::RAM_MASK, sizeof(T));
     T value;
     std::memcpy(&value, &Memory::m_pRAM[em_address & Memory::RAM_MASK], sizeof(T));
     return bswap(value);
@@ -220,6 +230,8 @@ static T ReadFromHardware(u32 em_address)
   if (Memory::m_pEXRAM && (em_address >> 28) == 0x1 &&
       (em_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
   {
+    if (flag == XCheckTLBFlag::Read)
+      ResolveDeferredEFBCopies(em_address, sizeof(T));
     T value;
     std::memcpy(&value, &Memory::m_pEXRAM[em_address & 0x0FFFFFFF], sizeof(T));
     return bswap(value);
@@ -301,6 +313,8 @@ static void WriteToHardware(u32 em_address, const T data)
     // Handle RAM; the masking intentionally discards bits (essentially creating
     // mirrors of memory).
     // TODO: Only the first REALRAM_SIZE is supposed to be backed by actual memory.
+    if (flag == XCheckTLBFlag::Write)
+      ResolveDeferredEFBCopies(em_address & Memory::RAM_MASK, sizeof(T));
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pRAM[em_address & Memory::RAM_MASK], &swapped_data, sizeof(T));
     return;
@@ -309,6 +323,8 @@ static void WriteToHardware(u32 em_address, const T data)
   if (Memory::m_pEXRAM && (em_address >> 28) == 0x1 &&
       (em_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
   {
+    if (flag == XCheckTLBFlag::Write)
+      ResolveDeferredEFBCopies(em_address, sizeof(T));
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pEXRAM[em_address & 0x0FFFFFFF], &swapped_data, sizeof(T));
     return;
@@ -1265,6 +1281,8 @@ void DBATUpdated()
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
+
+  prime::GetHackManager()->dispatch(prime::HackEvent::BAT_UPDATE);
 }
 
 void IBATUpdated()
@@ -1281,6 +1299,8 @@ void IBATUpdated()
     UpdateFakeMMUBat(ibat_table, 0x70000000);
   }
   JitInterface::ClearSafe();
+
+  prime::GetHackManager()->dispatch(prime::HackEvent::BAT_UPDATE);
 }
 
 // Translate effective address using BAT or PAT.  Returns 0 if the address cannot be translated.
@@ -0,0 +1,313 @@
+#include "Core/PrimeHack/DevTelemetry.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Common/File.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/GraphicsSettings.h"
+
+namespace prime {
+namespace {
+enum class FieldType : u8 { Text, Hex, Int, Float, Vec3, Matrix };
+
+struct Field {
+  const char* name;
+  FieldType type;
+  // Hex/Int value, or the offset of a Text field in Frame::text.
+  u32 value;
+  u32 length;
+  float values[12];
+};
+
+constexpr size_t kMaxFields = 64;
+constexpr size_t kTextCapacity = 8 * 1024;
+
+struct Frame {
+  std::array<Field, kMaxFields> fields;
+  size_t field_count = 0;
+  std::array<char, kTextCapacity> text;
+  size_t text_used = 0;
+  u64 number = 0;
+};
+
+// The CPU thread fills frames[back_index]; the other frame is the last published one and is only
+// read, by the OSD (under front_lock) and by the exporter (on the CPU thread).
+std::array<Frame, 2> frames;
+size_t back_index = 0;
+u64 frame_number = 0;
+std::mutex front_lock;
+
+Field* AddField(const char* name, FieldType type) {
+  Frame& frame = frames[back_index];
+  if (frame.field_count == kMaxFields) {
+    return nullptr;
+  }
+
+  Field& field = frame.fields[frame.field_count++];
+  field.name = name;
+  field.type = type;
+  return &field;
+}
+
+void AppendFormat(std::string* out, const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int length = std::vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (length > 0) {
+    out->append(buf, std::min<size_t>(length, sizeof(buf) - 1));
+  }
+}
+
+void FormatFrame(const Frame& frame, std::string* out) {
+  for (size_t i = 0; i < frame.field_count; i++) {
+    const Field& f = frame.fields[i];
+    switch (f.type) {
+    case FieldType::Text:
+      out->append(f.name);
+      out->append(": ");
+      out->append(frame.text.data() + f.value, f.length);
+      break;
+    case FieldType::Hex:
+      AppendFormat(out, "%s: %08X", f.name, f.value);
+      break;
+    case FieldType::Int:
+      AppendFormat(out, "%s: %u", f.name, f.value);
+      break;
+    case FieldType::Float:
+      AppendFormat(out, "%s: %.3f", f.name, f.values[0]);
+      break;
+    case FieldType::Vec3:
+      AppendFormat(out, "%s: \n   X: %.3f\n   Y: %.3f\n   Z: %.3f", f.name, f.values[0],
+                   f.values[1], f.values[2]);
+      break;
+    case FieldType::Matrix:
+      out->append(f.name);
+      out->append(":");
+      for (int row = 0; row < 3; row++) {
+        const float* m = &f.values[row * 4];
+        AppendFormat(out, "\n   %.3f    %.3f    %.3f    %.3f", m[0], m[1], m[2], m[3]);
+      }
+      break;
+    }
+    out->push_back('\n');
+  }
+}
+
+// Writes each published frame as one JSON object per line, either to a file or as a datagram to
+// a UNIX socket ("unix:/path/to/socket"), so tools can follow the values without parsing the OSD.
+class Exporter {
+public:
+  ~Exporter() { Close(); }
+
+  void Export(const Frame& frame) {
+    // Re-read the target about once a second so it can be changed without restarting.
+    if (frame.number % 60 == 1) {
+      UpdateTarget();
+    }
+    if (!m_file.IsOpen() && m_socket < 0) {
+      return;
+    }
+
+    m_line.clear();
+    AppendFormat(&m_line, "{\"frame\":%llu", static_cast<unsigned long long>(frame.number));
+    for (size_t i = 0; i < frame.field_count; i++) {
+      const Field& f = frame.fields[i];
+      m_line.append(",");
+      AppendString(f.name, std::strlen(f.name));
+      m_line.append(":");
+      switch (f.type) {
+      case FieldType::Text:
+        AppendString(frame.text.data() + f.value, f.length);
+        break;
+      case FieldType::Hex:
+      case FieldType::Int:
+        AppendFormat(&m_line, "%u", f.value);
+        break;
+      case FieldType::Float:
+        AppendFormat(&m_line, "%g", f.values[0]);
+        break;
+      case FieldType::Vec3:
+        AppendFormat(&m_line, "[%g,%g,%g]", f.values[0], f.values[1], f.values[2]);
+        break;
+      case FieldType::Matrix:
+        m_line.append("[");
+        for (int v = 0; v < 12; v++) {
+          AppendFormat(&m_line, v == 0 ? "%g" : ",%g", f.values[v]);
+        }
+        m_line.append("]");
+        break;
+      }
+    }
+    m_line.append("}\n");
+
+#ifndef _WIN32
+    if (m_socket >= 0) {
+      sendto(m_socket, m_line.data(), m_line.size(), MSG_DONTWAIT,
+             reinterpret_cast<const sockaddr*>(&m_addr), sizeof(m_addr));
+      return;
+    }
+#endif
+    m_file.WriteBytes(m_line.data(), m_line.size());
+    if (frame.number % 60 == 0) {
+      m_file.Flush();
+    }
+  }
+
+  void Close() {
+    m_file.Close();
+#ifndef _WIN32
+    if (m_socket >= 0) {
+      close(m_socket);
+      m_socket = -1;
+    }
+#endif
+  }
+
+private:
+  void UpdateTarget() {
+    const std::string target = Config::Get(Config::PRIMEHACK_INFO_EXPORT);
+    if (target == m_target) {
+      return;
+    }
+
+    Close();
+    m_target = target;
+    if (m_target.empty()) {
+      return;
+    }
+
+#ifndef _WIN32
+    if (StringBeginsWith(m_target, "unix:")) {
+      std::memset(&m_addr, 0, sizeof(m_addr));
+      m_addr.sun_family = AF_UNIX;
+      std::strncpy(m_addr.sun_path, m_target.c_str() + 5, sizeof(m_addr.sun_path) - 1);
+      m_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+      return;
+    }
+#endif
+    m_file.Open(m_target, "wb");
+  }
+
+  void AppendString(const char* str, size_t length) {
+    m_line.push_back('"');
+    for (size_t i = 0; i < length; i++) {
+      const char c = str[i];
+      if (c == '"' || c == '\\') {
+        m_line.push_back('\\');
+        m_line.push_back(c);
+      }
+      else if (static_cast<u8>(c) < 0x20) {
+        AppendFormat(&m_line, "\\u%04x", c);
+      }
+      else {
+        m_line.push_back(c);
+      }
+    }
+    m_line.push_back('"');
+  }
+
+  std::string m_target;
+  std::string m_line;
+  File::IOFile m_file;
+#ifndef _WIN32
+  sockaddr_un m_addr = {};
+#endif
+  int m_socket = -1;
+};
+
+Exporter exporter;
+}  // namespace
+
+void DevInfo(const char* name, const char* format, ...) {
+  Frame& frame = frames[back_index];
+  const size_t available = kTextCapacity - frame.text_used;
+  if (available < 2) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, format);
+  int length = std::vsnprintf(frame.text.data() + frame.text_used, available, format, args);
+  va_end(args);
+  if (length < 0) {
+    return;
+  }
+
+  Field* field = AddField(name, FieldType::Text);
+  if (!field) {
+    return;
+  }
+  field->value = static_cast<u32>(frame.text_used);
+  field->length = static_cast<u32>(std::min<size_t>(length, available - 1));
+  frame.text_used += field->length;
+}
+
+void DevInfoHex(const char* name, u32 value) {
+  if (Field* field = AddField(name, FieldType::Hex)) {
+    field->value = value;
+  }
+}
+
+void DevInfoInt(const char* name, u32 value) {
+  if (Field* field = AddField(name, FieldType::Int)) {
+    field->value = value;
+  }
+}
+
+void DevInfoFloat(const char* name, float value) {
+  if (Field* field = AddField(name, FieldType::Float)) {
+    field->values[0] = value;
+  }
+}
+
+void DevInfoVec3(const char* name, const vec3& value) {
+  if (Field* field = AddField(name, FieldType::Vec3)) {
+    std::memcpy(field->values, value.arr, sizeof(value.arr));
+  }
+}
+
+void DevInfoMatrix(const char* name, const Transform& t) {
+  if (Field* field = AddField(name, FieldType::Matrix)) {
+    std::memcpy(field->values, t.m, sizeof(t.m));
+  }
+}
+
+void FormatDevInfo(std::string* out) {
+  out->clear();
+  std::lock_guard<std::mutex> lock(front_lock);
+  FormatFrame(frames[back_index ^ 1], out);
+}
+
+std::string GetDevInfo() {
+  std::string result;
+  FormatDevInfo(&result);
+  return result;
+}
+
+void ClrDevInfo() {
+  {
+    std::lock_guard<std::mutex> lock(front_lock);
+    frames[back_index].number = ++frame_number;
+    back_index ^= 1;
+  }
+
+  exporter.Export(frames[back_index ^ 1]);
+
+  Frame& back = frames[back_index];
+  back.field_count = 0;
+  back.text_used = 0;
+}
+}  // namespace prime
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Core/PrimeHack/Transform.h"
+
+// Dev info fields are recorded on the CPU thread into a fixed-size back buffer without
+// allocating or formatting. ClrDevInfo() publishes the finished frame, which is only turned into
+// text when the OSD asks for it or when an exporter is configured.
+//
+// Field names must be string literals (or otherwise outlive the frame), only the pointer is kept.
+namespace prime {
+void DevInfo(const char* name, const char* format, ...);
+void DevInfoHex(const char* name, u32 value);
+void DevInfoInt(const char* name, u32 value);
+void DevInfoFloat(const char* name, float value);
+void DevInfoVec3(const char* name, const vec3& value);
+void DevInfoMatrix(const char* name, const Transform& t);
+
+// Formats the last published frame, reusing the capacity of out.
+void FormatDevInfo(std::string* out);
+std::string GetDevInfo();
+
+// Publishes the fields recorded since the last call and starts a new frame.
+void ClrDevInfo();
+}  // namespace prime
@@ -3,6 +3,7 @@
 #include <array>
 #include <string>
 
+#include "Common/Config/CachedValue.h"
 #include "Common/IniFile.h"
 #include "Core/PrimeHack/PrimeUtils.h"
 #include "Core/PrimeHack/EmuVariableManager.h"
@@ -199,11 +200,13 @@ void SetEFBToTexture(bool toggle) {
 }
 
 bool UseMPAutoEFB() {
-  return Config::Get(Config::AUTO_EFB);
+  static Config::CachedValue<bool> value(Config::AUTO_EFB);
+  return value.Get();
 }
 
 bool LockCameraInPuzzles() {
-  return Config::Get(Config::LOCKCAMERA_IN_PUZZLES);
+  static Config::CachedValue<bool> value(Config::LOCKCAMERA_IN_PUZZLES);
+  return value.Get();
 }
 
 bool GetNoclip() {
@@ -223,41 +226,52 @@ bool GetRestoreDashing() {
 }
 
 bool GetEFBTexture() {
-  return Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  static Config::CachedValue<bool> value(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  return value.Get();
 }
 
 bool GetBloom() {
-  return Config::Get(Config::DISABLE_BLOOM);
+  static Config::CachedValue<bool> value(Config::DISABLE_BLOOM);
+  return value.Get();
 }
 
 bool GetReduceBloom() {
-  return Config::Get(Config::REDUCE_BLOOM);
+  static Config::CachedValue<bool> value(Config::REDUCE_BLOOM);
+  return value.Get();
 }
 
 bool GetEnableSecondaryGunFX() {
-  return Config::Get(Config::ENABLE_SECONDARY_GUNFX);
+  static Config::CachedValue<bool> value(Config::ENABLE_SECONDARY_GUNFX);
+  return value.Get();
 }
 
 bool GetShowGCCrosshair() {
-  return Config::Get(Config::GC_SHOW_CROSSHAIR);
+  static Config::CachedValue<bool> value(Config::GC_SHOW_CROSSHAIR);
+  return value.Get();
 }
 
 u32 GetGCCrosshairColor() {
-  return Config::Get(Config::GC_CROSSHAIR_COLOR_RGBA);
+  static Config::CachedValue<int> value(Config::GC_CROSSHAIR_COLOR_RGBA);
+  return value.Get();
 }
 
 bool GetAutoArmAdjust() {
-  return Config::Get(Config::ARMPOSITION_MODE) == 1;
+  static Config::CachedValue<bool> value(Config::ARMPOSITION_MODE);
+  return value.Get() == 1;
 }
 
 bool GetToggleArmAdjust() {
-  return Config::Get(Config::TOGGLE_ARM_REPOSITION);
+  static Config::CachedValue<bool> value(Config::TOGGLE_ARM_REPOSITION);
+  return value.Get();
 }
 
 std::tuple<float, float, float> GetArmXYZ() {
-  float x = Config::Get(Config::ARMPOSITION_LEFTRIGHT) / 100.f;
-  float y = Config::Get(Config::ARMPOSITION_FORWARDBACK) / 100.f;
-  float z = Config::Get(Config::ARMPOSITION_UPDOWN) / 100.f;
+  static Config::CachedValue<int> left_right(Config::ARMPOSITION_LEFTRIGHT);
+  static Config::CachedValue<int> forward_back(Config::ARMPOSITION_FORWARDBACK);
+  static Config::CachedValue<int> up_down(Config::ARMPOSITION_UPDOWN);
+  float x = left_right.Get() / 100.f;
+  float y = forward_back.Get() / 100.f;
+  float z = up_down.Get() / 100.f;
 
   return std::make_tuple(x, y, z);
 }
@@ -298,7 +312,8 @@ void SetCursorSensitivity(float sens) {
 }
 
 float GetFov() {
-  return Config::Get(Config::FOV);
+  static Config::CachedValue<int> value(Config::FOV);
+  return value.Get();
 }
 
 bool InvertedY() {
@@ -360,7 +375,8 @@ std::string const& GetCtlDeviceSource() {
 }
 
 bool GetCulling() {
-  return Config::Get(Config::TOGGLE_CULLING);
+  static Config::CachedValue<bool> value(Config::TOGGLE_CULLING);
+  return value.Get();
 }
 
 bool HandleReticleLockOn()
@@ -1,10 +1,14 @@
 #include "Core/PrimeHack/HackManager.h"
 
+#include <algorithm>
+
 #include "Core/PrimeHack/HackConfig.h"
 #include "Core/PrimeHack/PrimeUtils.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/PowerPC/HostHooks.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "InputCommon/GenericMouse.h"
 
 namespace prime {
@@ -20,6 +24,9 @@ HackManager::HackManager()
                             (static_cast<u32>(d) & 0x000000ff))
 
 void HackManager::run_active_mods() {
+  // Latch the mouse as late as possible, right before the mods write the camera to the game.
+  prime::g_mouse_input->LatchDeltas();
+
   if (Core::GetState() != Core::State::Running)
     return;
 
@@ -289,6 +296,11 @@ void HackManager::shutdown() {
   for (auto& mod : mods) {
     mod.second->reset_mod();
   }
+  for (auto& hook : pc_hooks) {
+    HostHooks::Remove(hook.first);
+  }
+  pc_hooks.clear();
+  event_subscriptions.clear();
   last_game = Game::INVALID_GAME;
   last_region = Region::INVALID_REGION;
 }
@@ -301,4 +313,73 @@ PrimeMod *HackManager::get_mod(std::string const& name) {
   return result->second.get();
 }
 
+void HackManager::subscribe(HackEvent event, const PrimeMod* owner, EventCallback callback) {
+  event_subscriptions.push_back({event, owner, std::move(callback)});
+
+  // The JIT only calls out on segment register writes while somebody is listening. Mods
+  // subscribe from the CPU thread, possibly from inside a block, so only drop the block links
+  // here; freeing the code under the running block would crash.
+  if (event == HackEvent::SR_UPDATE) {
+    JitInterface::ClearSafe();
+  }
+}
+
+void HackManager::add_pc_hook(u32 pc, const PrimeMod* owner, PcHookCallback callback) {
+  if (pc_hooks.find(pc) == pc_hooks.end()) {
+    HostHooks::Add(pc, &HackManager::run_pc_hook, this);
+  }
+  pc_hooks.emplace(pc, PcHook{owner, std::move(callback)});
+}
+
+void HackManager::remove_hooks(const PrimeMod* owner) {
+  event_subscriptions.erase(
+      std::remove_if(event_subscriptions.begin(), event_subscriptions.end(),
+                     [owner](const EventSubscription& sub) { return sub.owner == owner; }),
+      event_subscriptions.end());
+
+  for (auto it = pc_hooks.begin(); it != pc_hooks.end();) {
+    if (it->second.owner != owner) {
+      ++it;
+      continue;
+    }
+    const u32 pc = it->first;
+    it = pc_hooks.erase(it);
+    if (pc_hooks.find(pc) == pc_hooks.end()) {
+      HostHooks::Remove(pc);
+    }
+  }
+}
+
+bool HackManager::has_subscribers(HackEvent event) const {
+  return std::any_of(event_subscriptions.begin(), event_subscriptions.end(),
+                     [event](const EventSubscription& sub) { return sub.event == event; });
+}
+
+void HackManager::run_pc_hook(void* manager, u32 pc) {
+  static_cast<HackManager*>(manager)->dispatch_pc_hit(pc);
+}
+
+void HackManager::dispatch(HackEvent event) {
+  // Handlers commonly cause the event they are reacting to (e.g. writing a BAT register),
+  // don't recurse into them.
+  if (dispatching) {
+    return;
+  }
+
+  dispatching = true;
+  for (size_t i = 0; i < event_subscriptions.size(); i++) {
+    if (event_subscriptions[i].event == event) {
+      event_subscriptions[i].callback();
+    }
+  }
+  dispatching = false;
+}
+
+void HackManager::dispatch_pc_hit(u32 pc) {
+  auto range = pc_hooks.equal_range(pc);
+  for (auto it = range.first; it != range.second; ++it) {
+    it->second.callback(pc);
+  }
+}
+
 }
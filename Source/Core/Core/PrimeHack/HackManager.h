@@ -1,12 +1,25 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <map>
+#include <vector>
 
 #include "Core/PrimeHack/PrimeMod.h"
 
 namespace prime {
 
+// Emulator events mods can react to synchronously, i.e. in the same emulated cycle as the event
+// rather than on the next ActionReplay run.
+enum class HackEvent {
+  // A BAT register was written (PowerPC::IBATUpdated / DBATUpdated)
+  BAT_UPDATE,
+  // A segment register was written (mtsr / mtsrin)
+  SR_UPDATE,
+  // The boot process finished loading the executable
+  BOOT,
+};
+
 // Determines current running game, activates enabled modifications for said game
 class HackManager {
 public:
@@ -34,7 +47,33 @@ public:
 
   PrimeMod *get_mod(std::string const& name);
 
+  // Callbacks run on the CPU thread. Subscriptions are keyed by owner so that a mod can drop
+  // all of them at once with remove_hooks.
+  using EventCallback = std::function<void()>;
+  using PcHookCallback = std::function<void(u32 pc)>;
+  void subscribe(HackEvent event, const PrimeMod* owner, EventCallback callback);
+  // Runs callback right before the instruction at pc executes. The JIT calls it from inside the
+  // block (see HostHooks), so it may change guest registers but not control flow.
+  void add_pc_hook(u32 pc, const PrimeMod* owner, PcHookCallback callback);
+  void remove_hooks(const PrimeMod* owner);
+  bool has_subscribers(HackEvent event) const;
+
+  void dispatch(HackEvent event);
+  void dispatch_pc_hit(u32 pc);
+
 private:
+  struct EventSubscription {
+    HackEvent event;
+    const PrimeMod* owner;
+    EventCallback callback;
+  };
+  struct PcHook {
+    const PrimeMod* owner;
+    PcHookCallback callback;
+  };
+
+  static void run_pc_hook(void* manager, u32 pc);
+
   Game active_game;
   Region active_region;
   Game last_game;
@@ -42,6 +81,10 @@ private:
 
   std::map<std::string, std::unique_ptr<PrimeMod>> mods;
   std::map<std::string, ModState> mod_state_backup;
+
+  std::vector<EventSubscription> event_subscriptions;
+  std::multimap<u32, PcHook> pc_hooks;
+  bool dispatching = false;
 };
   
 }
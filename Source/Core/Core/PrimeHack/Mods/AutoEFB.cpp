@@ -1,6 +1,8 @@
 #include "Core/PrimeHack/Mods/AutoEFB.h"
 
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/PrimeHack/PrimeUtils.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace prime {
 void AutoEFB::run_mod(Game game, Region region) {
@@ -12,6 +14,16 @@ void AutoEFB::run_mod(Game game, Region region) {
     return;
   }
 
+  // Deferred copies only reach RAM when something reads them, so they are cheap enough to keep
+  // on all the time, and the visors that need them always see correct data.
+  if (Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES) &&
+      g_Config.backend_info.bSupportsDeferredEFBCopies) {
+    if (GetEFBTexture()) {
+      SetEFBToTexture(false);
+    }
+    return;
+  }
+
   bool should_use = true;
 
   if (game == Game::PRIME_2) {
@@ -112,15 +112,9 @@ void ElfModLoader::run_mod(Game game, Region region) {
     load_state = LoadState::ACTIVE;
   };
 
-  // ELF is mapped into an extended memory region
-  // We would do this with instruction patches but
-  // dolphin can't patch fast enough to catch the BATs
-  // being assigned!
   switch (game) {
   case Game::PRIME_1_GCN:
   case Game::PRIME_2_GCN:
-    update_bat_regs();
-    
     if (region != Region::NTSC_U) {
       return;
     }
@@ -170,7 +164,19 @@ void ElfModLoader::run_mod(Game game, Region region) {
 }
 
 bool ElfModLoader::init_mod(Game game, Region region) {
-  if ((game == Game::PRIME_1_GCN || game == Game::PRIME_2_GCN) && region == Region::NTSC_U) {
+  // ELF is mapped into an extended memory region, which has to be re-applied
+  // in the same cycle the game assigns its BATs, otherwise the mod's code
+  // can run unmapped in between.
+  HackManager* manager = GetHackManager();
+  manager->remove_hooks(this);
+  if (game == Game::PRIME_1_GCN || game == Game::PRIME_2_GCN) {
+    manager->subscribe(HackEvent::BAT_UPDATE, this, [this] {
+      const Game active_game = GetHackManager()->get_active_game();
+      if (mod_state() != ModState::DISABLED &&
+          (active_game == Game::PRIME_1_GCN || active_game == Game::PRIME_2_GCN)) {
+        update_bat_regs();
+      }
+    });
     update_bat_regs();
   }
 
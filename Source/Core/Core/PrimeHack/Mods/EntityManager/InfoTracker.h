@@ -6,17 +6,13 @@
 #include "Core/PrimeHack/PrimeUtils.h"
 #include "Core/PrimeHack/TextureSwapper.h"
 
+#include "VideoCommon/RoomUsageProfiler.h"
 #include "VideoCommon/Util/Aether.h"
 
 namespace prime {
   bool HasPhazonSuit = false;
 
   class InfoTracker : public PrimeMod {
-  const char* xyz_format =
-    "\n   X: %.3f"
-    "\n   Y: %.3f"
-    "\n   Z: %.3f";
-
   public:
     u32 current_world = -1;
     u32 current_area = -1;
@@ -29,12 +25,19 @@ namespace prime {
       Transform position;
 
       if (game == Game::PRIME_1_GCN) {
-        DevInfo("World_ID", "%08X", read32(read32(mp1_gc_static.world_ptr) + 0x8));
-        DevInfo("Area_ID", "%02X", read32(read32(mp1_gc_static.world_ptr) + 0x68));
+        u32 world_id = read32(read32(mp1_gc_static.world_ptr) + 0x8);
+        u32 area_id = read32(read32(mp1_gc_static.world_ptr) + 0x68);
+        DevInfoHex("World_ID", world_id);
+        DevInfoHex("Area_ID", area_id);
+
+        // There is no world while loading or in the menus.
+        if (read32(mp1_gc_static.world_ptr) != 0)
+          RoomUsage::EnterRoom(world_id, area_id);
 
         LOOKUP(state_manager);
-        DevInfo("Object Count", "%d  (max: 1024)", read16(read32(state_manager + 0x810) + 0x200a));
-        DevInfo("GameLight Count", "%d (address: %x)", read16(read32(state_manager + 0x828) + 0x200a), read32(state_manager + 0x828));
+        DevInfoInt("Object Count (max 1024)", read16(read32(state_manager + 0x810) + 0x200a));
+        DevInfoInt("GameLight Count", read16(read32(state_manager + 0x828) + 0x200a));
+        DevInfoHex("GameLight Address", read32(state_manager + 0x828));
 
         position.read_from(mp1_gc_static.cplayer_address + 0x34);
       }
@@ -42,8 +45,8 @@ namespace prime {
       if (game == Game::PRIME_1) {
         u32 world_id = read32(read32(mp1_static.world_ptr) + 0x14);
         u32 area_id = read32(read32(mp1_static.world_ptr) + 0x6C);
-        DevInfo("World_ID", "%08X", world_id);
-        DevInfo("Area_ID", "%08X", area_id);
+        DevInfoHex("World_ID", world_id);
+        DevInfoHex("Area_ID", area_id);
 
         SetCurrentPosition(world_id, area_id);
 
@@ -52,9 +55,13 @@ namespace prime {
           current_area = area_id;
         }
 
+        if (read32(mp1_static.world_ptr) != 0)
+          RoomUsage::EnterRoom(world_id, area_id);
+
         LOOKUP(state_manager);
-        DevInfo("Object Count", "%d (max: 1024)", read16(read32(state_manager + 0x810) + 0x200a));
-        DevInfo("GameLight Count", "%d (address: %x)", read16(read32(state_manager + 0x828) + 0x200a), read32(state_manager + 0x828));
+        DevInfoInt("Object Count (max 1024)", read16(read32(state_manager + 0x810) + 0x200a));
+        DevInfoInt("GameLight Count", read16(read32(state_manager + 0x828) + 0x200a));
+        DevInfoHex("GameLight Address", read32(state_manager + 0x828));
 
         position.read_from(mp1_static.cplayer_address + 0x2c);
       }
@@ -72,7 +79,7 @@ namespace prime {
         Aether::InitPaks();
 
       vec3 xyz = position.loc();
-      DevInfo("Position", xyz_format, xyz.x, xyz.y, xyz.z);
+      DevInfoVec3("Position", xyz);
     }
 
     bool init_mod(Game game, Region region) override {
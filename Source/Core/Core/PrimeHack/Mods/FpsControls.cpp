@@ -243,7 +243,7 @@ void FpsControls::handle_beam_visor_switch(std::array<int, 4> const &beams,
     }
   }
 
-  DevInfo("powerups_array", "%08X", powerups_array);
+  DevInfoHex("powerups_array", powerups_array);
 }
 
 void FpsControls::run_mod_menu(Game game, Region region) {
@@ -267,7 +267,7 @@ void FpsControls::run_mod_mp1(Region region) {
   if (player == 0) {
     return;
   }
-  DevInfo("Player", "%08x", player);
+  DevInfoHex("Player", player);
 
   handle_beam_visor_switch(prime_one_beams, prime_one_visors);
   CheckBeamVisorSetting(Game::PRIME_1);
@@ -353,7 +353,7 @@ void FpsControls::run_mod_mp1_gc(Region region) {
   if (player == 0) {
     return;
   }
-  DevInfo("Player", "%08x", player);
+  DevInfoHex("Player", player);
 
   LOOKUP_DYN(player_xf);
   Transform cplayer_xf(player_xf);
@@ -411,7 +411,7 @@ void FpsControls::run_mod_mp2(Region region) {
   if (player == 0) {
     return;
   }
-  DevInfo("Player", "%08x", player);
+  DevInfoHex("Player", player);
 
   LOOKUP_DYN(load_state);
   if (read32(load_state) != 1) {
@@ -508,7 +508,7 @@ void FpsControls::run_mod_mp2_gc() {
   if (player == 0) {
     return;
   }
-  DevInfo("Player", "%08x", player);
+  DevInfoHex("Player", player);
 
   const bool show_crosshair = GetShowGCCrosshair();
   const u32 crosshair_color_rgba = show_crosshair ? GetGCCrosshairColor() : 0x4b7ea331;
@@ -677,7 +677,7 @@ void FpsControls::run_mod_mp3(Game active_game, Region active_region) {
   if (player == 0) {
     return;
   }
-  DevInfo("Player", "%08x", player);
+  DevInfoHex("Player", player);
 
   handle_beam_visor_switch({}, prime_three_visors);
 
@@ -100,7 +100,7 @@ void ViewModifier::run_mod_mp1() {
   adjust_viewmodel(fov, gun_pos, camera + 0x168, 0x3d200000);
   set_code_group_state("culling", (GetCulling() || GetFov() > 101.f) ? ModState::ENABLED : ModState::DISABLED);
 
-  DevInfo("camera", "%08X", camera);
+  DevInfoHex("camera", camera);
 }
 
 void ViewModifier::run_mod_mp1_gc() {
@@ -146,7 +146,7 @@ void ViewModifier::run_mod_mp1_gc() {
     0x3d200000);
 
   set_code_group_state("culling", (GetCulling() || GetFov() > 101.f) ? ModState::ENABLED : ModState::DISABLED);
-  DevInfo("camera", "%08X", camera);
+  DevInfoHex("camera", camera);
 }
 
 void ViewModifier::run_mod_mp2() {
@@ -179,7 +179,7 @@ void ViewModifier::run_mod_mp2() {
   adjust_viewmodel(fov, read32(read32(tweakgun)) + 0x4c, camera + 0x1c4, 0x3d200000);
 
   set_code_group_state("culling", (GetCulling() || GetFov() > 101.f) ? ModState::ENABLED : ModState::DISABLED);
-  DevInfo("camera", "%08X", camera);
+  DevInfoHex("camera", camera);
 }
 
 void ViewModifier::run_mod_mp2_gc() {
@@ -216,7 +216,7 @@ void ViewModifier::run_mod_mp2_gc() {
   adjust_viewmodel(fov, read32(read32(GPR(13) + tweakgun_offset)) + 0x50, camera + 0x1cc, 0x3d200000);
 
   set_code_group_state("culling", (GetCulling() || GetFov() > 101.f) ? ModState::ENABLED : ModState::DISABLED);
-  DevInfo("camera", "%08X", camera);
+  DevInfoHex("camera", camera);
 }
 
 void ViewModifier::run_mod_mp3() {
@@ -262,7 +262,7 @@ void ViewModifier::run_mod_mp3() {
   set_code_group_state("culling", (GetCulling() || GetFov() > 96.f) ? ModState::ENABLED : ModState::DISABLED);
   
   const u32 camera = read32(object_list + ((camera_id & 0x7ff) << 3) + 4);
-  DevInfo("camera", "%08X", camera);
+  DevInfoHex("camera", camera);
 }
 
 bool ViewModifier::init_mod(Game game, Region region) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/PrimeHack/PrimeMod.h"
+#include "Core/PrimeHack/DevTelemetry.h"
 #include "Core/PrimeHack/Transform.h"
 
 #include <cmath>
@@ -62,14 +63,9 @@ void set_beam_owned(int index, bool owned);
 void set_visor_owned(int index, bool owned);
 void set_cursor_pos(float x, float y);
 
-void DevInfo(const char* name, const char* format, ...);
-void DevInfoMatrix(const char* name, const Transform& t);
 std::tuple<u32, u32, u32, u32, u32, u32> GetCheatsTime();
 void AddCheatsTime(int index, u32 time);
 
-std::string GetDevInfo();
-void ClrDevInfo();
-
 // Borrowed from DolphinQt MathUtil.h
 template <typename T, typename F>
 constexpr auto Lerp(const T& x, const T& y, const F& a) -> decltype(x + (y - x) * a)
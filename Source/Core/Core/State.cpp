@@ -5,6 +5,7 @@
 #include "Core/State.h"
 
 #include <lzo/lzo1x.h>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
@@ -29,6 +30,7 @@
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
@@ -76,8 +78,23 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
+struct Snapshot
+{
+  std::vector<u8> data;
+  bool keyframe;
+};
+
+// Snapshots are restored by replaying everything since the closest keyframe, so this bounds both
+// the restore cost and how much has to be dropped at once when the buffer is full.
+static const size_t SNAPSHOT_KEYFRAME_INTERVAL = 16;
+static const size_t MAX_SNAPSHOTS = 64;
+
+static std::deque<Snapshot> s_snapshots;
+static size_t s_snapshots_since_keyframe = 0;
+static bool s_force_keyframe = true;
+
 // Don't forget to increase this after doing changes on the savestate system
-static const u32 STATE_VERSION = 94;  // Last changed in PR 6456
+static const u32 STATE_VERSION = 95;  // Last changed for incremental memory snapshots
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -211,6 +228,8 @@ void LoadFromBuffer(std::vector<u8>& buffer)
     return;
   }
 
+  ClearSnapshots();
+
   Core::RunAsCPUThread([&] {
     u8* ptr = &buffer[0];
     PointerWrap p(&ptr, PointerWrap::MODE_READ);
@@ -233,6 +252,99 @@ void SaveToBuffer(std::vector<u8>& buffer)
     DoState(p);
   });
 }
+void SaveSnapshot()
+{
+  prime::GetHackManager()->save_mod_states();
+  prime::GetHackManager()->revert_all_code_changes();
+
+  Core::RunAsCPUThread([&] {
+    const bool keyframe = s_force_keyframe || s_snapshots.empty() ||
+                          s_snapshots_since_keyframe + 1 >= SNAPSHOT_KEYFRAME_INTERVAL ||
+                          !Memory::IsDirtyTrackingSupported();
+
+    Snapshot snapshot;
+    snapshot.keyframe = keyframe;
+    Memory::SetIncrementalState(!keyframe);
+    SaveToBuffer(snapshot.data);
+    Memory::SetIncrementalState(false);
+
+    s_snapshots_since_keyframe = keyframe ? 0 : s_snapshots_since_keyframe + 1;
+    // If the dirty pages couldn't be reset, the next delta would miss writes made before now.
+    s_force_keyframe = !Memory::ResetDirtyPages();
+    s_snapshots.push_back(std::move(snapshot));
+
+    // Drop the oldest keyframe along with all the snapshots that depend on it.
+    if (s_snapshots.size() > MAX_SNAPSHOTS)
+    {
+      do
+      {
+        s_snapshots.pop_front();
+      } while (!s_snapshots.empty() && !s_snapshots.front().keyframe);
+    }
+  });
+
+  prime::GetHackManager()->restore_mod_states();
+}
+
+bool LoadLastSnapshot()
+{
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  bool found = false;
+  bool success = true;
+  Core::RunAsCPUThread([&] {
+    // The snapshots are only touched while the CPU thread is paused.
+    if (s_snapshots.empty())
+      return;
+    found = true;
+
+    prime::GetHackManager()->reset_mod("elf_mod_loader");
+
+    size_t first = s_snapshots.size() - 1;
+    while (first > 0 && !s_snapshots[first].keyframe)
+      --first;
+
+    for (size_t i = first; i < s_snapshots.size() && success; ++i)
+    {
+      u8* ptr = s_snapshots[i].data.data();
+      PointerWrap p(&ptr, PointerWrap::MODE_READ);
+      DoState(p);
+      success = p.GetMode() == PointerWrap::MODE_READ;
+    }
+
+    // Memory now matches the restored snapshot, but the one before it is older than that.
+    // The next snapshot has to be a keyframe to keep the chain consistent, whether or not the
+    // dirty pages could be reset.
+    if (success)
+      s_snapshots.pop_back();
+    else
+      ClearSnapshots();
+    s_force_keyframe = true;
+    Memory::ResetDirtyPages();
+
+    if (s_on_after_load_callback)
+      s_on_after_load_callback();
+  });
+
+  if (!found)
+    return false;
+
+  if (!success)
+    Core::DisplayMessage("Unable to load snapshot", 4000);
+  return success;
+}
+
+void ClearSnapshots()
+{
+  s_snapshots.clear();
+  s_snapshots_since_keyframe = 0;
+  s_force_keyframe = true;
+}
+
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
 {
@@ -539,6 +651,7 @@ void LoadAs(const std::string& filename)
   }
 
   prime::GetHackManager()->reset_mod("elf_mod_loader");
+  ClearSnapshots();
 
   Core::RunAsCPUThread([&] {
     g_loadDepth++;
@@ -631,6 +744,9 @@ void Shutdown()
     std::lock_guard<std::mutex> lk(g_cs_undo_load_buffer);
     std::vector<u8>().swap(g_undo_load_buffer);
   }
+
+  std::deque<Snapshot>().swap(s_snapshots);
+  ClearSnapshots();
 }
 
 static std::string MakeStateFilename(int number)
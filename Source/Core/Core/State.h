@@ -50,6 +50,14 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// In-memory snapshots for stepping back through recent gameplay, bound to the quick snapshot
+// hotkeys. Apart from periodic keyframes, a snapshot only stores the pages of emulated memory
+// that were written since the previous one.
+void SaveSnapshot();
+// Restores the most recent snapshot and removes it from the buffer.
+bool LoadLastSnapshot();
+void ClearSnapshots();
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
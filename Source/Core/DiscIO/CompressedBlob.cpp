@@ -8,22 +8,29 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cinttypes>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <zlib.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
+#include "Common/ForkJoinPool.h"
 #include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DiscScrubber.h"
@@ -32,6 +39,60 @@ namespace DiscIO
 {
 bool IsGCZBlob(File::IOFile& file);
 
+namespace
+{
+// Blocks are read, compressed and written in batches of this many blocks. The input file is read
+// one batch ahead on a separate thread while the current batch is compressed.
+constexpr u32 COMPRESS_BATCH_BLOCKS = 256;
+
+struct CompressBatch
+{
+  u32 first_block = 0;
+  u32 num_blocks = 0;
+  // Input file position before the batch was read, for the compression ratio.
+  u64 in_position = 0;
+  std::vector<u8> in;
+  std::vector<u8> out;
+  // Compressed size of each block, or 0 if the block is stored uncompressed.
+  std::vector<u32> out_sizes;
+};
+
+size_t GetWorkerThreadCount()
+{
+  return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+// All readers share these threads. The pool runs one batch at a time, so the mutex has to be
+// held while using it.
+Common::ForkJoinPool& GetDecompressionPool()
+{
+  static Common::ForkJoinPool pool(GetWorkerThreadCount(), "GCZ Decompressor");
+  return pool;
+}
+std::mutex s_decompression_pool_mutex;
+
+// Compresses one block into out, which must be block_size bytes. out_size is set to the compressed
+// size, or 0 if the block doesn't compress well enough and should be stored as-is. Returns false
+// if zlib fails.
+bool CompressBlock(z_stream* z, const u8* in, u8* out, u32 block_size, u32* out_size)
+{
+  if (deflateReset(z) != Z_OK)
+    return false;
+
+  z->next_in = const_cast<u8*>(in);
+  z->avail_in = block_size;
+  z->next_out = out;
+  z->avail_out = block_size;
+
+  int status = deflate(z, Z_FINISH);
+  if ((status != Z_STREAM_END) || (z->avail_out < 10))
+    *out_size = 0;
+  else
+    *out_size = block_size - z->avail_out;
+  return true;
+}
+}  // namespace
+
 CompressedBlobReader::CompressedBlobReader(File::IOFile file, const std::string& filename)
     : m_file(std::move(file)), m_file_name(filename)
 {
@@ -87,23 +148,71 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
 
 bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
+  if (block_num >= m_read_ahead_block && block_num - m_read_ahead_block < m_read_ahead_count)
+  {
+    const u8* block = &m_read_ahead_buffer[(block_num - m_read_ahead_block) * m_header.block_size];
+    std::copy(block, block + m_header.block_size, out_ptr);
+    m_next_block = block_num + 1;
+    return true;
+  }
 
-  if (offset & (1ULL << 63))
+  const bool sequential = block_num == m_next_block;
+  m_next_block = block_num + 1;
+  if (!sequential)
+    return ReadBlocks(block_num, 1, out_ptr);
+
+  // Sequential reads (e.g. streamed data or decompressing the whole image) fetch the following
+  // blocks with the same file read and decompress them in parallel. If a block's offset is
+  // invalid, the read-ahead stops before it and the block is read on its own.
+  const u64 num_blocks = std::max<u64>(
+      1, GetContiguousBlockCount(
+             block_num, std::min<u64>(READ_AHEAD_BLOCKS, m_header.num_blocks - block_num)));
+  m_read_ahead_count = 0;
+  m_read_ahead_buffer.resize(READ_AHEAD_BLOCKS * m_header.block_size);
+  if (!ReadBlocks(block_num, num_blocks, m_read_ahead_buffer.data()))
+    return false;
+  m_read_ahead_block = block_num;
+  m_read_ahead_count = num_blocks;
+  std::copy_n(m_read_ahead_buffer.begin(), m_header.block_size, out_ptr);
+  return true;
+}
+
+u64 CompressedBlobReader::GetContiguousBlockCount(u64 block_num, u64 max_blocks) const
+{
+  u64 end_offset = m_block_pointers[block_num] & ~(1ULL << 63);
+  for (u64 i = 0; i < max_blocks; ++i)
   {
-    if (comp_block_size != m_header.block_size)
-      PanicAlert("Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
+    const u64 offset = m_block_pointers[block_num + i] & ~(1ULL << 63);
+    const u32 comp_block_size = (u32)GetBlockCompressedSize(block_num + i);
+    if (offset != end_offset || comp_block_size > m_header.block_size)
+      return i;
+    end_offset = offset + comp_block_size;
   }
+  return max_blocks;
+}
 
-  // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
-  memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
+bool CompressedBlobReader::ReadBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  // Don't trust the offsets before checking them, a corrupt table could make the range underflow.
+  const u64 valid_blocks = GetContiguousBlockCount(block_num, num_blocks);
+  if (valid_blocks != num_blocks)
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.\nBlock %" PRIu64 " has an invalid offset.",
+                m_file_name.c_str(), block_num + valid_blocks);
+    return false;
+  }
 
-  m_file.Seek(offset, SEEK_SET);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  // The blocks are stored one after the other, so they can all be read at once.
+  const u64 first_offset = m_block_pointers[block_num] & ~(1ULL << 63);
+  const u64 last_block = block_num + num_blocks - 1;
+  const u64 end_offset =
+      (m_block_pointers[last_block] & ~(1ULL << 63)) + (u32)GetBlockCompressedSize(last_block);
+  const u64 size = end_offset - first_offset;
+  if (m_zlib_buffer.size() < size)
+    m_zlib_buffer.resize(size);
+
+  m_file.Seek(m_data_offset + first_offset, SEEK_SET);
+  if (!m_file.ReadBytes(m_zlib_buffer.data(), size))
   {
     PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
                 m_file_name.c_str());
@@ -111,8 +220,34 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  const auto decompress = [&](size_t i) {
+    const u64 block = block_num + i;
+    const u64 offset = (m_block_pointers[block] & ~(1ULL << 63)) - first_offset;
+    return DecompressBlock(block, &m_zlib_buffer[offset], (u32)GetBlockCompressedSize(block),
+                           &out_ptr[i * m_header.block_size]);
+  };
+
+  if (num_blocks == 1)
+    return decompress(0);
+
+  std::lock_guard<std::mutex> lock(s_decompression_pool_mutex);
+  std::atomic<bool> success{true};
+  GetDecompressionPool().Run(num_blocks, [&](size_t i, size_t) {
+    if (!decompress(i))
+      success = false;
+  });
+  return success;
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* data, u32 comp_block_size,
+                                           u8* out_ptr) const
+{
+  const bool uncompressed = (m_block_pointers[block_num] & (1ULL << 63)) != 0;
+  if (uncompressed && comp_block_size != m_header.block_size)
+    PanicAlert("Uncompressed block with wrong size");
+
   // First, check hash.
-  u32 block_hash = HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  u32 block_hash = HashAdler32(data, comp_block_size);
   if (block_hash != m_hashes[block_num])
     PanicAlertT("The disc image \"%s\" is corrupt.\n"
                 "Hash of block %" PRIu64 " is %08x instead of %08x.",
@@ -120,12 +255,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(data, data + comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = const_cast<u8*>(data);
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -193,9 +328,24 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     scrubbing = true;
   }
 
-  z_stream z = {};
-  if (deflateInit(&z, 9) != Z_OK)
+  // Every block is compressed on its own with the same settings, so which thread compresses it
+  // doesn't change the output.
+  Common::ForkJoinPool workers(GetWorkerThreadCount(), "GCZ Compressor");
+  std::vector<z_stream> streams(workers.GetWorkerCount());
+  size_t num_streams = 0;
+  for (z_stream& z : streams)
+  {
+    z = {};
+    if (deflateInit(&z, 9) != Z_OK)
+      break;
+    ++num_streams;
+  }
+  if (num_streams != streams.size())
+  {
+    for (size_t i = 0; i < num_streams; ++i)
+      deflateEnd(&streams[i]);
     return false;
+  }
 
   callback(GetStringT("Files opened, ready to compress."), 0, arg);
 
@@ -210,8 +360,6 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
 
   std::vector<u64> offsets(header.num_blocks);
   std::vector<u32> hashes(header.num_blocks);
-  std::vector<u8> out_buf(block_size);
-  std::vector<u8> in_buf(block_size);
 
   // seek past the header (we will write it at the end)
   outfile.Seek(sizeof(CompressedBlobHeader), SEEK_CUR);
@@ -220,93 +368,143 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   // seek to the start of the input file to make sure we get everything
   infile.Seek(0, SEEK_SET);
 
+  std::array<CompressBatch, 2> batches;
+  for (CompressBatch& batch : batches)
+  {
+    batch.in.resize(static_cast<size_t>(block_size) * COMPRESS_BATCH_BLOCKS);
+    batch.out.resize(static_cast<size_t>(block_size) * COMPRESS_BATCH_BLOCKS);
+    batch.out_sizes.resize(COMPRESS_BATCH_BLOCKS);
+  }
+  std::array<Common::Event, 2> batch_free;
+  std::array<Common::Event, 2> batch_read;
+  std::atomic<bool> stop_reading{false};
+  const u32 num_batches = (header.num_blocks + COMPRESS_BATCH_BLOCKS - 1) / COMPRESS_BATCH_BLOCKS;
+
+  std::thread reader([&] {
+    Common::SetCurrentThreadName("GCZ Reader");
+    for (u32 batch_index = 0; batch_index < num_batches; ++batch_index)
+    {
+      batch_free[batch_index % 2].Wait();
+      if (stop_reading)
+        return;
+
+      CompressBatch& batch = batches[batch_index % 2];
+      batch.first_block = batch_index * COMPRESS_BATCH_BLOCKS;
+      batch.num_blocks = std::min(COMPRESS_BATCH_BLOCKS, header.num_blocks - batch.first_block);
+      batch.in_position = infile.Tell();
+      for (u32 i = 0; i < batch.num_blocks; ++i)
+      {
+        u8* in_buf = &batch.in[static_cast<size_t>(i) * block_size];
+        size_t read_bytes;
+        if (scrubbing)
+          read_bytes = disc_scrubber.GetNextBlock(infile, in_buf);
+        else
+          infile.ReadArray(in_buf, header.block_size, &read_bytes);
+        if (read_bytes < header.block_size)
+          std::fill(in_buf + read_bytes, in_buf + header.block_size, 0);
+      }
+
+      batch_read[batch_index % 2].Set();
+    }
+  });
+  batch_free[0].Set();
+  batch_free[1].Set();
+
   // Now we are ready to write compressed data!
   u64 position = 0;
   int num_compressed = 0;
   int num_stored = 0;
   int progress_monitor = std::max<int>(1, header.num_blocks / 1000);
+  u32 next_progress_block = 0;
   bool success = true;
 
-  for (u32 i = 0; i < header.num_blocks; i++)
+  for (u32 batch_index = 0; batch_index < num_batches && success; ++batch_index)
   {
-    if (i % progress_monitor == 0)
+    batch_read[batch_index % 2].Wait();
+    CompressBatch& batch = batches[batch_index % 2];
+
+    if (batch.first_block >= next_progress_block)
     {
-      const u64 inpos = infile.Tell();
       int ratio = 0;
-      if (inpos != 0)
-        ratio = (int)(100 * position / inpos);
+      if (batch.in_position != 0)
+        ratio = (int)(100 * position / batch.in_position);
 
       std::string temp =
-          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), i,
-                           header.num_blocks, ratio);
-      bool was_cancelled = !callback(temp, (float)i / (float)header.num_blocks, arg);
+          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(),
+                           batch.first_block, header.num_blocks, ratio);
+      bool was_cancelled =
+          !callback(temp, (float)batch.first_block / (float)header.num_blocks, arg);
       if (was_cancelled)
       {
         success = false;
         break;
       }
+      next_progress_block = batch.first_block + progress_monitor;
     }
 
-    offsets[i] = position;
-
-    size_t read_bytes;
-    if (scrubbing)
-      read_bytes = disc_scrubber.GetNextBlock(infile, in_buf.data());
-    else
-      infile.ReadArray(in_buf.data(), header.block_size, &read_bytes);
-    if (read_bytes < header.block_size)
-      std::fill(in_buf.begin() + read_bytes, in_buf.begin() + header.block_size, 0);
-
-    int retval = deflateReset(&z);
-    z.next_in = in_buf.data();
-    z.avail_in = header.block_size;
-    z.next_out = out_buf.data();
-    z.avail_out = block_size;
-
-    if (retval != Z_OK)
+    std::atomic<bool> deflate_failed{false};
+    workers.Run(batch.num_blocks, [&](size_t i, size_t worker) {
+      const size_t buffer_offset = i * block_size;
+      if (!CompressBlock(&streams[worker], &batch.in[buffer_offset], &batch.out[buffer_offset],
+                         block_size, &batch.out_sizes[i]))
+      {
+        deflate_failed = true;
+      }
+    });
+    if (deflate_failed)
     {
       ERROR_LOG(DISCIO, "Deflate failed");
       success = false;
       break;
     }
 
-    int status = deflate(&z, Z_FINISH);
-    int comp_size = block_size - z.avail_out;
-
-    u8* write_buf;
-    int write_size;
-    if ((status != Z_STREAM_END) || (z.avail_out < 10))
-    {
-      // PanicAlert("%i %i Store %i", i*block_size, position, comp_size);
-      // let's store uncompressed
-      write_buf = in_buf.data();
-      offsets[i] |= 0x8000000000000000ULL;
-      write_size = block_size;
-      num_stored++;
-    }
-    else
+    // Written in block order, so the output is the same as compressing on a single thread.
+    for (u32 i = 0; i < batch.num_blocks; ++i)
     {
-      // let's store compressed
-      // PanicAlert("Comp %i to %i", block_size, comp_size);
-      write_buf = out_buf.data();
-      write_size = comp_size;
-      num_compressed++;
-    }
+      const u32 block = batch.first_block + i;
+      const size_t buffer_offset = static_cast<size_t>(i) * block_size;
+      offsets[block] = position;
 
-    if (!outfile.WriteBytes(write_buf, write_size))
-    {
-      PanicAlertT("Failed to write the output file \"%s\".\n"
-                  "Check that you have enough space available on the target drive.",
-                  outfile_path.c_str());
-      success = false;
-      break;
-    }
+      const u8* write_buf;
+      int write_size;
+      if (batch.out_sizes[i] == 0)
+      {
+        // let's store uncompressed
+        write_buf = &batch.in[buffer_offset];
+        offsets[block] |= 0x8000000000000000ULL;
+        write_size = block_size;
+        num_stored++;
+      }
+      else
+      {
+        // let's store compressed
+        write_buf = &batch.out[buffer_offset];
+        write_size = batch.out_sizes[i];
+        num_compressed++;
+      }
+
+      if (!outfile.WriteBytes(write_buf, write_size))
+      {
+        PanicAlertT("Failed to write the output file \"%s\".\n"
+                    "Check that you have enough space available on the target drive.",
+                    outfile_path.c_str());
+        success = false;
+        break;
+      }
 
-    position += write_size;
+      position += write_size;
 
-    hashes[i] = HashAdler32(write_buf, write_size);
+      hashes[block] = HashAdler32(write_buf, write_size);
+    }
+
+    batch_free[batch_index % 2].Set();
   }
 
+  stop_reading = true;
+  batch_free[0].Set();
+  batch_free[1].Set();
+  reader.join();
+
   header.compressed_data_size = position;
 
   if (!success)
@@ -325,7 +523,8 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   }
 
   // Cleanup
-  deflateEnd(&z);
+  for (z_stream& z : streams)
+    deflateEnd(&z);
 
   if (success)
   {
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -55,8 +56,20 @@ public:
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
 private:
+  // Number of blocks fetched at once when the blocks are read in order.
+  static constexpr u64 READ_AHEAD_BLOCKS = 32;
+
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  // How many of the max_blocks blocks starting at block_num are stored one after the other,
+  // which a valid image always does.
+  u64 GetContiguousBlockCount(u64 block_num, u64 max_blocks) const;
+  // Reads num_blocks consecutive blocks with a single file read and decompresses them, on the
+  // worker threads if there is more than one. Fails if they aren't stored contiguously.
+  bool ReadBlocks(u64 block_num, u64 num_blocks, u8* out_ptr);
+  // Thread-safe.
+  bool DecompressBlock(u64 block_num, const u8* data, u32 comp_block_size, u8* out_ptr) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -65,6 +78,11 @@ private:
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
   std::string m_file_name;
+
+  std::vector<u8> m_read_ahead_buffer;
+  u64 m_read_ahead_block = 0;
+  u64 m_read_ahead_count = 0;
+  u64 m_next_block = std::numeric_limits<u64>::max();
 };
 
 }  // namespace
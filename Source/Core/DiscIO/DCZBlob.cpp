@@ -0,0 +1,581 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/DCZBlob.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <xxhash.h>
+#include <zlib.h>
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/ForkJoinPool.h"
+#include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscScrubber.h"
+
+namespace DiscIO
+{
+namespace
+{
+// Chunks are converted in batches of about this many bytes.
+constexpr u32 CONVERT_BATCH_SIZE = 16 * 1024 * 1024;
+// The size of the clusters that DiscScrubber works with.
+constexpr u32 SCRUB_CLUSTER_SIZE = 0x8000;
+
+bool IgnoreProgress(const std::string&, float, void*)
+{
+  return true;
+}
+
+bool IsValidChunkSize(u32 chunk_size)
+{
+  return chunk_size >= DCZ_MIN_CHUNK_SIZE && chunk_size <= DCZ_MAX_CHUNK_SIZE &&
+         MathUtil::IsPow2(chunk_size);
+}
+
+bool DecompressChunk(DCZCodec codec, const u8* in, u32 in_size, u8* out, u32 out_size)
+{
+  switch (codec)
+  {
+  case DCZCodec::Deflate:
+  {
+    z_stream z = {};
+    z.next_in = const_cast<u8*>(in);
+    z.avail_in = in_size;
+    z.next_out = out;
+    z.avail_out = out_size;
+    if (inflateInit(&z) != Z_OK)
+      return false;
+    const int status = inflate(&z, Z_FINISH);
+    inflateEnd(&z);
+    return status == Z_STREAM_END && z.avail_out == 0;
+  }
+#ifdef HAVE_LZMA
+  case DCZCodec::LZMA:
+  {
+    u64 memlimit = UINT64_MAX;
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+    const lzma_ret status =
+        lzma_stream_buffer_decode(&memlimit, 0, nullptr, in, &in_pos, in_size, out, &out_pos,
+                                  out_size);
+    return status == LZMA_OK && out_pos == out_size;
+  }
+#endif
+  default:
+    return false;
+  }
+}
+
+// Compresses in into out (which must be chunk_size bytes) and returns the compressed size, or
+// 0 if the chunk should be stored uncompressed. z is only used for Deflate.
+u32 CompressChunk(DCZCodec codec, z_stream* z, const u8* in, u8* out, u32 chunk_size)
+{
+  // Like GCZ, store chunks that won't get meaningfully smaller as-is.
+  const u32 max_size = chunk_size - chunk_size / 32;
+
+  switch (codec)
+  {
+  case DCZCodec::Deflate:
+  {
+    if (deflateReset(z) != Z_OK)
+      return 0;
+    z->next_in = const_cast<u8*>(in);
+    z->avail_in = chunk_size;
+    z->next_out = out;
+    z->avail_out = max_size;
+    if (deflate(z, Z_FINISH) != Z_STREAM_END)
+      return 0;
+    return max_size - z->avail_out;
+  }
+#ifdef HAVE_LZMA
+  case DCZCodec::LZMA:
+  {
+    size_t out_pos = 0;
+    if (lzma_easy_buffer_encode(LZMA_PRESET_DEFAULT, LZMA_CHECK_NONE, nullptr, in, chunk_size,
+                                out, &out_pos, max_size) != LZMA_OK)
+    {
+      return 0;
+    }
+    return static_cast<u32>(out_pos);
+  }
+#endif
+  default:
+    return 0;
+  }
+}
+
+const char* GetCodecName(DCZCodec codec)
+{
+  switch (codec)
+  {
+  case DCZCodec::None:
+    return "none";
+  case DCZCodec::Deflate:
+    return "Deflate";
+  case DCZCodec::LZMA:
+    return "LZMA";
+  default:
+    return "unknown";
+  }
+}
+}  // namespace
+
+bool IsDCZCodecSupported(DCZCodec codec)
+{
+  switch (codec)
+  {
+  case DCZCodec::None:
+  case DCZCodec::Deflate:
+    return true;
+#ifdef HAVE_LZMA
+  case DCZCodec::LZMA:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+DCZFileReader::DCZFileReader(File::IOFile file, const std::string& path, const DCZHeader& header,
+                             std::vector<DCZChunkEntry> entries)
+    : m_file(std::move(file)), m_path(path), m_header(header), m_entries(std::move(entries))
+{
+  m_file_size = m_file.GetSize();
+  m_stored_buffer.resize(m_header.chunk_size);
+  m_last_chunk.resize(m_header.chunk_size);
+  SetSectorSize(m_header.chunk_size);
+}
+
+std::unique_ptr<DCZFileReader> DCZFileReader::Create(File::IOFile file, const std::string& path)
+{
+  DCZHeader header;
+  if (!file.Seek(0, SEEK_SET) || !file.ReadArray(&header, 1) ||
+      header.magic_cookie != DCZ_MAGIC)
+  {
+    return nullptr;
+  }
+
+  if (header.version != DCZ_VERSION || !IsValidChunkSize(header.chunk_size) ||
+      header.num_chunks != (header.data_size + header.chunk_size - 1) / header.chunk_size)
+  {
+    ERROR_LOG(DISCIO, "%s is not a valid DCZ image (version %u)", path.c_str(), header.version);
+    return nullptr;
+  }
+
+  if (!IsDCZCodecSupported(static_cast<DCZCodec>(header.codec)))
+  {
+    PanicAlertT("The disc image \"%s\" is compressed with %s, which this build of Dolphin "
+                "doesn't support.",
+                path.c_str(), GetCodecName(static_cast<DCZCodec>(header.codec)));
+    return nullptr;
+  }
+
+  // The header isn't trusted yet, don't allocate a table that the file can't contain.
+  const u64 file_size = file.GetSize();
+  if (sizeof(DCZHeader) + static_cast<u64>(header.num_chunks) * sizeof(DCZChunkEntry) >
+      file_size)
+  {
+    ERROR_LOG(DISCIO, "%s is truncated", path.c_str());
+    return nullptr;
+  }
+
+  std::vector<DCZChunkEntry> entries(header.num_chunks);
+  if (!file.ReadArray(entries.data(), entries.size()))
+    return nullptr;
+
+  for (const DCZChunkEntry& entry : entries)
+  {
+    const bool uncompressed = (entry.flags & DCZ_CHUNK_UNCOMPRESSED) != 0;
+    if (entry.offset == 0 || entry.stored_size > header.chunk_size ||
+        (uncompressed && entry.stored_size != header.chunk_size) || entry.offset > file_size ||
+        entry.stored_size > file_size - entry.offset)
+    {
+      ERROR_LOG(DISCIO, "%s has an invalid chunk table", path.c_str());
+      return nullptr;
+    }
+  }
+
+  return std::unique_ptr<DCZFileReader>(
+      new DCZFileReader(std::move(file), path, header, std::move(entries)));
+}
+
+bool DCZFileReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  if (block_num >= m_entries.size())
+    return false;
+
+  const DCZChunkEntry& entry = m_entries[block_num];
+  if (entry.offset == m_last_chunk_offset)
+  {
+    std::copy(m_last_chunk.begin(), m_last_chunk.end(), out_ptr);
+    return true;
+  }
+
+  const bool uncompressed = (entry.flags & DCZ_CHUNK_UNCOMPRESSED) != 0;
+  u8* stored = uncompressed ? out_ptr : m_stored_buffer.data();
+  if (!m_file.Seek(entry.offset, SEEK_SET) || !m_file.ReadBytes(stored, entry.stored_size))
+  {
+    PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
+                m_path.c_str());
+    m_file.Clear();
+    return false;
+  }
+
+  if (!uncompressed && !DecompressChunk(static_cast<DCZCodec>(m_header.codec), stored,
+                                        entry.stored_size, out_ptr, m_header.chunk_size))
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.\nChunk %" PRIu64 " could not be decompressed.",
+                m_path.c_str(), block_num);
+    return false;
+  }
+
+  if (XXH64(out_ptr, m_header.chunk_size, 0) != entry.hash)
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.\nChunk %" PRIu64 " has the wrong hash.",
+                m_path.c_str(), block_num);
+  }
+
+  std::copy(out_ptr, out_ptr + m_header.chunk_size, m_last_chunk.begin());
+  m_last_chunk_offset = entry.offset;
+  return true;
+}
+
+namespace
+{
+class DCZConverter
+{
+public:
+  DCZConverter(std::unique_ptr<BlobReader> reader, DCZCodec codec, u32 chunk_size)
+      : m_reader(std::move(reader)), m_codec(codec), m_chunk_size(chunk_size),
+        m_workers(std::max(std::thread::hardware_concurrency(), 2u) - 1, "DCZ Compressor")
+  {
+    // If a stream fails to initialize, deflateReset fails for it as well and the chunks it gets
+    // are simply stored uncompressed.
+    m_streams.resize(m_workers.GetWorkerCount());
+    for (z_stream& z : m_streams)
+    {
+      z = {};
+      if (m_codec == DCZCodec::Deflate)
+        deflateInit(&z, 9);
+    }
+  }
+
+  ~DCZConverter()
+  {
+    if (m_codec == DCZCodec::Deflate)
+    {
+      for (z_stream& z : m_streams)
+        deflateEnd(&z);
+    }
+  }
+
+  bool Convert(File::IOFile& outfile, const std::string& outfile_path, bool scrub,
+               const std::string& infile_path, CompressCB callback, void* arg);
+
+private:
+  bool ReadChunks(u64 first_chunk, u32 num_chunks, u8* out);
+  bool IsDuplicate(u32 chunk, const u8* data, u32 first_in_batch, const u8* batch_data);
+
+  std::unique_ptr<BlobReader> m_reader;
+  DCZCodec m_codec;
+  u32 m_chunk_size;
+  DiscScrubber m_scrubber;
+  bool m_scrubbing = false;
+
+  Common::ForkJoinPool m_workers;
+  std::vector<z_stream> m_streams;
+
+  // Maps the hash of a chunk to the first chunk that had it.
+  std::unordered_map<u64, u32> m_chunks_by_hash;
+  // An earlier chunk that was read back to compare against; usually the chunk of zeroes.
+  std::vector<u8> m_compare_buffer;
+  u32 m_compare_chunk = UINT32_MAX;
+};
+
+bool DCZConverter::ReadChunks(u64 first_chunk, u32 num_chunks, u8* out)
+{
+  const u64 offset = first_chunk * m_chunk_size;
+  const u64 size = static_cast<u64>(num_chunks) * m_chunk_size;
+  const u64 available = std::min(size, m_reader->GetDataSize() - offset);
+  if (!m_reader->Read(offset, available, out))
+    return false;
+  std::fill(out + available, out + size, 0);
+
+  if (m_scrubbing)
+  {
+    for (u64 cluster = 0; cluster < available; cluster += SCRUB_CLUSTER_SIZE)
+    {
+      if (m_scrubber.CanBlockBeScrubbed(offset + cluster))
+        std::fill_n(out + cluster, SCRUB_CLUSTER_SIZE, 0);
+    }
+  }
+  return true;
+}
+
+// Hashes are only used to find candidates; the data is always compared before a chunk is
+// treated as a duplicate.
+bool DCZConverter::IsDuplicate(u32 chunk, const u8* data, u32 first_in_batch,
+                               const u8* batch_data)
+{
+  const u8* other;
+  if (chunk >= first_in_batch)
+  {
+    other = batch_data + static_cast<size_t>(chunk - first_in_batch) * m_chunk_size;
+  }
+  else
+  {
+    if (m_compare_chunk != chunk)
+    {
+      m_compare_buffer.resize(m_chunk_size);
+      if (!ReadChunks(chunk, 1, m_compare_buffer.data()))
+        return false;
+      m_compare_chunk = chunk;
+    }
+    other = m_compare_buffer.data();
+  }
+  return std::memcmp(data, other, m_chunk_size) == 0;
+}
+
+bool DCZConverter::Convert(File::IOFile& outfile, const std::string& outfile_path, bool scrub,
+                           const std::string& infile_path, CompressCB callback, void* arg)
+{
+  if (scrub)
+  {
+    m_scrubbing = m_scrubber.SetupScrub(infile_path, SCRUB_CLUSTER_SIZE);
+    if (!m_scrubbing)
+    {
+      PanicAlertT("\"%s\" failed to be scrubbed. Probably the image is corrupt.",
+                  infile_path.c_str());
+      return false;
+    }
+  }
+
+  callback(GetStringT("Files opened, ready to compress."), 0, arg);
+
+  DCZHeader header = {};
+  header.magic_cookie = DCZ_MAGIC;
+  header.version = DCZ_VERSION;
+  header.codec = static_cast<u32>(m_codec);
+  header.chunk_size = m_chunk_size;
+  header.data_size = m_reader->GetDataSize();
+  header.num_chunks = static_cast<u32>((header.data_size + m_chunk_size - 1) / m_chunk_size);
+
+  std::vector<DCZChunkEntry> entries(header.num_chunks);
+  u64 position = sizeof(DCZHeader) + sizeof(DCZChunkEntry) * entries.size();
+  // Skip the header and the chunk table, they are written at the end.
+  if (!outfile.Seek(position, SEEK_SET))
+    return false;
+
+  const u32 batch_chunks = std::max<u32>(1, CONVERT_BATCH_SIZE / m_chunk_size);
+  std::vector<u8> in(static_cast<size_t>(batch_chunks) * m_chunk_size);
+  std::vector<u8> out(in.size());
+  std::vector<u32> out_sizes(batch_chunks);
+  // For each chunk of the batch: the chunk it duplicates, or itself if it has to be stored.
+  std::vector<u32> sources(batch_chunks);
+  std::vector<u32> stored;
+  stored.reserve(batch_chunks);
+
+  for (u32 first = 0; first < header.num_chunks; first += batch_chunks)
+  {
+    const u32 num_chunks = std::min(batch_chunks, header.num_chunks - first);
+
+    int ratio = 0;
+    if (first != 0)
+      ratio = (int)(100 * position / (static_cast<u64>(first) * m_chunk_size));
+    const std::string text =
+        StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), first,
+                         header.num_chunks, ratio);
+    if (!callback(text, (float)first / (float)header.num_chunks, arg))
+      return false;
+
+    if (!ReadChunks(first, num_chunks, in.data()))
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      return false;
+    }
+
+    m_workers.Run(num_chunks, [&](size_t i, size_t) {
+      entries[first + i].hash = XXH64(&in[i * m_chunk_size], m_chunk_size, 0);
+    });
+
+    stored.clear();
+    for (u32 i = 0; i < num_chunks; ++i)
+    {
+      const u32 chunk = first + i;
+      const u8* data = &in[static_cast<size_t>(i) * m_chunk_size];
+      const auto it = m_chunks_by_hash.find(entries[chunk].hash);
+      if (it != m_chunks_by_hash.end() && IsDuplicate(it->second, data, first, in.data()))
+      {
+        sources[i] = it->second;
+        continue;
+      }
+
+      if (it == m_chunks_by_hash.end())
+        m_chunks_by_hash.emplace(entries[chunk].hash, chunk);
+      sources[i] = chunk;
+      stored.push_back(i);
+    }
+
+    m_workers.Run(stored.size(), [&](size_t task, size_t worker) {
+      const size_t offset = static_cast<size_t>(stored[task]) * m_chunk_size;
+      out_sizes[stored[task]] =
+          CompressChunk(m_codec, &m_streams[worker], &in[offset], &out[offset], m_chunk_size);
+    });
+
+    // Written in chunk order, so the output doesn't depend on the number of threads.
+    for (u32 i = 0; i < num_chunks; ++i)
+    {
+      DCZChunkEntry& entry = entries[first + i];
+      if (sources[i] != first + i)
+      {
+        const u64 hash = entry.hash;
+        entry = entries[sources[i]];
+        entry.hash = hash;
+        continue;
+      }
+
+      const size_t offset = static_cast<size_t>(i) * m_chunk_size;
+      const u8* data = out_sizes[i] ? &out[offset] : &in[offset];
+      entry.offset = position;
+      entry.stored_size = out_sizes[i] ? out_sizes[i] : m_chunk_size;
+      entry.flags = out_sizes[i] ? 0 : DCZ_CHUNK_UNCOMPRESSED;
+      if (!outfile.WriteBytes(data, entry.stored_size))
+      {
+        PanicAlertT("Failed to write the output file \"%s\".\n"
+                    "Check that you have enough space available on the target drive.",
+                    outfile_path.c_str());
+        return false;
+      }
+      position += entry.stored_size;
+    }
+  }
+
+  if (!outfile.Seek(0, SEEK_SET) || !outfile.WriteArray(&header, 1) ||
+      !outfile.WriteArray(entries.data(), entries.size()))
+  {
+    PanicAlertT("Failed to write the output file \"%s\".\n"
+                "Check that you have enough space available on the target drive.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  callback(GetStringT("Done compressing disc image."), 1.0f, arg);
+  return true;
+}
+}  // namespace
+
+bool ConvertToDCZ(const std::string& infile_path, const std::string& outfile_path,
+                  DCZCodec codec, u32 chunk_size, bool scrub, CompressCB callback, void* arg)
+{
+  if (!IsValidChunkSize(chunk_size) || !IsDCZCodecSupported(codec))
+    return false;
+  if (!callback)
+    callback = IgnoreProgress;
+
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  DCZConverter converter(std::move(reader), codec, chunk_size);
+  if (!converter.Convert(outfile, outfile_path, scrub, infile_path, callback, arg))
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+  return true;
+}
+
+bool DecompressDCZToFile(const std::string& infile_path, const std::string& outfile_path,
+                         CompressCB callback, void* arg)
+{
+  if (!callback)
+    callback = IgnoreProgress;
+
+  std::unique_ptr<DCZFileReader> reader =
+      DCZFileReader::Create(File::IOFile(infile_path, "rb"), infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  const u64 data_size = reader->GetDataSize();
+  std::vector<u8> buffer(CONVERT_BATCH_SIZE);
+  bool success = true;
+  for (u64 position = 0; position < data_size; position += buffer.size())
+  {
+    if (!callback(GetStringT("Unpacking"), (float)position / (float)data_size, arg))
+    {
+      success = false;
+      break;
+    }
+
+    const size_t size = static_cast<size_t>(std::min<u64>(buffer.size(), data_size - position));
+    if (!reader->Read(position, size, buffer.data()))
+    {
+      success = false;
+      break;
+    }
+    if (!outfile.WriteBytes(buffer.data(), size))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      success = false;
+      break;
+    }
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  callback(GetStringT("Done decompressing disc image."), 1.0f, arg);
+  return true;
+}
+}  // namespace DiscIO
@@ -0,0 +1,115 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// WARNING Code not big-endian safe.
+
+// DCZ is a compressed disc image format that, unlike GCZ, can use larger chunks, better codecs
+// than zlib and stores identical chunks only once. To create DCZ images, use ConvertToDCZ.
+
+// File format
+// * Header
+// * [Chunk entries, one per chunk of the disc]
+// * [Stored chunk data]
+//
+// Identical chunks (e.g. padding, or files that a game has on the disc more than once) share
+// the same stored data; their entries simply point to the same place. Every chunk has its own
+// entry, so finding the data for any offset is a single lookup.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 DCZ_MAGIC = 0x1A5A4344;  // "DCZ\x1A"
+static constexpr u32 DCZ_VERSION = 1;
+
+static constexpr u32 DCZ_MIN_CHUNK_SIZE = 0x8000;
+static constexpr u32 DCZ_MAX_CHUNK_SIZE = 0x200000;
+// Every read decompresses a whole chunk, so small chunks keep random reads (which is what the
+// emulated drive mostly does) fast. 32 KiB reads about as fast as GCZ, while larger chunks only
+// shrink images by well under 1%.
+static constexpr u32 DCZ_DEFAULT_CHUNK_SIZE = 0x8000;
+
+enum class DCZCodec : u32
+{
+  None = 0,
+  Deflate = 1,
+  // Only available if Dolphin was built with liblzma (HAVE_LZMA).
+  LZMA = 2,
+};
+
+struct DCZHeader  // 32 bytes
+{
+  u32 magic_cookie;
+  u32 version;
+  u32 codec;
+  u32 chunk_size;
+  u64 data_size;
+  u32 num_chunks;
+  u32 reserved;
+};
+
+enum DCZChunkFlags : u32
+{
+  // The chunk didn't compress well and is stored as-is.
+  DCZ_CHUNK_UNCOMPRESSED = 1,
+};
+
+struct DCZChunkEntry  // 24 bytes
+{
+  // Offset of the stored data from the start of the file.
+  u64 offset;
+  u32 stored_size;
+  u32 flags;
+  // XXH64 of the decompressed chunk.
+  u64 hash;
+};
+
+class DCZFileReader : public SectorReader
+{
+public:
+  static std::unique_ptr<DCZFileReader> Create(File::IOFile file, const std::string& path);
+
+  BlobType GetBlobType() const override { return BlobType::DCZ; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  u64 GetRawSize() const override { return m_file_size; }
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+
+  const DCZHeader& GetHeader() const { return m_header; }
+
+private:
+  DCZFileReader(File::IOFile file, const std::string& path, const DCZHeader& header,
+                std::vector<DCZChunkEntry> entries);
+
+  File::IOFile m_file;
+  std::string m_path;
+  u64 m_file_size;
+  DCZHeader m_header;
+  std::vector<DCZChunkEntry> m_entries;
+  std::vector<u8> m_stored_buffer;
+
+  // The last chunk that was decompressed. Runs of identical chunks (mostly padding) share their
+  // stored data, so they only need to be decompressed once.
+  u64 m_last_chunk_offset = 0;
+  std::vector<u8> m_last_chunk;
+};
+
+bool IsDCZCodecSupported(DCZCodec codec);
+
+// Converts any disc image that CreateBlobReader can open. chunk_size must be a power of two
+// between DCZ_MIN_CHUNK_SIZE and DCZ_MAX_CHUNK_SIZE. If scrub is set, unused clusters of Wii
+// discs are replaced with zeroes, which makes them compress (and deduplicate) very well.
+bool ConvertToDCZ(const std::string& infile_path, const std::string& outfile_path,
+                  DCZCodec codec, u32 chunk_size, bool scrub, CompressCB callback = nullptr,
+                  void* arg = nullptr);
+bool DecompressDCZToFile(const std::string& infile_path, const std::string& outfile_path,
+                         CompressCB callback = nullptr, void* arg = nullptr);
+}  // namespace DiscIO
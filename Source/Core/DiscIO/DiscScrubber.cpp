@@ -92,6 +92,12 @@ size_t DiscScrubber::GetNextBlock(File::IOFile& in, u8* buffer)
   return read_bytes;
 }
 
+bool DiscScrubber::CanBlockBeScrubbed(u64 offset) const
+{
+  const u64 cluster = offset / CLUSTER_SIZE;
+  return m_is_scrubbing && cluster < m_free_table.size() && m_free_table[cluster];
+}
+
 void DiscScrubber::MarkAsUsed(u64 offset, u64 size)
 {
   u64 current_offset = offset;
@@ -37,6 +37,8 @@ public:
 
   bool SetupScrub(const std::string& filename, int block_size);
   size_t GetNextBlock(File::IOFile& in, u8* buffer);
+  // Whether the block at the given offset is unused and can be replaced with zeroes.
+  bool CanBlockBeScrubbed(u64 offset) const;
 
 private:
   struct PartitionHeader final
@@ -13,6 +13,7 @@
 #include "Core/ConfigManager.h"
 #include "DolphinQt2/Config/Graphics/GraphicsBool.h"
 #include "DolphinQt2/Config/Graphics/GraphicsSlider.h"
+#include "DolphinQt2/Config/Graphics/GraphicsWindow.h"
 #include "VideoCommon/VideoConfig.h"
 
 HacksWidget::HacksWidget(GraphicsWindow* parent) : GraphicsWidget(parent)
@@ -21,6 +22,9 @@ HacksWidget::HacksWidget(GraphicsWindow* parent) : GraphicsWidget(parent)
   LoadSettings();
   ConnectWidgets();
   AddDescriptions();
+
+  connect(parent, &GraphicsWindow::BackendChanged, this, &HacksWidget::OnBackendChanged);
+  OnBackendChanged();
 }
 
 void HacksWidget::CreateWidgets()
@@ -37,10 +41,13 @@ void HacksWidget::CreateWidgets()
                                              Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES, true);
   m_store_efb_copies = new GraphicsBool(tr("Store EFB Copies to Texture Only"),
                                         Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  m_defer_efb_copies =
+      new GraphicsBool(tr("Defer EFB Copies to RAM"), Config::GFX_HACK_DEFER_EFB_COPIES);
 
   efb_layout->addWidget(m_skip_efb_cpu, 0, 0);
   efb_layout->addWidget(m_ignore_format_changes, 0, 1);
   efb_layout->addWidget(m_store_efb_copies, 1, 0);
+  efb_layout->addWidget(m_defer_efb_copies, 1, 1);
 
   // Texture Cache
   auto* texture_cache_box = new QGroupBox(tr("Texture Cache"));
@@ -151,6 +158,11 @@ void HacksWidget::SaveSettings()
   }
 }
 
+void HacksWidget::OnBackendChanged()
+{
+  m_defer_efb_copies->setEnabled(g_Config.backend_info.bSupportsDeferredEFBCopies);
+}
+
 void HacksWidget::AddDescriptions()
 {
   static const char* TR_SKIP_EFB_CPU_ACCESS_DESCRIPTION =
@@ -166,6 +178,10 @@ void HacksWidget::AddDescriptions()
       "in a small number of games.\n\nEnabled = EFB Copies to Texture\nDisabled = EFB Copies to "
       "RAM "
       "(and Texture)\n\nIf unsure, leave this checked.");
+  static const char* TR_DEFER_EFB_COPIES_DESCRIPTION = QT_TR_NOOP(
+      "When EFB Copies to RAM are used, only writes them to system memory once a texture or the "
+      "CPU reads that memory. Copies nobody reads back never wait for the GPU.\n\nOnly supported "
+      "by the OpenGL backend.\n\nIf unsure, leave this unchecked.");
   static const char* TR_ACCUARCY_DESCRIPTION = QT_TR_NOOP(
       "The \"Safe\" setting eliminates the likelihood of the GPU missing texture updates "
       "from RAM.\nLower accuracies cause in-game text to appear garbled in certain "
@@ -204,6 +220,7 @@ void HacksWidget::AddDescriptions()
   AddDescription(m_skip_efb_cpu, TR_SKIP_EFB_CPU_ACCESS_DESCRIPTION);
   AddDescription(m_ignore_format_changes, TR_IGNORE_FORMAT_CHANGE_DESCRIPTION);
   AddDescription(m_store_efb_copies, TR_STORE_EFB_TO_TEXTURE_DESCRIPTION);
+  AddDescription(m_defer_efb_copies, TR_DEFER_EFB_COPIES_DESCRIPTION);
   AddDescription(m_accuracy, TR_ACCUARCY_DESCRIPTION);
   AddDescription(m_store_xfb_copies, TR_STORE_XFB_TO_TEXTURE_DESCRIPTION);
   AddDescription(m_immediate_xfb, TR_IMMEDIATE_XFB_DESCRIPTION);
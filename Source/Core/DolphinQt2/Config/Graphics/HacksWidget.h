@@ -25,6 +25,7 @@ private:
   QCheckBox* m_skip_efb_cpu;
   QCheckBox* m_ignore_format_changes;
   QCheckBox* m_store_efb_copies;
+  QCheckBox* m_defer_efb_copies;
 
   // Texture Cache
   QSlider* m_accuracy;
@@ -42,4 +43,5 @@ private:
   void CreateWidgets();
   void ConnectWidgets();
   void AddDescriptions();
+  void OnBackendChanged();
 };
@@ -23,6 +23,7 @@
 #include "Core/HW/WiiSaveCrypted.h"
 #include "Core/WiiUtils.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DCZBlob.h"
 #include "DiscIO/Enums.h"
 
 #include "DolphinQt2/Config/PropertiesDialog.h"
@@ -173,7 +174,7 @@ void GameList::ShowContextMenu(const QPoint&)
     AddAction(menu, tr("Set as &default ISO"), this, &GameList::SetDefaultISO);
     const auto blob_type = game->GetBlobType();
 
-    if (blob_type == DiscIO::BlobType::GCZ)
+    if (blob_type == DiscIO::BlobType::GCZ || blob_type == DiscIO::BlobType::DCZ)
       AddAction(menu, tr("Decompress ISO..."), this, &GameList::CompressISO);
     else if (blob_type == DiscIO::BlobType::PLAIN)
       AddAction(menu, tr("Compress ISO..."), this, &GameList::CompressISO);
@@ -276,7 +277,8 @@ void GameList::CompressISO()
   auto file = GetSelectedGame();
   const auto original_path = file->GetFilePath();
 
-  const bool compressed = (file->GetBlobType() == DiscIO::BlobType::GCZ);
+  const bool compressed = (file->GetBlobType() == DiscIO::BlobType::GCZ ||
+                           file->GetBlobType() == DiscIO::BlobType::DCZ);
 
   if (!compressed && file->GetPlatform() == DiscIO::Platform::WiiDisc)
   {
@@ -300,7 +302,7 @@ void GameList::CompressISO()
           .absoluteFilePath(QString::fromStdString(file->GetGameID()))
           .append(compressed ? QStringLiteral(".gcm") : QStringLiteral(".gcz")),
       compressed ? tr("Uncompressed GC/Wii images (*.iso *.gcm)") :
-                   tr("Compressed GC/Wii images (*.gcz)"));
+                   tr("Compressed GC/Wii images (*.gcz);;DCZ compressed GC/Wii images (*.dcz)"));
 
   if (dst_path.isEmpty())
     return;
@@ -311,11 +313,23 @@ void GameList::CompressISO()
 
   bool good;
 
-  if (compressed)
+  if (compressed && file->GetBlobType() == DiscIO::BlobType::DCZ)
+  {
+    good = DiscIO::DecompressDCZToFile(original_path, dst_path.toStdString(), &CompressCB,
+                                       &progress_dialog);
+  }
+  else if (compressed)
   {
     good = DiscIO::DecompressBlobToFile(original_path, dst_path.toStdString(), &CompressCB,
                                         &progress_dialog);
   }
+  else if (dst_path.endsWith(QStringLiteral(".dcz"), Qt::CaseInsensitive))
+  {
+    good = DiscIO::ConvertToDCZ(original_path, dst_path.toStdString(), DiscIO::DCZCodec::Deflate,
+                                DiscIO::DCZ_DEFAULT_CHUNK_SIZE,
+                                file->GetPlatform() == DiscIO::Platform::WiiDisc, &CompressCB,
+                                &progress_dialog);
+  }
   else
   {
     good = DiscIO::CompressFileToBlob(original_path, dst_path.toStdString(),
@@ -2,6 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <string>
+#include <vector>
+
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
@@ -13,8 +16,9 @@
 
 static const QStringList game_filters{
     QStringLiteral("*.gcm"),  QStringLiteral("*.iso"), QStringLiteral("*.tgc"),
-    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.wbfs"),
-    QStringLiteral("*.wad"),  QStringLiteral("*.elf"), QStringLiteral("*.dol")};
+    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.dcz"),
+    QStringLiteral("*.wbfs"), QStringLiteral("*.wad"), QStringLiteral("*.elf"),
+    QStringLiteral("*.dol")};
 
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
@@ -98,6 +102,7 @@ void GameTracker::RemoveDirectoryInternal(const QString& dir)
 
 void GameTracker::UpdateDirectoryInternal(const QString& dir)
 {
+  QStringList new_files;
   QDirIterator it(dir, game_filters, QDir::NoFilter, QDirIterator::Subdirectories);
   while (it.hasNext())
   {
@@ -113,10 +118,12 @@ void GameTracker::UpdateDirectoryInternal(const QString& dir)
     {
       addPath(path);
       m_tracked_files[path] = QSet<QString>{dir};
-      LoadGame(path);
+      new_files.append(path);
     }
   }
 
+  LoadGames(new_files);
+
   for (const auto& missing : FindMissingFiles(dir))
   {
     auto& tracked_file = m_tracked_files[missing];
@@ -180,3 +187,21 @@ void GameTracker::LoadGame(const QString& path)
       m_cache.Save();
   }
 }
+
+void GameTracker::LoadGames(const QStringList& paths)
+{
+  std::vector<std::string> converted_paths;
+  converted_paths.reserve(paths.size());
+  for (const QString& path : paths)
+  {
+    std::string converted_path = path.toStdString();
+    if (!DiscIO::ShouldHideFromGameList(converted_path))
+      converted_paths.push_back(std::move(converted_path));
+  }
+
+  const bool cache_changed = m_cache.AddOrGet(
+      converted_paths, m_title_database,
+      [this](const std::shared_ptr<const UICommon::GameFile>& game) { emit GameLoaded(game); });
+  if (cache_changed)
+    m_cache.Save();
+}
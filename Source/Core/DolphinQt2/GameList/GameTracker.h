@@ -10,6 +10,7 @@
 #include <QMap>
 #include <QSet>
 #include <QString>
+#include <QStringList>
 
 #include "Common/WorkQueueThread.h"
 #include "Core/TitleDatabase.h"
@@ -42,6 +43,8 @@ private:
   void UpdateFileInternal(const QString& path);
   QSet<QString> FindMissingFiles(const QString& dir);
   void LoadGame(const QString& path);
+  // Loads several games at once, emitting GameLoaded for each one as soon as it's ready.
+  void LoadGames(const QStringList& paths);
 
   enum class CommandType
   {
@@ -402,5 +402,11 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       State::UndoSaveState();
+
+    if (IsHotkey(HK_SAVE_SNAPSHOT))
+      State::SaveSnapshot();
+
+    if (IsHotkey(HK_LOAD_SNAPSHOT))
+      State::LoadLastSnapshot();
   }
 }
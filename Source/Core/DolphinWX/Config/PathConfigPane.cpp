@@ -40,8 +40,8 @@ void PathConfigPane::InitializeGUI()
 
   m_default_iso_filepicker = new wxFilePickerCtrl(
     this, wxID_ANY, wxEmptyString, _("Choose a default ISO:"),
-    _("All GC/Wii files (elf, dol, gcm, iso, tgc, wbfs, ciso, gcz, wad)") +
-    wxString::Format("|*.elf;*.dol;*.gcm;*.iso;*.tgc;*.wbfs;*.ciso;*.gcz;*.wad|%s",
+    _("All GC/Wii files (elf, dol, gcm, iso, tgc, wbfs, ciso, gcz, dcz, wad)") +
+    wxString::Format("|*.elf;*.dol;*.gcm;*.iso;*.tgc;*.wbfs;*.ciso;*.gcz;*.dcz;*.wad|%s",
       wxGetTranslation(wxALL_FILES)),
     wxDefaultPosition, wxDefaultSize, wxFLP_USE_TEXTCTRL | wxFLP_OPEN | wxFLP_SMALL);
   m_nand_root_dirpicker =
@@ -1700,6 +1700,10 @@ void CFrame::ParseHotkeys()
     State::UndoLoadState();
   if (IsHotkey(HK_UNDO_SAVE_STATE))
     State::UndoSaveState();
+  if (IsHotkey(HK_SAVE_SNAPSHOT))
+    State::SaveSnapshot();
+  if (IsHotkey(HK_LOAD_SNAPSHOT))
+    State::LoadLastSnapshot();
 }
 
 void CFrame::HandleFrameSkipHotkeys()
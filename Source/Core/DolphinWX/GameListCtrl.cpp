@@ -41,6 +41,7 @@
 #include "Common/StringUtil.h"
 #include "Common/SysConf.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/Boot/Boot.h"
 #include "Core/Config/NetplaySettings.h"
 #include "Core/ConfigManager.h"
@@ -51,6 +52,7 @@
 #include "Core/TitleDatabase.h"
 #include "Core/WiiUtils.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DCZBlob.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
 #include "DolphinWX/Frame.h"
@@ -407,13 +409,10 @@ void GameListCtrl::RefreshList()
     return;
 
   m_shown_files.clear();
-  {
-    std::unique_lock<std::mutex> lk(m_cache_mutex);
-    m_cache.ForEach([this](const std::shared_ptr<const UICommon::GameFile>& game_file) {
-      if (ShouldDisplayGameListItem(*game_file))
-        m_shown_files.push_back(game_file);
-    });
-  }
+  m_cache.ForEach([this](const std::shared_ptr<const UICommon::GameFile>& game_file) {
+    if (ShouldDisplayGameListItem(*game_file))
+      m_shown_files.push_back(game_file);
+  });
 
   // Drives are not cached. Not sure if this is required, but better to err on the
   // side of caution if cross-platform issues could come into play.
@@ -666,22 +665,28 @@ void GameListCtrl::RescanList()
 
   bool cache_changed = false;
 
-  {
-    std::unique_lock<std::mutex> lk(m_cache_mutex);
-    if (m_cache.Update(game_paths))
+  // Show new games while the rest are still loading, but don't rebuild the list for every one.
+  constexpr u32 REFRESH_INTERVAL_MS = 500;
+  u32 last_refresh = Common::Timer::GetTimeMs();
+  const auto game_added = [&](const std::shared_ptr<const UICommon::GameFile>&) {
+    const u32 now = Common::Timer::GetTimeMs();
+    if (now - last_refresh >= REFRESH_INTERVAL_MS)
     {
-      cache_changed = true;
+      last_refresh = now;
       QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
     }
+  };
+
+  if (m_cache.Update(game_paths, game_added))
+  {
+    cache_changed = true;
+    QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
   }
 
+  if (m_cache.UpdateAdditionalMetadata(m_title_database))
   {
-    std::unique_lock<std::mutex> lk(m_cache_mutex);
-    if (m_cache.UpdateAdditionalMetadata(m_title_database))
-    {
-      cache_changed = true;
-      QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
-    }
+    cache_changed = true;
+    QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
   }
 
   post_status("");
@@ -700,7 +705,6 @@ void GameListCtrl::OnRescanGameList(wxCommandEvent& event)
   if (event.GetInt())
   {
     // Knock out the cache on a purge event
-    std::unique_lock<std::mutex> lk(m_cache_mutex);
     m_cache.Clear();
   }
   m_scan_trigger.Set();
@@ -982,7 +986,8 @@ void GameListCtrl::OnRightClick(wxMouseEvent& event)
 
       if (platform == DiscIO::Platform::GameCubeDisc || platform == DiscIO::Platform::WiiDisc)
       {
-        if (selected_iso->GetBlobType() == DiscIO::BlobType::GCZ)
+        if (selected_iso->GetBlobType() == DiscIO::BlobType::GCZ ||
+            selected_iso->GetBlobType() == DiscIO::BlobType::DCZ)
           popupMenu.Append(IDM_COMPRESS_ISO, _("Decompress ISO..."));
         else if (selected_iso->GetBlobType() == DiscIO::BlobType::PLAIN)
           popupMenu.Append(IDM_COMPRESS_ISO, _("Compress ISO..."));
@@ -1203,14 +1208,14 @@ void GameListCtrl::CompressSelection(bool _compress)
       iso->GetPlatform() != DiscIO::Platform::WiiDisc)
       continue;
     if (iso->GetBlobType() != DiscIO::BlobType::PLAIN &&
-      iso->GetBlobType() != DiscIO::BlobType::GCZ)
+      iso->GetBlobType() != DiscIO::BlobType::GCZ && iso->GetBlobType() != DiscIO::BlobType::DCZ)
       continue;
 
     items_to_compress.push_back(iso);
 
     // Show the Wii compression warning if it's relevant and it hasn't been shown already
     if (!wii_compression_warning_accepted && _compress &&
-      iso->GetBlobType() != DiscIO::BlobType::GCZ &&
+      iso->GetBlobType() == DiscIO::BlobType::PLAIN &&
       iso->GetPlatform() == DiscIO::Platform::WiiDisc)
     {
       if (WiiCompressWarning())
@@ -1241,7 +1246,7 @@ void GameListCtrl::CompressSelection(bool _compress)
 
     for (const UICommon::GameFile* iso : items_to_compress)
     {
-      if (iso->GetBlobType() != DiscIO::BlobType::GCZ && _compress)
+      if (iso->GetBlobType() == DiscIO::BlobType::PLAIN && _compress)
       {
         std::string FileName;
         SplitPath(iso->GetFilePath(), nullptr, &FileName, nullptr);
@@ -1263,7 +1268,7 @@ void GameListCtrl::CompressSelection(bool _compress)
           (iso->GetPlatform() == DiscIO::Platform::WiiDisc) ? 1 : 0,
             16384, &MultiCompressCB, &progress);
       }
-      else if (iso->GetBlobType() == DiscIO::BlobType::GCZ && !_compress)
+      else if (iso->GetBlobType() != DiscIO::BlobType::PLAIN && !_compress)
       {
         std::string FileName;
         SplitPath(iso->GetFilePath(), nullptr, &FileName, nullptr);
@@ -1283,8 +1288,12 @@ void GameListCtrl::CompressSelection(bool _compress)
             _("Confirm File Overwrite"), wxYES_NO) == wxNO)
           continue;
 
-        all_good &= DiscIO::DecompressBlobToFile(iso->GetFilePath().c_str(), OutputFileName.c_str(),
-          &MultiCompressCB, &progress);
+        if (iso->GetBlobType() == DiscIO::BlobType::DCZ)
+          all_good &= DiscIO::DecompressDCZToFile(iso->GetFilePath(), OutputFileName,
+            &MultiCompressCB, &progress);
+        else
+          all_good &= DiscIO::DecompressBlobToFile(iso->GetFilePath(), OutputFileName,
+            &MultiCompressCB, &progress);
       }
 
       progress.items_done++;
@@ -1308,7 +1317,8 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
   if (!iso)
     return;
 
-  bool is_compressed = iso->GetBlobType() == DiscIO::BlobType::GCZ;
+  bool is_compressed = iso->GetBlobType() == DiscIO::BlobType::GCZ ||
+                       iso->GetBlobType() == DiscIO::BlobType::DCZ;
   wxString path;
 
   std::string FileName, FilePath, FileExtension;
@@ -1335,8 +1345,9 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
 
       path = wxFileSelector(_("Save compressed GCM/ISO"), StrToWxStr(FilePath),
         StrToWxStr(FileName) + ".gcz", wxEmptyString,
-        _("All compressed GC/Wii ISO files (gcz)") +
-        wxString::Format("|*.gcz|%s", wxGetTranslation(wxALL_FILES)),
+        _("All compressed GC/Wii ISO files (gcz)") + "|*.gcz|" +
+        _("All DCZ compressed GC/Wii ISO files (dcz)") +
+        wxString::Format("|*.dcz|%s", wxGetTranslation(wxALL_FILES)),
         wxFD_SAVE, this);
     }
     if (!path)
@@ -1355,9 +1366,17 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
       wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME |
       wxPD_ESTIMATED_TIME | wxPD_REMAINING_TIME | wxPD_SMOOTH);
 
-    if (is_compressed)
+    if (is_compressed && iso->GetBlobType() == DiscIO::BlobType::DCZ)
+      all_good =
+      DiscIO::DecompressDCZToFile(iso->GetFilePath(), WxStrToStr(path), &CompressCB, &dialog);
+    else if (is_compressed)
       all_good =
       DiscIO::DecompressBlobToFile(iso->GetFilePath(), WxStrToStr(path), &CompressCB, &dialog);
+    else if (path.Lower().EndsWith(".dcz"))
+      all_good = DiscIO::ConvertToDCZ(
+        iso->GetFilePath(), WxStrToStr(path), DiscIO::DCZCodec::Deflate,
+        DiscIO::DCZ_DEFAULT_CHUNK_SIZE, iso->GetPlatform() == DiscIO::Platform::WiiDisc,
+        &CompressCB, &dialog);
     else
       all_good = DiscIO::CompressFileToBlob(
         iso->GetFilePath(), WxStrToStr(path),
@@ -129,8 +129,6 @@ private:
 
   // Actual backing GameFiles are maintained in a background thread and cached to file
   UICommon::GameFileCache m_cache;
-  // Locks the cache object, not the shared_ptr<GameFile>s obtained from it
-  std::mutex m_cache_mutex;
   Core::TitleDatabase m_title_database;
   std::mutex m_title_database_mutex;
   std::thread m_scan_thread;
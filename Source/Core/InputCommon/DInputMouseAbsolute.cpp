@@ -27,7 +27,11 @@ void InitMouse(IDirectInput8* const idi8)
       mo_device->SetProperty(DIPROP_AXISMODE, &dipdw.diph);
       auto mouse_input = new DInputMouse();
       mouse_input->Init(mo_device);
+      // The previous mouse is intentionally leaked, other threads may still be using it.
+      if (g_mouse_input)
+        g_mouse_input->StopInputThread();
       g_mouse_input = mouse_input;
+      g_mouse_input->StartInputThread();
       return;
     }
   }
@@ -40,9 +44,18 @@ void InitMouse(IDirectInput8* const idi8)
 
 DInputMouse::DInputMouse()
 {
-  dx = dy = 0;
-  cursor_locked = false;
   m_mo_device = nullptr;
+  last_update = 0;
+}
+
+DInputMouse::~DInputMouse()
+{
+  StopInputThread();
+  if (m_mo_device)
+  {
+    m_mo_device->Unacquire();
+    m_mo_device->Release();
+  }
 }
 
 void DInputMouse::Init(LPDIRECTINPUTDEVICE8 mo_device)
@@ -52,7 +65,7 @@ void DInputMouse::Init(LPDIRECTINPUTDEVICE8 mo_device)
   //we don't need to check device caps
 }
 
-void DInputMouse::UpdateInput()
+void DInputMouse::PollDeltas()
 {
   // safeguard
   if (m_mo_device == nullptr || !SConfig::GetInstance().bEnablePrimeHack)
@@ -82,15 +95,10 @@ void DInputMouse::UpdateInput()
   // Only process inputs when the cursor is locked
   if (SUCCEEDED(hr) && cursor_locked)
   {
-    dx += input_temp.lX - state_prev.lX;
-    dy += input_temp.lY - state_prev.lY;
+    AddDeltas(input_temp.lX - state_prev.lX, input_temp.lY - state_prev.lY);
 
     state_prev = input_temp;
   }
-
-
-  // Ensure the cursor is locked when it needs to be
-  LockCursorToGameWindow();
 }
 
 void DInputMouse::LockCursorToGameWindow()
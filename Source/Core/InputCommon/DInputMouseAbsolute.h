@@ -10,17 +10,18 @@ void InitMouse(IDirectInput8* const idi8);
 
 /* DInputMouse -
 Retrieves mouse input using DirectInput8, intended use outside of standard controller interface
-Input data updated synchronously through UpdateInput method
-Input data retrieved though GetDeltaAxis
+Input data polled on the input thread (or synchronously through UpdateInput if it isn't running)
+Input data retrieved though GetDeltaAxis after LatchDeltas
 */
 class DInputMouse : public GenericMouse
 {
 public:
   DInputMouse();
+  ~DInputMouse() override;
   // Initialize this class with a device
   void Init(LPDIRECTINPUTDEVICE8 mo_device);
 
-  void UpdateInput() override;
+  void PollDeltas() override;
   void LockCursorToGameWindow() override;
 
 private:
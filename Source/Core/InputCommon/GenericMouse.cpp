@@ -1,7 +1,69 @@
 #include "GenericMouse.h"
 
+#include "Common/Thread.h"
+
 namespace prime
 {
+// How often the input thread polls the mouse. Most mice report at 125 to 1000 Hz.
+constexpr u32 INPUT_THREAD_INTERVAL_MS = 1;
+
+GenericMouse::~GenericMouse()
+{
+  StopInputThread();
+}
+
+void GenericMouse::UpdateInput()
+{
+  std::lock_guard<std::mutex> lock(input_thread_mutex);
+  if (!input_thread_running.IsSet() || !input_thread_active)
+    PollDeltas();
+  LockCursorToGameWindow();
+
+  // Mouse motion only matters while the cursor is locked, which ends when the window loses focus.
+  const bool active = cursor_locked;
+  if (active != input_thread_active)
+  {
+    input_thread_active = active;
+    if (active)
+      input_thread_wakeup.notify_one();
+  }
+}
+
+void GenericMouse::StartInputThread()
+{
+  if (input_thread_running.TestAndSet())
+    input_thread = std::thread(&GenericMouse::InputThreadLoop, this);
+}
+
+void GenericMouse::StopInputThread()
+{
+  if (input_thread_running.TestAndClear())
+  {
+    {
+      std::lock_guard<std::mutex> lock(input_thread_mutex);
+      input_thread_wakeup.notify_one();
+    }
+    input_thread.join();
+  }
+}
+
+void GenericMouse::InputThreadLoop()
+{
+  Common::SetCurrentThreadName("PrimeHack Mouse Input");
+
+  while (input_thread_running.IsSet())
+  {
+    {
+      std::unique_lock<std::mutex> lock(input_thread_mutex);
+      input_thread_wakeup.wait(
+          lock, [this] { return input_thread_active || !input_thread_running.IsSet(); });
+      if (!input_thread_running.IsSet())
+        break;
+      PollDeltas();
+    }
+    Common::SleepCurrentThread(INPUT_THREAD_INTERVAL_MS);
+  }
+}
 
 void GenericMouse::OnWindowClick(wxMouseEvent& ev)
 {
@@ -13,6 +75,18 @@ void GenericMouse::OnWindowClick(wxMouseEvent& ev)
   ev.Skip();
 }
 
+void GenericMouse::AddDeltas(int32_t delta_x, int32_t delta_y)
+{
+  pending_dx.fetch_add(delta_x, std::memory_order_relaxed);
+  pending_dy.fetch_add(delta_y, std::memory_order_relaxed);
+}
+
+void GenericMouse::LatchDeltas()
+{
+  dx = pending_dx.exchange(0, std::memory_order_relaxed);
+  dy = pending_dy.exchange(0, std::memory_order_relaxed);
+}
+
 void GenericMouse::ResetDeltas()
 {
   dx = dy = 0;
@@ -1,25 +1,65 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <wx/event.h>
 
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
 namespace prime
 {
 
 class GenericMouse
 {
 public:
+  virtual ~GenericMouse();
+
   // Platform dependant implementations are made virtual
-  virtual void UpdateInput() = 0;
+  // Reads the mouse motion since the last call, and passes it to AddDeltas if the cursor is locked
+  virtual void PollDeltas() = 0;
   virtual void LockCursorToGameWindow() = 0;
 
+  // Called at the SI polling rate. Polls the mouse as well, unless the input thread does that.
+  void UpdateInput();
+
+  // Polls the mouse on a dedicated thread at a much higher rate than SI, so that the deltas are
+  // up to date whenever they are latched rather than only after the last SI poll. The thread is
+  // parked while the cursor isn't locked to the game window, and SI polls the mouse instead.
+  void StartInputThread();
+  void StopInputThread();
+
   void OnWindowClick(wxMouseEvent& ev);
+
+  // Takes all motion accumulated since the last latch as the deltas returned by GetDelta*Axis.
+  // This is done once per frame, right before the deltas are used, so that every read within
+  // the frame sees the same (and most recent) motion and nothing is lost in between.
+  void LatchDeltas();
   void ResetDeltas();
   int32_t GetDeltaVerticalAxis() const;
   int32_t GetDeltaHorizontalAxis() const;
 
 protected:
-  bool cursor_locked;
-  int32_t dx, dy;
+  // Can be called from any thread.
+  void AddDeltas(int32_t delta_x, int32_t delta_y);
+
+  std::atomic<bool> cursor_locked{false};
+
+private:
+  void InputThreadLoop();
+
+  std::atomic<int32_t> pending_dx{0}, pending_dy{0};
+  int32_t dx = 0, dy = 0;
+
+  std::thread input_thread;
+  Common::Flag input_thread_running;
+  // Guards PollDeltas and input_thread_active, so that SI and the input thread never poll at once.
+  std::mutex input_thread_mutex;
+  std::condition_variable input_thread_wakeup;
+  bool input_thread_active = false;
 };
 
 extern GenericMouse* g_mouse_input;
@@ -33,7 +33,11 @@ bool InitXInput2Mouse(void* const hwnd)
   current_master = &all_masters[0];
   if (current_master->use == XIMasterPointer)
   {
+    // The previous mouse is intentionally leaked, other threads may still be using it.
+    if (g_mouse_input)
+      g_mouse_input->StopInputThread();
     g_mouse_input = new XInput2Mouse((Window)hwnd, xi_opcode, current_master->deviceid);
+    g_mouse_input->StartInputThread();
   }
 
   XCloseDisplay(dpy);
@@ -46,6 +50,7 @@ XInput2Mouse::XInput2Mouse(Window hwnd, int opcode, int pointer)
   : pointer_deviceid(pointer), xi_opcode(opcode), window(hwnd)
 {
   display = XOpenDisplay(nullptr);
+  warp_display = XOpenDisplay(nullptr);
 
   int unused;
   XIDeviceInfo* pointer_device = XIQueryDevice(display, pointer_deviceid, &unused);
@@ -63,7 +68,14 @@ XInput2Mouse::XInput2Mouse(Window hwnd, int opcode, int pointer)
   SelectEventsForDevice(DefaultRootWindow(display), &mask, pointer_deviceid);
 }
 
-void XInput2Mouse::UpdateInput()
+XInput2Mouse::~XInput2Mouse()
+{
+  StopInputThread();
+  XCloseDisplay(warp_display);
+  XCloseDisplay(display);
+}
+
+void XInput2Mouse::PollDeltas()
 {
   XFlush(display);
   float delta_x = 0.0f, delta_y = 0.0f;
@@ -102,10 +114,9 @@ void XInput2Mouse::UpdateInput()
 
   if (cursor_locked)
   {
-    this->dx += std::roundf(delta_x);
-    this->dy += std::roundf(delta_y);
+    AddDeltas(static_cast<int32_t>(std::roundf(delta_x)),
+              static_cast<int32_t>(std::roundf(delta_y)));
   }
-  LockCursorToGameWindow();
 }
 
 void XInput2Mouse::SelectEventsForDevice(Window root_window, XIEventMask* mask, int deviceid)
@@ -148,7 +159,8 @@ void XInput2Mouse::LockCursorToGameWindow()
     int cX = ((screen_area.GetRight() + screen_area.GetLeft()) / 2);
     int cY = ((screen_area.GetBottom() + screen_area.GetTop()) / 2);
 
-    XWarpPointer(display, None, DefaultRootWindow(display), 0, 0, 0, 0, cX, cY);
+    XWarpPointer(warp_display, None, DefaultRootWindow(warp_display), 0, 0, 0, 0, cX, cY);
+    XFlush(warp_display);
   }
   else
   {
@@ -19,8 +19,9 @@ class XInput2Mouse : public GenericMouse
 {
 public:
   XInput2Mouse(Window hwnd, int opcode, int pointer);
+  ~XInput2Mouse() override;
 
-  void UpdateInput() override;
+  void PollDeltas() override;
   void LockCursorToGameWindow() override;
 
 private:
@@ -32,6 +33,8 @@ private:
   std::string name;
   Window window;
   Display* display;
+  // Xlib connections can't be shared between threads, and PollDeltas may run on the input thread.
+  Display* warp_display;
 };
 
 }
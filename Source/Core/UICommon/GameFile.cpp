@@ -72,6 +72,13 @@ GameFile::LookupUsingConfigLanguage(const std::map<DiscIO::Language, std::string
 GameFile::GameFile(const std::string& path)
     : m_file_path(path), m_region(DiscIO::Region::Unknown), m_country(DiscIO::Country::Unknown)
 {
+  {
+    // Check this before reading the file, so that a change while scanning is seen next time.
+    const File::FileInfo info(m_file_path);
+    m_disk_file_size = info.GetSize();
+    m_disk_file_mtime = info.GetModificationTime();
+  }
+
   {
     std::string name, extension;
     SplitPath(m_file_path, nullptr, &name, &extension);
@@ -128,6 +135,13 @@ bool GameFile::IsValid() const
   return true;
 }
 
+bool GameFile::FileChangedOnDisk() const
+{
+  const File::FileInfo info(m_file_path);
+  return !info.Exists() || info.GetSize() != m_disk_file_size ||
+         info.GetModificationTime() != m_disk_file_mtime;
+}
+
 bool GameFile::CustomNameChanged(const Core::TitleDatabase& title_database)
 {
   const auto type = m_platform == DiscIO::Platform::WiiWAD ?
@@ -176,6 +190,8 @@ void GameFile::DoState(PointerWrap& p)
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
+  p.Do(m_disk_file_size);
+  p.Do(m_disk_file_mtime);
 
   p.Do(m_short_names);
   p.Do(m_long_names);
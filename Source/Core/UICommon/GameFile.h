@@ -46,6 +46,8 @@ public:
   ~GameFile() = default;
 
   bool IsValid() const;
+  // Whether the file has been modified or deleted since it was scanned.
+  bool FileChangedOnDisk() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(bool long_name = true) const;
@@ -117,6 +119,10 @@ private:
   u64 m_file_size{};
   u64 m_volume_size{};
 
+  // What the file looked like on disk when it was scanned.
+  u64 m_disk_file_size{};
+  u64 m_disk_file_mtime{};
+
   std::map<DiscIO::Language, std::string> m_short_names{};
   std::map<DiscIO::Language, std::string> m_long_names{};
   std::map<DiscIO::Language, std::string> m_short_makers{};
@@ -19,6 +19,7 @@
 #include "Common/File.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/ForkJoinPool.h"
 
 #include "Core/TitleDatabase.h"
 
@@ -28,13 +29,17 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 8;  // Last changed in PR 6560
+static constexpr u32 CACHE_REVISION = 10;  // Last changed when adding file change detection
+
+// Loading a game file is mostly waiting for the disk. A few threads are enough to keep it busy,
+// more would only make hard drives seek back and forth between files.
+static constexpr size_t MAX_LOAD_THREADS = 4;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
-      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wad", ".dol", ".elf"};
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".dcz", ".wbfs", ".wad", ".dol", ".elf"};
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
@@ -42,12 +47,14 @@ std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& direct
 
 void GameFileCache::ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f) const
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   for (const std::shared_ptr<const GameFile>& item : m_cached_files)
     f(item);
 }
 
 void GameFileCache::Clear()
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_cached_files.clear();
 }
 
@@ -55,10 +62,18 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
                                                         bool* cache_changed,
                                                         const Core::TitleDatabase& title_database)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   auto it = std::find_if(
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
-  const bool found = it != m_cached_files.cend();
+  bool found = it != m_cached_files.cend();
+  if (found && (*it)->FileChangedOnDisk())
+  {
+    m_cached_files.erase(it);
+    found = false;
+    *cache_changed = true;
+  }
   if (!found)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
@@ -73,7 +88,43 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   return result;
 }
 
-bool GameFileCache::Update(const std::vector<std::string>& all_game_paths)
+bool GameFileCache::AddOrGet(const std::vector<std::string>& paths,
+                             const Core::TitleDatabase& title_database,
+                             const GameAddedCallback& game_added)
+{
+  bool cache_changed = false;
+  std::vector<std::string> paths_to_load;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::string& path : paths)
+    {
+      auto it = std::find_if(
+          m_cached_files.begin(), m_cached_files.end(),
+          [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
+      if (it != m_cached_files.end() && !(*it)->FileChangedOnDisk())
+      {
+        cache_changed |= UpdateAdditionalMetadata(&*it, title_database);
+        if (game_added)
+          game_added(*it);
+        continue;
+      }
+
+      if (it != m_cached_files.end())
+      {
+        m_cached_files.erase(it);
+        cache_changed = true;
+      }
+      paths_to_load.push_back(path);
+    }
+  }
+
+  cache_changed |= LoadGameFiles(paths_to_load, &title_database, game_added);
+  return cache_changed;
+}
+
+bool GameFileCache::Update(const std::vector<std::string>& all_game_paths,
+                           const GameAddedCallback& game_added)
 {
   // Copy game paths into a set, except ones that match DiscIO::ShouldHideFromGameList.
   // TODO: Prevent DoFileSearch from looking inside /files/ directories of DirectoryBlobs at all?
@@ -88,16 +139,19 @@ bool GameFileCache::Update(const std::vector<std::string>& all_game_paths)
 
   bool cache_changed = false;
 
-  // Delete paths that aren't in game_paths from m_cached_files,
-  // while simultaneously deleting paths that aren't in m_cached_files from game_paths.
+  // Delete paths that aren't in game_paths (or whose files have changed) from m_cached_files,
+  // while simultaneously deleting paths that are in m_cached_files from game_paths.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto it = m_cached_files.begin();
     auto end = m_cached_files.end();
     while (it != end)
     {
-      if (game_paths.erase((*it)->GetFilePath()))
+      auto path_it = game_paths.find((*it)->GetFilePath());
+      if (path_it != game_paths.end() && !(*it)->FileChangedOnDisk())
       {
+        game_paths.erase(path_it);
         ++it;
       }
       else
@@ -112,21 +166,47 @@ bool GameFileCache::Update(const std::vector<std::string>& all_game_paths)
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const auto& path : game_paths)
-  {
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+  cache_changed |= LoadGameFiles(std::vector<std::string>(game_paths.begin(), game_paths.end()),
+                                 nullptr, game_added);
+
+  return cache_changed;
+}
+
+bool GameFileCache::LoadGameFiles(const std::vector<std::string>& paths,
+                                  const Core::TitleDatabase* title_database,
+                                  const GameAddedCallback& game_added)
+{
+  if (paths.empty())
+    return false;
+
+  Common::ForkJoinPool workers(std::min(paths.size(), MAX_LOAD_THREADS) - 1, "Game List Loader");
+  std::mutex game_added_mutex;
+  bool cache_changed = false;
+
+  workers.Run(paths.size(), [&](size_t i, size_t) {
+    auto file = std::make_shared<GameFile>(paths[i]);
+    if (!file->IsValid())
+      return;
+    if (title_database)
+      UpdateAdditionalMetadata(&file, *title_database);
+
     {
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_cached_files.push_back(file);
     }
-  }
+
+    std::lock_guard<std::mutex> lock(game_added_mutex);
+    cache_changed = true;
+    if (game_added)
+      game_added(file);
+  });
 
   return cache_changed;
 }
 
 bool GameFileCache::UpdateAdditionalMetadata(const Core::TitleDatabase& title_database)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   bool cache_changed = false;
 
   for (auto& file : m_cached_files)
@@ -171,6 +251,7 @@ bool GameFileCache::Save()
 
 bool GameFileCache::SyncCacheFile(bool save)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   std::string filename(File::GetUserPath(D_CACHE_IDX) + "gamelist.cache");
   const char* open_mode = save ? "wb" : "rb";
   File::IOFile f(filename, open_mode);
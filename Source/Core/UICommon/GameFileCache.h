@@ -28,9 +28,14 @@ class GameFile;
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan);
 
+// All functions of this class can be called from any thread.
 class GameFileCache
 {
 public:
+  // Called for every game file that is found while updating the cache. When files have to be
+  // loaded, this is called from the loading threads, but never from two threads at once.
+  using GameAddedCallback = std::function<void(const std::shared_ptr<const GameFile>&)>;
+
   void ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f) const;
 
   void Clear();
@@ -40,19 +45,29 @@ public:
                                            const Core::TitleDatabase& title_database);
 
   // These functions return true if the call modified the cache.
-  bool Update(const std::vector<std::string>& all_game_paths);
+  // Files that aren't cached yet or have changed on disk are loaded on several threads, and
+  // game_added is called for each of them as soon as it's ready.
+  bool AddOrGet(const std::vector<std::string>& paths, const Core::TitleDatabase& title_database,
+                const GameAddedCallback& game_added);
+  bool Update(const std::vector<std::string>& all_game_paths,
+              const GameAddedCallback& game_added = {});
   bool UpdateAdditionalMetadata(const Core::TitleDatabase& title_database);
 
   bool Load();
   bool Save();
 
 private:
+  bool LoadGameFiles(const std::vector<std::string>& paths,
+                     const Core::TitleDatabase* title_database,
+                     const GameAddedCallback& game_added);
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file,
                                 const Core::TitleDatabase& title_database);
 
   bool SyncCacheFile(bool save);
   void DoState(PointerWrap* p, u64 size = 0);
 
+  // Locks m_cached_files, not the GameFiles in it
+  mutable std::mutex m_mutex;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
 };
 
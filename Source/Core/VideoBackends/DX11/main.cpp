@@ -100,6 +100,7 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsDynamicSamplerIndexing = false;
   g_Config.backend_info.bSupportsUberShaders = true;
   g_Config.backend_info.bSupportsHighPrecisionFrameBuffer = true;
+  g_Config.backend_info.bSupportsDeferredEFBCopies = false;
   g_Config.ClearFormats();
   IDXGIFactory* factory;
   IDXGIAdapter* ad;
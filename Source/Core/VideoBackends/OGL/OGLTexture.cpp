@@ -11,6 +11,7 @@
 #include "VideoBackends/OGL/OGLTexture.h"
 #include "VideoBackends/OGL/Render.h"
 #include "VideoBackends/OGL/SamplerCache.h"
+#include "VideoBackends/OGL/StreamBuffer.h"
 #include "VideoBackends/OGL/TextureCache.h"
 
 #include "VideoCommon/ImageWrite.h"
@@ -295,6 +296,37 @@ void OGLTexture::Load(const u8* src, u32 width, u32 height, u32 expanded_width,
   glBindTexture(m_config.enviroment ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D_ARRAY, m_texId);
 
   u32 blocksize = (m_config.pcformat == PC_TEX_FMT_DXT1) ? 8u : 16u;
+
+  // Large uploads are copied into the pixel unpack ring, so the driver can transfer them
+  // asynchronously instead of copying from client memory inside the call.
+  u32 rows = height;
+  u32 pitch = 0;
+  u32 last_row = 0;
+  if (TexDecoder::IsCompressed(m_config.pcformat))
+  {
+    rows = (height + 3) >> 2;
+    pitch = ((expanded_width + 3) >> 2) * blocksize;
+    last_row = ((width + 3) >> 2) * blocksize;
+  }
+  else
+  {
+    const u32 pixel_size = TextureUtil::GetTextureSizeInBytes(4, 4, m_config.pcformat) / 16;
+    pitch = expanded_width * pixel_size;
+    last_row = width * pixel_size;
+  }
+  const u32 upload_size = (rows - 1) * pitch + last_row;
+  StreamBuffer* upload_buffer =
+      static_cast<TextureCache*>(g_texture_cache.get())->GetUploadStreamBuffer();
+  const bool use_upload_buffer = upload_buffer &&
+                                 upload_size >= TextureCache::UPLOAD_BUFFER_THRESHOLD &&
+                                 upload_size <= TextureCache::UPLOAD_BUFFER_SIZE / 2;
+  if (use_upload_buffer)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload_buffer->m_buffer);
+    const u32 offset = upload_buffer->Stream(upload_size, 16, src);
+    src = reinterpret_cast<const u8*>(static_cast<uintptr_t>(offset));
+  }
+
   switch (m_config.pcformat)
   {
   case PC_TEX_FMT_DXT1:
@@ -384,6 +416,8 @@ void OGLTexture::Load(const u8* src, u32 width, u32 height, u32 expanded_width,
   }
   break;
   }
+  if (use_upload_buffer)
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
   SetStage();
 }
 
@@ -4,6 +4,9 @@
 
 #include <string>
 
+#include <thread>
+#include <vector>
+
 #include "Common/Align.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
@@ -56,7 +59,51 @@ UBERSHADERUID ProgramShaderCache::last_uber_uid;
 std::condition_variable ProgramShaderCache::s_condition_var;
 std::mutex ProgramShaderCache::s_mutex;
 std::queue<std::unique_ptr<ProgramShaderCache::QueueEntry>> ProgramShaderCache::s_compilation_queue;
-std::thread ProgramShaderCache::s_thread;
+std::vector<std::thread> ProgramShaderCache::s_threads;
+bool ProgramShaderCache::s_precompiling = false;
+std::mutex ProgramShaderCache::s_disk_cache_mutex;
+std::unordered_set<SHADERUID, SHADERUID::ShaderUidHasher> ProgramShaderCache::s_stored_programs;
+// Each UID version gets its own 16 bits, so that no two combinations of versions share a key.
+static_assert(PIXELSHADERGEN_UID_VERSION < 0x10000 && VERTEXSHADERGEN_UID_VERSION < 0x10000 &&
+                  GEOMETRYSHADERGEN_UID_VERSION < 0x10000,
+              "The UID versions have to fit in the room shader profile version");
+static constexpr u64 ROOM_SHADERS_VERSION =
+    (static_cast<u64>(PIXELSHADERGEN_UID_VERSION) << 32) |
+    (static_cast<u64>(VERTEXSHADERGEN_UID_VERSION) << 16) | GEOMETRYSHADERGEN_UID_VERSION;
+RoomUsage::RoomUsageProfile<SHADERUID, SHADERUID::ShaderUidHasher>
+    ProgramShaderCache::s_room_shaders(ROOM_SHADERS_VERSION);
+u32 ProgramShaderCache::s_prewarmed_room_serial = 0;
+
+// Each compile thread needs its own GL context, and drivers compile and link programs on the
+// calling thread, so a few threads are enough to keep the CPU busy without starving the
+// emulation threads.
+static constexpr unsigned int MAX_COMPILE_THREADS = 4;
+
+// Rooms that were visited a lot can have used a few thousand shaders over time; queueing all of
+// them would keep the compile threads from the shaders that are actually missing right now.
+static constexpr size_t MAX_PREWARM_SHADERS = 512;
+
+// Gets the binary of a linked program, prefixed by its format, the way the disk caches store it.
+static bool GetProgramBinary(GLuint program, std::vector<u8>* data)
+{
+  // Clear any prior error code
+  glGetError();
+
+  GLint link_status = GL_FALSE, delete_status = GL_TRUE, binary_size = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+  glGetProgramiv(program, GL_DELETE_STATUS, &delete_status);
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+  if (glGetError() != GL_NO_ERROR || link_status == GL_FALSE || delete_status == GL_TRUE || !binary_size)
+  {
+    return false;
+  }
+
+  data->resize(binary_size + sizeof(GLenum));
+  u8* binary = &(*data)[sizeof(GLenum)];
+  GLenum* prog_format = (GLenum*)&(*data)[0];
+  glGetProgramBinary(program, binary_size, nullptr, prog_format, binary);
+  return glGetError() == GL_NO_ERROR;
+}
 
 static char s_glsl_header[4096] = "";
 
@@ -246,7 +293,7 @@ std::future<bool> ProgramShaderCache::CompileShader(const SHADERUID& uid, SHADER
   INCSTAT(stats.numPixelShadersCreated);
   SETSTAT(stats.numPixelShadersAlive, static_cast<int>(pshaders->size()));
 
-  return CompileShader(shader, vcode.data(), pcode.data(), use_geometry ? gcode.data() : nullptr);
+  return CompileShader(shader, vcode.data(), pcode.data(), use_geometry ? gcode.data() : nullptr, &uid);
 }
 
 SHADER* ProgramShaderCache::CompileUberShader(const UBERSHADERUID& uid)
@@ -302,6 +349,13 @@ SHADER* ProgramShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode, u32
   }
   PCacheEntry* entry = last_entry[render_mode];
 
+  const u32 room_serial = RoomUsage::GetRoomSerial();
+  if (entry->room_serial != room_serial)
+  {
+    entry->room_serial = room_serial;
+    s_room_shaders.Record(RoomUsage::GetCurrentRoom(), uid);
+  }
+
   if (entry->shader.glprogid)
   {
     // Compilation has finished
@@ -314,6 +368,12 @@ SHADER* ProgramShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode, u32
     {
       return SetUberShader(primitive_type, components, vertex_format);
     }
+    // Prewarmed, but not done yet. Without asynchronous compilation, wait for it like for any
+    // other shader.
+    if (!g_ActiveConfig.bFullAsyncShaderCompilation && entry->compile_result.valid())
+    {
+      return entry->compile_result.get() ? &entry->shader : nullptr;
+    }
     return nullptr;
   }
 
@@ -360,29 +420,42 @@ SHADER* ProgramShaderCache::SetUberShader(PrimitiveType primitive_type, u32 comp
 }
 
 std::future<bool> ProgramShaderCache::CompileShader(
-    SHADER& shader, const char* vcode, const char* pcode, const char* gcode)
+    SHADER& shader, const char* vcode, const char* pcode, const char* gcode, const SHADERUID* uid)
 {
-  if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders())
+  const bool store_binary = uid && g_ogl_config.bSupportsGLSLCache;
+  if (UsingCompileThreads() || (s_precompiling && !s_threads.empty()))
   {
-    auto queue_entry = std::make_unique<QueueEntry>(&shader, vcode, pcode, gcode);
+    auto queue_entry = store_binary ?
+      std::make_unique<QueueEntry>(&shader, vcode, pcode, gcode, *uid) :
+      std::make_unique<QueueEntry>(&shader, vcode, pcode, gcode);
     std::future<bool> future = queue_entry->promise.get_future();
-    std::queue <int>::size_type size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
-      size_before = s_compilation_queue.size();
       s_compilation_queue.push(std::move(queue_entry));
     }
-    if (size_before == 0) {
-      s_condition_var.notify_all();
-    }
+    s_condition_var.notify_one();
     return future;
   }
 
+  // Programs compiled here are added to the disk cache on shutdown instead, which keeps reading
+  // the binary back out of the driver off the render thread.
   std::promise<bool> promise;
   promise.set_value(CompileShaderWorker(shader, vcode, pcode, gcode));
   return promise.get_future();
 }
 
+void ProgramShaderCache::StoreProgramBinary(const SHADERUID& uid, GLuint program)
+{
+  std::vector<u8> data;
+  if (!GetProgramBinary(program, &data))
+    return;
+
+  std::lock_guard<std::mutex> lock(s_disk_cache_mutex);
+  if (!s_stored_programs.insert(uid).second)
+    return;
+  g_program_disk_cache.Append(uid, data.data(), static_cast<u32>(data.size()));
+}
+
 bool ProgramShaderCache::CompileShaderWorker(
     SHADER& shader, const char* vcode, const char* pcode, const char* gcode)
 {
@@ -466,19 +539,15 @@ bool ProgramShaderCache::CompileShaderWorker(
 
 bool ProgramShaderCache::CompileComputeShader(SHADER& shader, const std::string& code)
 {
-  if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders())
+  if (UsingCompileThreads())
   {
     auto queue_entry = std::make_unique<QueueEntry>(&shader, code);
     std::future<bool> future = queue_entry->promise.get_future();
-    std::queue <int>::size_type size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
-      size_before = s_compilation_queue.size();
       s_compilation_queue.push(std::move(queue_entry));
     }
-    if (size_before == 0) {
-      s_condition_var.notify_all();
-    }
+    s_condition_var.notify_one();
     return future.get();
   }
   return CompileComputeShaderWorker(shader, code);
@@ -655,6 +724,8 @@ void ProgramShaderCache::CompileThreadWorker(std::unique_ptr<cInterfaceBase> sha
       const char* gcode = entry->gcode.empty() ? nullptr : entry->gcode.c_str();
       success =
           CompileShaderWorker(*entry->shader, entry->vcode.c_str(), entry->pcode.c_str(), gcode);
+      if (success && entry->store_binary)
+        StoreProgramBinary(entry->uid, entry->shader->glprogid);
     }
     entry->promise.set_value(success);
   }
@@ -717,23 +788,36 @@ void ProgramShaderCache::Init()
 
   CreateHeader();
 
-  if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders())
+  // Precompiling on startup uses the compile threads too, so that a fresh cache is filled on
+  // several contexts at once.
+  const bool precompile = g_ActiveConfig.bCompileShaderOnStartup && !UsingExclusiveUberShaders();
+  if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders() || precompile)
   {
-    std::unique_ptr<cInterfaceBase> shared_context = GLInterface->CreateSharedContext();
-    if (!shared_context)
+    const unsigned int num_threads = MathUtil::Clamp(
+      std::thread::hardware_concurrency() / 2, 1u, MAX_COMPILE_THREADS);
+    for (unsigned int i = 0; i < num_threads; i++)
     {
-      PanicAlert(
-        "Failed to create OGL context for shader compilation thread.\nDebug info (%s, %s, %s)",
-        g_ogl_config.gl_vendor, g_ogl_config.gl_renderer, g_ogl_config.gl_version);
-    }
+      std::unique_ptr<cInterfaceBase> shared_context = GLInterface->CreateSharedContext();
+      if (!shared_context)
+      {
+        // Without any compile thread, shaders are compiled on the render thread instead.
+        if (s_threads.empty())
+        {
+          PanicAlert(
+            "Failed to create OGL context for shader compilation thread.\nDebug info (%s, %s, %s)",
+            g_ogl_config.gl_vendor, g_ogl_config.gl_renderer, g_ogl_config.gl_version);
+        }
+        break;
+      }
 
-    s_thread = std::thread(CompileThreadWorker, std::move(shared_context));
+      s_threads.emplace_back(CompileThreadWorker, std::move(shared_context));
+    }
   }
   if (ShouldPrecompileUberShaders())
   {
     CompileUberShaders();
   }
-  if (g_ActiveConfig.bCompileShaderOnStartup && !UsingExclusiveUberShaders())
+  if (precompile)
   {
     CompileShaders();
   }
@@ -758,6 +842,8 @@ void ProgramShaderCache::LoadFromDisk()
     "Ishiiruka.ps.OGL",
     StringFromFormat("%s.ps.OGL", SConfig::GetInstance().GetGameID().c_str())
   );
+  s_room_shaders.Load(GetDiskShaderCacheFileName(API_OPENGL, "rooms", true, false, true));
+  s_prewarmed_room_serial = RoomUsage::GetRoomSerial();
 
   // Read our shader cache, only if supported
   if (g_ogl_config.bSupportsGLSLCache)
@@ -773,7 +859,10 @@ void ProgramShaderCache::LoadFromDisk()
     {
       std::string cache_filename = GetDiskShaderCacheFileName(API_OPENGL, "program", true, true);
       ProgramShaderCacheInserter inserter;
-      g_program_disk_cache.OpenAndRead(cache_filename, inserter);
+      {
+        std::lock_guard<std::mutex> lock(s_disk_cache_mutex);
+        g_program_disk_cache.OpenAndRead(cache_filename, inserter);
+      }
 
       if (g_ActiveConfig.backend_info.bSupportsUberShaders)
       {
@@ -848,6 +937,11 @@ void ProgramShaderCache::CompileShaders()
 {
   pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
   size_t shader_count = 0;
+
+  // Queue every shader first, most used first, so that all compile threads are kept busy and the
+  // shaders a game needs right away are ready soonest. Then wait for them in the same order.
+  std::vector<std::future<bool>> pending;
+  s_precompiling = true;
   pshaders->ForEachMostUsedByCategory(gameid,
     [&](const SHADERUID& it, size_t total)
   {
@@ -863,15 +957,19 @@ void ProgramShaderCache::CompileShaders()
     shader_count++;
     if (!uid_data.bounding_box || g_ActiveConfig.backend_info.bSupportsBBox)
     {
-      Host_UpdateProgressDialog(GetStringT("Compiling Shaders...").c_str(),
-        static_cast<int>(shader_count), static_cast<int>(total));
+      // Without compile threads, the shader is compiled right here.
+      if (s_threads.empty())
+      {
+        Host_UpdateProgressDialog(GetStringT("Compiling Shaders...").c_str(),
+          static_cast<int>(shader_count), static_cast<int>(total));
+      }
 
       PCacheEntry& newentry = pshaders->GetOrAdd(item);
       if (newentry.compile_started)
         return;
       newentry.in_cache = false;
       newentry.compile_started = true;
-      CompileShader(item, newentry.shader).wait();
+      pending.push_back(CompileShader(item, newentry.shader));
     }
   },
     [](PCacheEntry& entry)
@@ -879,25 +977,93 @@ void ProgramShaderCache::CompileShaders()
     return !entry.shader.glprogid;
   }
   , true);
+  s_precompiling = false;
+
+  if (!s_threads.empty())
+  {
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+      pending[i].wait();
+      Host_UpdateProgressDialog(GetStringT("Compiling Shaders...").c_str(),
+        static_cast<int>(i + 1), static_cast<int>(pending.size()));
+    }
+  }
   Host_UpdateProgressDialog("", -1, -1);
 }
 
+void ProgramShaderCache::PrewarmRooms()
+{
+  const u32 room_serial = RoomUsage::GetRoomSerial();
+  if (room_serial == s_prewarmed_room_serial || !pshaders)
+    return;
+  s_prewarmed_room_serial = room_serial;
+
+  // Without compile threads the shaders would be compiled right here, in the middle of the frame,
+  // which is no better than compiling them when they are drawn.
+  if (s_threads.empty() || UsingExclusiveUberShaders())
+    return;
+
+  std::vector<SHADERUID> uids;
+  for (RoomUsage::RoomKey room : RoomUsage::GetRoomsToPrepare(RoomUsage::GetCurrentRoom()))
+  {
+    std::vector<SHADERUID> room_uids = s_room_shaders.Get(room);
+    uids.insert(uids.end(), room_uids.begin(), room_uids.end());
+  }
+  if (uids.size() > MAX_PREWARM_SHADERS)
+    uids.resize(MAX_PREWARM_SHADERS);
+
+  s_precompiling = true;
+  for (SHADERUID& item : uids)
+  {
+    item.puid.ClearHASH();
+    item.puid.CalculateUIDHash();
+    item.vuid.ClearHASH();
+    item.vuid.CalculateUIDHash();
+    item.guid.ClearHASH();
+    item.guid.CalculateUIDHash();
+    item.CalculateHash();
+    if (item.puid.GetUidData().bounding_box && !g_ActiveConfig.backend_info.bSupportsBBox)
+      continue;
+
+    // Shaders the cache no longer knows about (e.g. after it was deleted) are left to the regular
+    // path, which also counts them as used.
+    PCacheEntry* entry = pshaders->GetInfoIfexists(item);
+    if (!entry || entry->compile_started)
+      continue;
+    entry->in_cache = false;
+    entry->compile_started = true;
+    entry->compile_result = CompileShader(item, entry->shader).share();
+  }
+  s_precompiling = false;
+}
+
 void ProgramShaderCache::Shutdown(bool shadersonly)
 {
-  if (!shadersonly && (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders()))
+  if (!shadersonly && !s_threads.empty())
   {
-    auto queue_entry = std::make_unique<QueueEntry>();
-    std::queue <int>::size_type size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
-      size_before = s_compilation_queue.size();
-      s_compilation_queue.push(std::move(queue_entry));
-    }
-    if (size_before == 0) {
-      s_condition_var.notify_all();
+      for (size_t i = 0; i < s_threads.size(); i++)
+        s_compilation_queue.push(std::make_unique<QueueEntry>());
     }
+    s_condition_var.notify_all();
+
+    // The threads finish what is queued before they exit, so wait for them before the shaders
+    // they compile into and the disk cache they write to go away.
+    for (std::thread& thread : s_threads)
+      thread.join();
+    s_threads.clear();
   }
 
+  // Prewarmed shaders may still be compiling into the entries that are about to go away.
+  pshaders->ForEach([](PCacheEntry& entry) {
+    if (entry.compile_result.valid())
+      entry.compile_result.wait();
+  });
+  if (s_room_shaders.GetRoomCount() > 0)
+    s_room_shaders.Save(GetDiskShaderCacheFileName(API_OPENGL, "rooms", true, false, true));
+  s_room_shaders.Clear();
+
   InvalidateVertexFormat();
   pshaders->Persist([](SHADERUID &uid) {
     uid.guid.ClearHASH();
@@ -911,69 +1077,42 @@ void ProgramShaderCache::Shutdown(bool shadersonly)
   // store all shaders in cache on disk
   if (g_ogl_config.bSupportsGLSLCache)
   {
+    std::lock_guard<std::mutex> lock(s_disk_cache_mutex);
     pshaders->Clear(
       [&](const SHADERUID& uid, PCacheEntry& entry)
     {
-      // Clear any prior error code
-      glGetError();
-
-      if (entry.in_cache)
-      {
-        return;
-      }
-
-      GLint link_status = GL_FALSE, delete_status = GL_TRUE, binary_size = 0;
-      glGetProgramiv(entry.shader.glprogid, GL_LINK_STATUS, &link_status);
-      glGetProgramiv(entry.shader.glprogid, GL_DELETE_STATUS, &delete_status);
-      glGetProgramiv(entry.shader.glprogid, GL_PROGRAM_BINARY_LENGTH, &binary_size);
-      if (glGetError() != GL_NO_ERROR || link_status == GL_FALSE || delete_status == GL_TRUE || !binary_size)
+      // Programs linked on a compile thread were added to the cache right away.
+      if (entry.in_cache || s_stored_programs.count(uid))
       {
         return;
       }
 
-      std::vector<u8> data(binary_size + sizeof(GLenum));
-      u8* binary = &data[sizeof(GLenum)];
-      GLenum* prog_format = (GLenum*)&data[0];
-      glGetProgramBinary(entry.shader.glprogid, binary_size, nullptr, prog_format, binary);
-      if (glGetError() != GL_NO_ERROR)
+      std::vector<u8> data;
+      if (!GetProgramBinary(entry.shader.glprogid, &data))
       {
         return;
       }
 
-      g_program_disk_cache.Append(uid, &data[0], binary_size + sizeof(GLenum));
+      g_program_disk_cache.Append(uid, data.data(), static_cast<u32>(data.size()));
     });
     g_program_disk_cache.Sync();
     g_program_disk_cache.Close();
+    s_stored_programs.clear();
     for (auto& item : pushaders)
     {
       PCacheEntry& entry = item.second;
-      // Clear any prior error code
-      glGetError();
-
       if (entry.in_cache)
       {
         continue;
       }
 
-      GLint link_status = GL_FALSE, delete_status = GL_TRUE, binary_size = 0;
-      glGetProgramiv(entry.shader.glprogid, GL_LINK_STATUS, &link_status);
-      glGetProgramiv(entry.shader.glprogid, GL_DELETE_STATUS, &delete_status);
-      glGetProgramiv(entry.shader.glprogid, GL_PROGRAM_BINARY_LENGTH, &binary_size);
-      if (glGetError() != GL_NO_ERROR || link_status == GL_FALSE || delete_status == GL_TRUE || !binary_size)
-      {
-        continue;
-      }
-
-      std::vector<u8> data(binary_size + sizeof(GLenum));
-      u8* binary = &data[sizeof(GLenum)];
-      GLenum* prog_format = (GLenum*)&data[0];
-      glGetProgramBinary(entry.shader.glprogid, binary_size, nullptr, prog_format, binary);
-      if (glGetError() != GL_NO_ERROR)
+      std::vector<u8> data;
+      if (!GetProgramBinary(entry.shader.glprogid, &data))
       {
         continue;
       }
 
-      g_uber_program_disk_cache.Append(item.first, &data[0], binary_size + sizeof(GLenum));
+      g_uber_program_disk_cache.Append(item.first, data.data(), static_cast<u32>(data.size()));
     }
     g_uber_program_disk_cache.Sync();
     g_uber_program_disk_cache.Close();
@@ -984,10 +1123,6 @@ void ProgramShaderCache::Shutdown(bool shadersonly)
   if (!shadersonly)
   {
     s_buffer.reset();
-    if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders())
-    {
-      s_thread.join();
-    }
   }
 }
 
@@ -1185,6 +1320,12 @@ bool ProgramShaderCache::UsingHybridUberShaders()
   return g_ActiveConfig.backend_info.bSupportsUberShaders && g_ActiveConfig.bBackgroundShaderCompiling;
 }
 
+bool ProgramShaderCache::UsingCompileThreads()
+{
+  return !s_threads.empty() &&
+    (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders());
+}
+
 void ProgramShaderCache::ProgramShaderCacheInserter::Read(const SHADERUID& key, const u8* value, u32 value_size)
 {
   const u8 *binary = value + sizeof(GLenum);
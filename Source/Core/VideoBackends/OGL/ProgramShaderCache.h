@@ -12,6 +12,8 @@
 #include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "Common/GL/GLInterfaceBase.h"
 #include "Common/GL/GLUtil.h"
@@ -20,6 +22,7 @@
 #include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/ObjectUsageProfiler.h"
 #include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/RoomUsageProfiler.h"
 #include "VideoCommon/UberShaderCommon.h"
 #include "VideoCommon/UberShaderPixel.h"
 #include "VideoCommon/UberShaderVertex.h"
@@ -131,7 +134,9 @@ public:
   static SHADER* CompileUberShader(const UBERSHADERUID& uid);
   static void GetShaderId(SHADERUID *uid, PIXEL_SHADER_RENDER_MODE render_mode, u32 components, PrimitiveType primitive_type);
 
-  static std::future<bool> CompileShader(SHADER &shader, const char* vcode, const char* pcode, const char* gcode = nullptr);
+  // If uid is given and the program binary cache is enabled, the compile thread that links the
+  // program also adds its binary to the disk cache.
+  static std::future<bool> CompileShader(SHADER &shader, const char* vcode, const char* pcode, const char* gcode = nullptr, const SHADERUID* uid = nullptr);
   static bool CompileComputeShader(SHADER& shader, const std::string& code);
   static GLuint CompileSingleShader(GLuint type, const char *code);
   static void UploadConstants();
@@ -142,6 +147,10 @@ public:
   static void Reload();
   static u32 GetUniformBufferAlignment();
 
+  // Queues the shaders the current room and the rooms likely to follow it used last time on the
+  // compile threads, once after every room change. Called once per frame.
+  static void PrewarmRooms();
+
 private:
   static bool ShouldPrecompileUberShaders();
   static bool UsingExclusiveUberShaders();
@@ -151,6 +160,10 @@ private:
     SHADER shader;
     bool in_cache;
     bool compile_started = false;
+    // The room serial when the shader was last used, so that each room records it only once.
+    u32 room_serial = 0;
+    // Only set for shaders that were queued ahead of time by PrewarmRooms().
+    std::shared_future<bool> compile_result;
 
     void Destroy()
     {
@@ -169,6 +182,12 @@ private:
     {
       gcode = g == nullptr ? std::string() : std::string(g);
     }
+    QueueEntry(SHADER* s, const char* v, const char* p, const char* g, const SHADERUID& u)
+        : QueueEntry(s, v, p, g)
+    {
+      uid = u;
+      store_binary = true;
+    }
     std::promise<bool> promise;
     SHADER* shader;
     std::string vcode;
@@ -177,6 +196,8 @@ private:
     std::string ccode;
     bool compute_shader = false;
     bool kill_thread = false;
+    bool store_binary = false;
+    SHADERUID uid;
   };
 
   typedef ObjectUsageProfiler<SHADERUID, pKey_t, PCacheEntry, SHADERUID::ShaderUidHasher> PCache;
@@ -188,6 +209,8 @@ private:
       SHADER& shader, const char* vcode, const char* pcode, const char* gcode);
   static bool CompileComputeShaderWorker(SHADER& shader, const std::string& code);
   static void CompileThreadWorker(std::unique_ptr<cInterfaceBase> shared_context);
+  static bool UsingCompileThreads();
+  static void StoreProgramBinary(const SHADERUID& uid, GLuint program);
   static void CompileUberShaders();
 
   class ProgramShaderCacheInserter : public LinearDiskCacheReader<SHADERUID, u8>
@@ -220,7 +243,17 @@ private:
   static std::condition_variable s_condition_var;
   static std::mutex s_mutex;
   static std::queue<std::unique_ptr<QueueEntry>> s_compilation_queue;
-  static std::thread s_thread;
+  static std::vector<std::thread> s_threads;
+  // Set while CompileShaders() is queueing the shaders to precompile, so that they are compiled
+  // on the compile threads even without asynchronous shader compilation.
+  static bool s_precompiling;
+
+  // Guards g_program_disk_cache, which the compile threads add to as they link programs.
+  static std::mutex s_disk_cache_mutex;
+  static std::unordered_set<SHADERUID, SHADERUID::ShaderUidHasher> s_stored_programs;
+
+  static RoomUsage::RoomUsageProfile<SHADERUID, SHADERUID::ShaderUidHasher> s_room_shaders;
+  static u32 s_prewarmed_room_serial;
 };
 
 }  // namespace OGL
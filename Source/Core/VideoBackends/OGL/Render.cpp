@@ -43,6 +43,7 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 void VideoConfig::UpdateProjectionHack()
@@ -75,15 +76,11 @@ static bool s_last_xfb_mode = false;
 
 static bool s_vsync;
 
-// EFB cache related
-static const u32 EFB_CACHE_RECT_SIZE = 64;  // Cache 64x64 blocks.
-static const u32 EFB_CACHE_WIDTH =
-    (EFB_WIDTH + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;  // round up
-static const u32 EFB_CACHE_HEIGHT = (EFB_HEIGHT + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;
-static bool s_efbCacheValid[2][EFB_CACHE_WIDTH * EFB_CACHE_HEIGHT];
+// EFB peek snapshot related
 static bool s_efbCacheIsCleared = false;
-static std::vector<u32>
-    s_efbCache[2][EFB_CACHE_WIDTH * EFB_CACHE_HEIGHT];  // 2 for PEEK_Z and PEEK_COLOR
+static GLuint s_efb_peek_framebuffer[2] = {};  // 2 for PEEK_Z and PEEK_COLOR
+static GLuint s_efb_peek_renderbuffer[2] = {};
+static std::vector<float> s_efb_peek_depth;
 
 static void APIENTRY ErrorCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
                                    GLsizei length, const char* message, const void* userParam)
@@ -799,6 +796,12 @@ void Renderer::Shutdown()
   s_raster_font.reset();
   m_post_processor.reset();
 
+  glDeleteFramebuffers(2, s_efb_peek_framebuffer);
+  glDeleteRenderbuffers(2, s_efb_peek_renderbuffer);
+  s_efb_peek_framebuffer[0] = s_efb_peek_framebuffer[1] = 0;
+  s_efb_peek_renderbuffer[0] = s_efb_peek_renderbuffer[1] = 0;
+  s_efbCacheIsCleared = false;
+
   OpenGL_DeleteAttributelessVAO();
 }
 
@@ -912,51 +915,75 @@ void ClearEFBCache()
   if (!s_efbCacheIsCleared)
   {
     s_efbCacheIsCleared = true;
-    memset(s_efbCacheValid, 0, sizeof(s_efbCacheValid));
+    g_video_backend->InvalidateEFBPeekSnapshot();
   }
 }
 
-void Renderer::UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRectangle& efbPixelRc,
-                              const TargetRectangle& targetPixelRc, const void* data)
+// Reads the whole EFB back into the peek snapshot, so later peeks can be answered without a
+// round-trip until the EFB changes. The EFB is scaled down to native resolution with a blit first,
+// which keeps the readback small at high internal resolutions.
+void Renderer::UpdateEFBPeekSnapshot(EFBAccessType type)
 {
-  u32 cacheType = (type == EFBAccessType::PeekZ ? 0 : 1);
-
-  if (!s_efbCache[cacheType][cacheRectIdx].size())
-    s_efbCache[cacheType][cacheRectIdx].resize(EFB_CACHE_RECT_SIZE * EFB_CACHE_RECT_SIZE);
+  const bool is_depth = type == EFBAccessType::PeekZ;
+  const int index = is_depth ? 0 : 1;
+  if (!s_efb_peek_framebuffer[index])
+  {
+    glGenRenderbuffers(1, &s_efb_peek_renderbuffer[index]);
+    glBindRenderbuffer(GL_RENDERBUFFER, s_efb_peek_renderbuffer[index]);
+    glRenderbufferStorage(GL_RENDERBUFFER, is_depth ? GL_DEPTH_COMPONENT32F : GL_RGBA8, EFB_WIDTH,
+                          EFB_HEIGHT);
+    glGenFramebuffers(1, &s_efb_peek_framebuffer[index]);
+    glBindFramebuffer(GL_FRAMEBUFFER, s_efb_peek_framebuffer[index]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, is_depth ? GL_DEPTH_ATTACHMENT : GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, s_efb_peek_renderbuffer[index]);
+  }
 
-  u32 targetPixelRcWidth = targetPixelRc.right - targetPixelRc.left;
-  u32 efbPixelRcHeight = efbPixelRc.bottom - efbPixelRc.top;
-  u32 efbPixelRcWidth = efbPixelRc.right - efbPixelRc.left;
+  ResetAPIState();
 
-  for (u32 yCache = 0; yCache < efbPixelRcHeight; ++yCache)
+  const EFBRectangle efb_rect(0, 0, EFB_WIDTH, EFB_HEIGHT);
+  const TargetRectangle target_rect = ConvertEFBRectangle(efb_rect);
+  GLuint read_framebuffer = FramebufferManager::GetEFBFramebuffer();
+  if (s_MSAASamples > 1)
   {
-    u32 yEFB = efbPixelRc.top + yCache;
-    u32 yPixel = (EFBToScaledY(EFB_HEIGHT - yEFB) + EFBToScaledY(EFB_HEIGHT - yEFB - 1)) / 2;
-    u32 yData = yPixel - targetPixelRc.bottom;
-
-    for (u32 xCache = 0; xCache < efbPixelRcWidth; ++xCache)
-    {
-      u32 xEFB = efbPixelRc.left + xCache;
-      u32 xPixel = (EFBToScaledX(xEFB) + EFBToScaledX(xEFB + 1)) / 2;
-      u32 xData = xPixel - targetPixelRc.left;
-      u32 value;
-      if (type == EFBAccessType::PeekZ)
-      {
-        float* ptr = (float*)data;
-        value = MathUtil::Clamp<u32>((u32)(ptr[yData * targetPixelRcWidth + xData] * 16777216.0f),
-                                     0, 0xFFFFFF);
-      }
-      else
-      {
-        u32* ptr = (u32*)data;
-        value = ptr[yData * targetPixelRcWidth + xData];
-      }
-      s_efbCache[cacheType][cacheRectIdx][yCache * EFB_CACHE_RECT_SIZE + xCache] = value;
-    }
+    // Multisampled framebuffers can't be scaled by a blit, resolve them first.
+    if (is_depth)
+      FramebufferManager::GetEFBDepthTexture(efb_rect);
+    else
+      FramebufferManager::GetEFBColorTexture(efb_rect);
+    read_framebuffer = FramebufferManager::GetResolvedFramebuffer();
   }
 
-  s_efbCacheValid[cacheType][cacheRectIdx] = true;
+  // Flip vertically on the way, so that rows in the snapshot are in EFB order.
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_efb_peek_framebuffer[index]);
+  glBlitFramebuffer(target_rect.left, target_rect.bottom, target_rect.right, target_rect.top, 0,
+                    EFB_HEIGHT, EFB_WIDTH, 0,
+                    is_depth ? GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, s_efb_peek_framebuffer[index]);
+  u32* values = g_video_backend->BeginEFBPeekSnapshot(type);
+  if (is_depth)
+  {
+    s_efb_peek_depth.resize(EFB_WIDTH * EFB_HEIGHT);
+    glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_DEPTH_COMPONENT, GL_FLOAT,
+                 s_efb_peek_depth.data());
+    for (size_t i = 0; i < s_efb_peek_depth.size(); i++)
+      values[i] = MathUtil::Clamp<u32>((u32)(s_efb_peek_depth[i] * 16777216.0f), 0, 0xFFFFFF);
+  }
+  else if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
+  {
+    // XXX: Swap colours
+    glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, values);
+  }
+  else
+  {
+    glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, values);
+  }
+  g_video_backend->EndEFBPeekSnapshot(type, bpmem.zcontrol.pixel_format);
   s_efbCacheIsCleared = false;
+
+  FramebufferManager::SetFramebuffer(0);
+  RestoreAPIState();
 }
 
 // This function allows the CPU to directly access the EFB.
@@ -975,140 +1002,18 @@ void Renderer::UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRec
 // - GX_PokeZMode (TODO)
 u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
-  u32 cacheRectIdx = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_WIDTH + (x / EFB_CACHE_RECT_SIZE);
-
-  EFBRectangle efbPixelRc;
-
-  if (type == EFBAccessType::PeekColor || type == EFBAccessType::PeekZ)
-  {
-    // Get the rectangular target region containing the EFB pixel
-    efbPixelRc.left = (x / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
-    efbPixelRc.top = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
-    efbPixelRc.right = std::min(efbPixelRc.left + EFB_CACHE_RECT_SIZE, (u32)EFB_WIDTH);
-    efbPixelRc.bottom = std::min(efbPixelRc.top + EFB_CACHE_RECT_SIZE, (u32)EFB_HEIGHT);
-  }
-  else
-  {
-    efbPixelRc.left = x;
-    efbPixelRc.top = y;
-    efbPixelRc.right = x + 1;
-    efbPixelRc.bottom = y + 1;
-  }
-
-  TargetRectangle targetPixelRc = ConvertEFBRectangle(efbPixelRc);
-  u32 targetPixelRcWidth = targetPixelRc.right - targetPixelRc.left;
-  u32 targetPixelRcHeight = targetPixelRc.top - targetPixelRc.bottom;
-
-  // TODO (FIX) : currently, AA path is broken/offset and doesn't return the correct pixel
-  switch (type)
-  {
-  case EFBAccessType::PeekZ: {
-    if (!s_efbCacheValid[0][cacheRectIdx])
-    {
-      if (s_MSAASamples > 1)
-      {
-        ResetAPIState();
-
-        // Resolve our rectangle.
-        FramebufferManager::GetEFBDepthTexture(efbPixelRc);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, FramebufferManager::GetResolvedFramebuffer());
-
-        RestoreAPIState();
-      }
-
-      std::unique_ptr<float[]> depthMap(new float[targetPixelRcWidth * targetPixelRcHeight]);
-
-      glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-                   targetPixelRcHeight, GL_DEPTH_COMPONENT, GL_FLOAT, depthMap.get());
-
-      UpdateEFBCache(type, cacheRectIdx, efbPixelRc, targetPixelRc, depthMap.get());
-    }
+  if (type != EFBAccessType::PeekColor && type != EFBAccessType::PeekZ)
+    return 0;
 
-    u32 xRect = x % EFB_CACHE_RECT_SIZE;
-    u32 yRect = y % EFB_CACHE_RECT_SIZE;
-    u32 z = s_efbCache[0][cacheRectIdx][yRect * EFB_CACHE_RECT_SIZE + xRect];
-
-    // if Z is in 16 bit format you must return a 16 bit integer
-    if (bpmem.zcontrol.pixel_format.Value() == PEControl::RGB565_Z16)
-      z = z >> 8;
-
-    return z;
-  }
-
-  case EFBAccessType::PeekColor:  // GXPeekARGB
+  // The first peek after the EFB changed reads all of it back, the conversion to the EFB pixel
+  // format and GX_PokeAlphaRead is shared with peeks answered on the CPU thread.
+  u32 value = 0;
+  if (!g_video_backend->PeekEFBSnapshot(type, x, y, &value))
   {
-    // Although it may sound strange, this really is A8R8G8B8 and not RGBA or 24-bit...
-
-    // Tested in Killer 7, the first 8bits represent the alpha value which is used to
-    // determine if we're aiming at an enemy (0x80 / 0x88) or not (0x70)
-    // Wind Waker is also using it for the pictograph to determine the color of each pixel
-    if (!s_efbCacheValid[1][cacheRectIdx])
-    {
-      if (s_MSAASamples > 1)
-      {
-        ResetAPIState();
-
-        // Resolve our rectangle.
-        FramebufferManager::GetEFBColorTexture(efbPixelRc);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, FramebufferManager::GetResolvedFramebuffer());
-
-        RestoreAPIState();
-      }
-
-      std::unique_ptr<u32[]> colorMap(new u32[targetPixelRcWidth * targetPixelRcHeight]);
-
-      if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
-        // XXX: Swap colours
-        glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-                     targetPixelRcHeight, GL_RGBA, GL_UNSIGNED_BYTE, colorMap.get());
-      else
-        glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-                     targetPixelRcHeight, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, colorMap.get());
-
-      UpdateEFBCache(type, cacheRectIdx, efbPixelRc, targetPixelRc, colorMap.get());
-    }
-
-    u32 xRect = x % EFB_CACHE_RECT_SIZE;
-    u32 yRect = y % EFB_CACHE_RECT_SIZE;
-    u32 color = s_efbCache[1][cacheRectIdx][yRect * EFB_CACHE_RECT_SIZE + xRect];
-
-    // check what to do with the alpha channel (GX_PokeAlphaRead)
-    PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
-
-    if (bpmem.zcontrol.pixel_format.Value() == PEControl::RGBA6_Z24)
-    {
-      color = RGBA8ToRGBA6ToRGBA8(color);
-    }
-    else if (bpmem.zcontrol.pixel_format.Value() == PEControl::RGB565_Z16)
-    {
-      color = RGBA8ToRGB565ToRGBA8(color);
-    }
-    if (bpmem.zcontrol.pixel_format.Value() != PEControl::RGBA6_Z24)
-    {
-      color |= 0xFF000000;
-    }
-    if (alpha_read_mode.ReadMode == 2)
-    {
-      // GX_READ_NONE
-      return color;
-    }
-    else if (alpha_read_mode.ReadMode == 1)
-    {
-      // GX_READ_FF
-      return (color | 0xFF000000);
-    }
-    else /*if(alpha_read_mode.ReadMode == 0)*/
-    {
-      // GX_READ_00
-      return (color & 0x00FFFFFF);
-    }
-  }
-
-  default:
-    break;
+    UpdateEFBPeekSnapshot(type);
+    g_video_backend->PeekEFBSnapshot(type, x, y, &value);
   }
-
-  return 0;
+  return value;
 }
 
 void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points)
@@ -1489,6 +1394,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   // Invalidate shader cache when the host config changes.
   if (CheckForHostConfigChanges())
     ProgramShaderCache::Reload();
+  ProgramShaderCache::PrewarmRooms();
 
   // For testing zbuffer targets.
   // Renderer::SetZBufferRender();
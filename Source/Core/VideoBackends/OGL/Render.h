@@ -135,7 +135,7 @@ private:
   void _SetDepthMode();
   void _SetLogicOpMode();
   void _SetViewport();
-  void UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRectangle& efbPixelRc, const TargetRectangle& targetPixelRc, const void* data);
+  void UpdateEFBPeekSnapshot(EFBAccessType type);
   // Draw either the EFB, or specified XFB sources to the currently-bound framebuffer.
   void DrawFrame(const TargetRectangle& target_rc, const EFBRectangle& source_rc, u32 xfb_addr,
     const XFBSourceBase* const* xfb_sources, u32 xfb_count, GLuint dst_texture, const TargetSize& dst_size, u32 fb_width,
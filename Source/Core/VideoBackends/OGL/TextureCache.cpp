@@ -55,6 +55,7 @@ static u32 s_DepthCbufid;
 
 static SHADER s_palette_pixel_shader[3];
 static std::unique_ptr<StreamBuffer> s_palette_stream_buffer;
+static std::unique_ptr<StreamBuffer> s_upload_stream_buffer;
 static GLuint s_palette_resolv_texture;
 static GLuint s_palette_buffer_offset_uniform[3];
 static GLuint s_palette_multiplier_uniform[3];
@@ -154,6 +155,25 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_widt
     memory_stride, is_depth_copy, src_rect, scale_by_half);
 }
 
+u32 TextureCache::EncodeEFBCopyDeferred(const EFBCopyFormat& format, u32 native_width,
+  u32 bytes_per_row, u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+  bool scale_by_half)
+{
+  return TextureConverter::EncodeToStagingFromTexture(format, native_width, bytes_per_row,
+    num_blocks_y, is_depth_copy, src_rect, scale_by_half);
+}
+
+void TextureCache::ReadBackEFBCopy(u32 handle, u8* dst, u32 bytes_per_row, u32 num_blocks_y,
+  u32 memory_stride)
+{
+  TextureConverter::ReadBackStaging(handle, dst, bytes_per_row, num_blocks_y, memory_stride);
+}
+
+void TextureCache::ReleaseEFBCopy(u32 handle)
+{
+  TextureConverter::ReleaseStaging(handle);
+}
+
 bool TextureCache::Palettize(TCacheEntry* dst_entry, const TCacheEntry* base_entry)
 {
   OGLTexture* base_tex = static_cast<OGLTexture*>(base_entry->texture.get());
@@ -213,6 +233,13 @@ TextureCache::TextureCache()
     glTexBuffer(GL_TEXTURE_BUFFER, GL_R16UI, s_palette_stream_buffer->m_buffer);
     CreateTextureDecodingResources();
   }
+
+  // Only worth it with fenced streaming, the other methods copy the data again or stall.
+  if (g_ogl_config.bSupportsGLSync)
+  {
+    s_upload_stream_buffer = StreamBuffer::Create(GL_PIXEL_UNPACK_BUFFER, UPLOAD_BUFFER_SIZE);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
 }
 
 SHADER TextureCache::GetColorCopyProgram() const
@@ -223,6 +250,10 @@ GLuint TextureCache::GetColorCopyPositionUniform() const
 {
   return s_ColorCopyPositionUniform;
 }
+StreamBuffer* TextureCache::GetUploadStreamBuffer() const
+{
+  return s_upload_stream_buffer.get();
+}
 
 bool TextureCache::CompileShaders()
 {
@@ -444,6 +475,8 @@ TextureCache::~TextureCache()
 {
   DeleteShaders();
   DestroyTextureDecodingResources();
+  s_upload_stream_buffer.reset();
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
   if (g_ActiveConfig.backend_info.bSupportsPaletteConversion)
   {
     s_palette_stream_buffer.reset();
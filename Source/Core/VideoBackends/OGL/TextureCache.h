@@ -13,14 +13,21 @@
 
 namespace OGL
 {
+class StreamBuffer;
 
 class TextureCache : public ::TextureCacheBase
 {
 public:
+  static constexpr u32 UPLOAD_BUFFER_SIZE = 32 * 1024 * 1024;
+  // Uploads smaller than this go straight from client memory.
+  static constexpr u32 UPLOAD_BUFFER_THRESHOLD = 64 * 1024;
+
   TextureCache();
   ~TextureCache();
   SHADER GetColorCopyProgram() const;
   GLuint GetColorCopyPositionUniform() const;
+  // Pixel unpack ring used for large texture uploads, may be null.
+  StreamBuffer* GetUploadStreamBuffer() const;
 private:
 
   HostTextureFormat GetHostTextureFormat(const s32 texformat, const TlutFormat tlutfmt, u32 width, u32 height) override;
@@ -38,6 +45,12 @@ private:
   void CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
     u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
     const EFBRectangle& src_rect, bool scale_by_half) override;
+  u32 EncodeEFBCopyDeferred(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+    u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+    bool scale_by_half) override;
+  void ReadBackEFBCopy(u32 handle, u8* dst, u32 bytes_per_row, u32 num_blocks_y,
+    u32 memory_stride) override;
+  void ReleaseEFBCopy(u32 handle) override;
 
   bool Palettize(TCacheEntry* entry, const TCacheEntry* base_entry) override;
   void LoadLut(u32 lutFmt, void* addr, u32 size) override;
@@ -5,6 +5,7 @@
 // Fast image conversion using OpenGL shaders.
 
 #include <string>
+#include <vector>
 
 #include "Common/Common.h"
 #include "Common/FileUtil.h"
@@ -55,6 +56,18 @@ static std::map<EFBCopyFormat, EncodingProgram> s_encoding_programs;
 
 static GLuint s_PBO = 0; // for readback with different strides
 
+// Encoded EFB copies whose readback has been deferred, see EncodeToStagingFromTexture.
+struct StagingCopy
+{
+  GLuint pbo = 0;
+  u32 capacity = 0;
+  u32 size = 0;
+  bool in_use = false;
+};
+static std::vector<StagingCopy> s_staging_copies;
+// Past this many pending copies, new ones are read back immediately.
+static const size_t MAX_STAGING_COPIES = 32;
+
 static void CreatePrograms()
 {
   /* TODO: Accuracy Improvements
@@ -210,6 +223,10 @@ void Shutdown()
     program.second.program.Destroy();
   s_encoding_programs.clear();
 
+  for (StagingCopy& copy : s_staging_copies)
+    glDeleteBuffers(1, &copy.pbo);
+  s_staging_copies.clear();
+
   s_srcTexture = 0;
   s_dstTexture = 0;
   s_PBO = 0;
@@ -217,10 +234,9 @@ void Shutdown()
   s_texConvFrameBuffer[1] = 0;
 }
 
-// dst_line_size, writeStride in bytes
-static void EncodeToRamUsingShader(GLuint srcTexture,
-  u8* destAddr, u32 dst_line_size, u32 dstHeight,
-  u32 writeStride, bool linearFilter)
+// dst_line_size in bytes
+static void DrawEncodedTexture(GLuint srcTexture, u32 dst_line_size, u32 dstHeight,
+  bool linearFilter)
 {
   u32 dstWidth = (dst_line_size / 4);
   // switch to texture converter frame buffer
@@ -241,15 +257,12 @@ static void EncodeToRamUsingShader(GLuint srcTexture,
   glViewport(0, 0, (GLsizei)dstWidth, (GLsizei)dstHeight);
 
   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
 
-  // .. and then read back the results.
+// Copies a PBO filled by glReadPixels to RAM, honouring the destination stride.
+static void ReadBackPBO(u8* destAddr, u32 dst_line_size, u32 dstHeight, u32 writeStride)
+{
   int dstSize = dst_line_size * dstHeight;
-
-  // When the dst_line_size and writeStride are the same, we could use glReadPixels directly to RAM.
-  // But instead we always copy the data via a PBO, because macOS inexplicably prefers this for some
-  // reason.
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, s_PBO);
-  glReadPixels(0, 0, (GLsizei)dstWidth, (GLsizei)dstHeight, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
   u8* pbo = (u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dstSize, GL_MAP_READ_BIT);
   if (dst_line_size == writeStride)
   {
@@ -265,6 +278,24 @@ static void EncodeToRamUsingShader(GLuint srcTexture,
     }
   }
   glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+}
+
+// dst_line_size, writeStride in bytes
+static void EncodeToRamUsingShader(GLuint srcTexture,
+  u8* destAddr, u32 dst_line_size, u32 dstHeight,
+  u32 writeStride, bool linearFilter)
+{
+  DrawEncodedTexture(srcTexture, dst_line_size, dstHeight, linearFilter);
+
+  // .. and then read back the results.
+  u32 dstWidth = (dst_line_size / 4);
+
+  // When the dst_line_size and writeStride are the same, we could use glReadPixels directly to RAM.
+  // But instead we always copy the data via a PBO, because macOS inexplicably prefers this for some
+  // reason.
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, s_PBO);
+  glReadPixels(0, 0, (GLsizei)dstWidth, (GLsizei)dstHeight, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+  ReadBackPBO(destAddr, dst_line_size, dstHeight, writeStride);
   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
@@ -292,6 +323,69 @@ void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 nativ
   g_renderer->RestoreAPIState();
 }
 
+u32 EncodeToStagingFromTexture(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+  u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half)
+{
+  size_t index = 0;
+  while (index < s_staging_copies.size() && s_staging_copies[index].in_use)
+    index++;
+  if (index == MAX_STAGING_COPIES)
+    return 0;
+  if (index == s_staging_copies.size())
+    s_staging_copies.emplace_back();
+
+  StagingCopy& copy = s_staging_copies[index];
+  if (!copy.pbo)
+    glGenBuffers(1, &copy.pbo);
+
+  g_renderer->ResetAPIState();
+
+  EncodingProgram& texconv_shader = GetOrCreateEncodingShader(format);
+
+  texconv_shader.program.Bind();
+  glUniform4i(texconv_shader.copy_position_uniform, src_rect.left, src_rect.top, native_width,
+    scale_by_half ? 2 : 1);
+
+  const GLuint read_texture = is_depth_copy ?
+    FramebufferManager::ResolveAndGetDepthTarget(src_rect) :
+    FramebufferManager::ResolveAndGetRenderTarget(src_rect);
+
+  DrawEncodedTexture(read_texture, bytes_per_row, num_blocks_y, scale_by_half && !is_depth_copy);
+
+  // The readback into the PBO is only queued here, nothing waits for it until ReadBackStaging.
+  copy.size = bytes_per_row * num_blocks_y;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, copy.pbo);
+  if (copy.capacity < copy.size)
+  {
+    glBufferData(GL_PIXEL_PACK_BUFFER, copy.size, nullptr, GL_STREAM_READ);
+    copy.capacity = copy.size;
+  }
+  glReadPixels(0, 0, (GLsizei)(bytes_per_row / 4), (GLsizei)num_blocks_y, GL_BGRA,
+    GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  copy.in_use = true;
+
+  FramebufferManager::SetFramebuffer(0);
+  g_renderer->RestoreAPIState();
+
+  return static_cast<u32>(index + 1);
+}
+
+void ReadBackStaging(u32 handle, u8* dest_ptr, u32 bytes_per_row, u32 num_blocks_y,
+  u32 memory_stride)
+{
+  StagingCopy& copy = s_staging_copies[handle - 1];
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, copy.pbo);
+  ReadBackPBO(dest_ptr, bytes_per_row, num_blocks_y, memory_stride);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  copy.in_use = false;
+}
+
+void ReleaseStaging(u32 handle)
+{
+  s_staging_copies[handle - 1].in_use = false;
+}
+
 void EncodeToRamYUYV(GLuint srcTexture, const TargetRectangle& sourceRc, u8* destAddr, u32 dstWidth, u32 dstStride, u32 dstHeight)
 {
   g_renderer->ResetAPIState();
@@ -30,6 +30,14 @@ void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 nativ
   u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
   bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half);
 
+// Encodes an EFB copy into a staging buffer without waiting for it. Returns a handle for
+// ReadBackStaging/ReleaseStaging, or 0 if too many copies are already pending.
+u32 EncodeToStagingFromTexture(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+  u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half);
+void ReadBackStaging(u32 handle, u8* dest_ptr, u32 bytes_per_row, u32 num_blocks_y,
+  u32 memory_stride);
+void ReleaseStaging(u32 handle);
+
 }
 
 }  // namespace OGL
@@ -122,6 +122,7 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsAsyncShaderCompilation = true;
   g_Config.backend_info.bSupportsUberShaders = true;
   g_Config.backend_info.bSupportsHighPrecisionFrameBuffer = false;
+  g_Config.backend_info.bSupportsDeferredEFBCopies = true;
   g_Config.backend_info.Adapters.clear();
 
   // aamodes - 1 is to stay consistent with D3D (means no AA)
@@ -6,18 +6,20 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/mathematics.h>
-#include <libswscale/swscale.h>
 }
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -27,6 +29,7 @@ extern "C" {
 #include "Core/Movie.h"
 
 #include "VideoCommon/AVIDump.h"
+#include "VideoCommon/FrameConverter.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -42,7 +45,8 @@ static AVCodecContext* s_codec_context = nullptr;
 static AVFrame* s_src_frame = nullptr;
 static AVFrame* s_scaled_frame = nullptr;
 static AVPixelFormat s_pix_fmt = AV_PIX_FMT_BGR24;
-static SwsContext* s_sws_context = nullptr;
+static std::unique_ptr<FrameConverter> s_frame_converter;
+static constexpr unsigned int MAX_CONVERT_THREADS = 4;
 static int s_width;
 static int s_height;
 static u64 s_last_frame;
@@ -184,6 +188,10 @@ bool AVIDump::CreateVideoFile()
   if (output_format->flags & AVFMT_GLOBALHEADER)
     s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
+  // Let the encoder pick its own thread count, and encode several frames at once if it can.
+  s_codec_context->thread_count = 0;
+  s_codec_context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
   if (avcodec_open2(s_codec_context, codec, nullptr) < 0)
   {
     ERROR_LOG(VIDEO, "Could not open codec");
@@ -221,6 +229,10 @@ bool AVIDump::CreateVideoFile()
     return false;
   }
 
+  const unsigned int num_threads =
+    MathUtil::Clamp(std::thread::hardware_concurrency(), 1u, MAX_CONVERT_THREADS);
+  s_frame_converter = std::make_unique<FrameConverter>(num_threads);
+
   OSD::AddMessage(StringFromFormat("Dumping Frames to \"%s\" (%dx%d)", s_format_context->filename,
     s_width, s_height));
 
@@ -301,14 +313,20 @@ void AVIDump::AddFrame(const u8* data, int width, int height, int stride, const
   s_src_frame->width = s_width;
   s_src_frame->height = s_height;
 
+#if LIBAVCODEC_VERSION_MAJOR >= 55
+  // A threaded encoder can still hold on to the previous frames, so don't overwrite them.
+  if (av_frame_make_writable(s_scaled_frame) < 0)
+  {
+    ERROR_LOG(VIDEO, "Could not allocate frame for dumping");
+    return;
+  }
+#endif
+
   // Convert image from {BGR24, RGBA} to desired pixel format
-  s_sws_context =
-    sws_getCachedContext(s_sws_context, width, height, s_pix_fmt, s_width, s_height,
-      s_codec_context->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (s_sws_context)
+  if (!s_frame_converter->Convert(data, stride, s_pix_fmt, width, height, s_scaled_frame))
   {
-    sws_scale(s_sws_context, s_src_frame->data, s_src_frame->linesize, 0, height,
-      s_scaled_frame->data, s_scaled_frame->linesize);
+    ERROR_LOG(VIDEO, "Could not convert frame for dumping");
+    return;
   }
 
   // Encode and write the image.
@@ -399,11 +417,7 @@ void AVIDump::CloseVideoFile()
   avformat_free_context(s_format_context);
   s_format_context = nullptr;
 
-  if (s_sws_context)
-  {
-    sws_freeContext(s_sws_context);
-    s_sws_context = nullptr;
-  }
+  s_frame_converter.reset();
 }
 
 void AVIDump::DoState()
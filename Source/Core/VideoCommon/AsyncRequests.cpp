@@ -8,6 +8,7 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -156,6 +157,11 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     g_perf_query->FlushResults();
     break;
 
+  case Event::RESOLVE_EFB_COPIES:
+    g_texture_cache->ResolveDeferredEFBCopies(e.resolve_efb_copies.address,
+                                              e.resolve_efb_copies.size);
+    break;
+
   }
 }
 
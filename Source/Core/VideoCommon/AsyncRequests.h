@@ -28,6 +28,7 @@ public:
       SWAP_EVENT,
       BBOX_READ,
       PERF_QUERY,
+      RESOLVE_EFB_COPIES,
     } type;
     u64 time;
 
@@ -63,6 +64,12 @@ public:
 
       struct
       {} perf_query;
+
+      struct
+      {
+        u32 address;
+        u32 size;
+      } resolve_efb_copies;
     };
   };
 
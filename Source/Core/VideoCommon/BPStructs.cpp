@@ -29,6 +29,7 @@
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -312,6 +313,7 @@ void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->ResolveDeferredEFBCopies(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (g_bRecordFifoData)
@@ -440,6 +442,8 @@ void BPWritten(const BPCmd& bp)
     if (bp.changes & 7)
     {
       SetBlendMode(); // dual source could be activated by changing to PIXELFMT_RGBA6_Z24      
+      // Peeks are converted according to the pixel format
+      g_video_backend->InvalidateEFBPeekSnapshot();
     }
     PixelShaderManager::SetZModeControl();
     return;
@@ -505,6 +509,11 @@ void BPWritten(const BPCmd& bp)
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
 
+      // RGBA8 preloads read two lines per tile.
+      g_texture_cache->ResolveDeferredEFBCopies(
+          src_addr, tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE *
+                        (tmem_cfg.preload_tile_info.type == 3 ? 2 : 1));
+
       if (tmem_cfg.preload_tile_info.type != 3)
       {
         bytes_read = tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE;
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 
@@ -33,6 +34,14 @@ void FPSCounter::Update()
   if (g_ActiveConfig.bLogRenderTimeToFile)
     LogRenderTimeToFile(diff);
 
+  if (m_reference_frame_time != 0)
+  {
+    const u64 error = diff > m_reference_frame_time ? diff - m_reference_frame_time :
+                                                      m_reference_frame_time - diff;
+    m_pacing_error_sum += error;
+    m_pacing_error_peak = std::max(m_pacing_error_peak, error);
+  }
+
   m_frame_counter++;
   m_time_since_update += diff;
   m_last_time = time;
@@ -40,7 +49,12 @@ void FPSCounter::Update()
   if (m_time_since_update >= FPS_REFRESH_INTERVAL)
   {
     m_fps = m_frame_counter / (m_time_since_update / 1000000.0);
+    m_pacing_error_avg = m_pacing_error_sum / (m_frame_counter * 1000.0f);
+    m_pacing_error_max = m_pacing_error_peak / 1000.0f;
+    m_reference_frame_time = m_time_since_update / m_frame_counter;
     m_frame_counter = 0;
     m_time_since_update = 0;
+    m_pacing_error_sum = 0;
+    m_pacing_error_peak = 0;
   }
 }
@@ -18,11 +18,24 @@ public:
   void Update();
 
   float GetFPS() const { return m_fps; }
+  // Frame pacing error, i.e. how far individual frame times strayed from the average frame time
+  // over the last refresh interval. Both values are in milliseconds.
+  float GetPacingErrorAvg() const { return m_pacing_error_avg; }
+  float GetPacingErrorMax() const { return m_pacing_error_max; }
+
 private:
   u64 m_last_time = 0;
   u64 m_time_since_update = 0;
   u32 m_frame_counter = 0;
   float m_fps = 0;
+
+  // Frame times of the previous interval serve as the reference for the current one.
+  u64 m_reference_frame_time = 0;
+  u64 m_pacing_error_sum = 0;
+  u64 m_pacing_error_peak = 0;
+  float m_pacing_error_avg = 0;
+  float m_pacing_error_max = 0;
+
   std::ofstream m_bench_file;
 
   void LogRenderTimeToFile(u64 val);
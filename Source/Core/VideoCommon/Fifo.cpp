@@ -302,14 +302,15 @@ void RunGpuLoop()
 
     g_video_backend->PeekMessages();
 
+    // Requests from the CPU thread are served even while paused, savestates need them.
+    AsyncRequests::GetInstance()->PullEvents();
+
     // Do nothing while paused
     if (!s_emu_running_state.IsSet())
       return;
 
     if (s_use_deterministic_gpu_thread)
     {
-      AsyncRequests::GetInstance()->PullEvents();
-
       // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
       u8* seen_ptr = s_video_buffer_seen_ptr;
       u8* write_ptr = s_video_buffer_write_ptr;
@@ -325,8 +326,6 @@ void RunGpuLoop()
     {
       SCPFifoStruct& fifo = CommandProcessor::fifo;
 
-      AsyncRequests::GetInstance()->PullEvents();
-
       CommandProcessor::SetCPStatusFromGPU();
 
       // check if we are able to run this buffer
@@ -0,0 +1,110 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameConverter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+static constexpr int MIN_BAND_HEIGHT = 128;
+
+// swscale clamps its filters at the edges of the image it is given, which would show as seams in
+// the chroma planes if a band was converted on its own. So every band is converted together with
+// this many rows above and below it, which is more than the vertical filters reach, and only its
+// own rows are kept. Bands also start on a multiple of this, so that they start on the same chroma
+// row and dither pattern as they do in the whole image.
+static constexpr int BAND_OVERLAP = 16;
+
+FrameConverter::FrameConverter(size_t num_threads)
+    : m_pool(std::max<size_t>(num_threads, 1) - 1, "FrameDumpConvert")
+{
+}
+
+FrameConverter::~FrameConverter()
+{
+  for (Band& band : m_bands)
+    sws_freeContext(band.context);
+}
+
+bool FrameConverter::Convert(const u8* data, int stride, AVPixelFormat src_format, int width,
+                             int height, AVFrame* dst)
+{
+  if (height <= 0)
+    return true;
+
+  const AVPixelFormat dst_format = static_cast<AVPixelFormat>(dst->format);
+  const AVPixFmtDescriptor* dst_desc = av_pix_fmt_desc_get(dst_format);
+  const int chroma_shift = dst_desc->log2_chroma_h;
+
+  const int wanted_bands = std::min(std::max(height / MIN_BAND_HEIGHT, 1),
+                                    static_cast<int>(m_pool.GetWorkerCount()));
+  int band_height = (height + wanted_bands - 1) / wanted_bands;
+  band_height = (band_height + BAND_OVERLAP - 1) / BAND_OVERLAP * BAND_OVERLAP;
+  const int num_bands = std::max((height + band_height - 1) / band_height, 1);
+
+  if (m_bands.size() < static_cast<size_t>(num_bands))
+    m_bands.resize(num_bands);
+
+  std::atomic<bool> success{true};
+  m_pool.Run(num_bands, [&](size_t band_index, size_t) {
+    const int first_row = static_cast<int>(band_index) * band_height;
+    const int rows = std::min(band_height, height - first_row);
+    if (rows <= 0)
+      return;
+
+    const int src_first_row = std::max(first_row - BAND_OVERLAP, 0);
+    const int src_rows = std::min(first_row + rows + BAND_OVERLAP, height) - src_first_row;
+
+    Band& band = m_bands[band_index];
+    band.context = sws_getCachedContext(band.context, width, src_rows, src_format, width, src_rows,
+                                        dst_format, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (!band.context)
+    {
+      success = false;
+      return;
+    }
+
+    const u8* src[4] = {data + src_first_row * stride, nullptr, nullptr, nullptr};
+    const int src_stride[4] = {stride, 0, 0, 0};
+
+    // A single band can go straight to the frame.
+    if (num_bands == 1)
+    {
+      sws_scale(band.context, src, src_stride, 0, src_rows, dst->data, dst->linesize);
+      return;
+    }
+
+    u8* band_dst[4] = {};
+    for (int plane = 0; plane < 4 && dst->data[plane]; plane++)
+    {
+      // Only the chroma planes of planar formats are subsampled.
+      const bool chroma = (dst_desc->flags & AV_PIX_FMT_FLAG_PLANAR) && (plane == 1 || plane == 2);
+      const int shift = chroma ? chroma_shift : 0;
+      const int plane_rows = (src_rows + (1 << shift) - 1) >> shift;
+      band.planes[plane].resize(static_cast<size_t>(dst->linesize[plane]) * plane_rows);
+      band_dst[plane] = band.planes[plane].data();
+    }
+
+    sws_scale(band.context, src, src_stride, 0, src_rows, band_dst, dst->linesize);
+
+    for (int plane = 0; plane < 4 && dst->data[plane]; plane++)
+    {
+      const bool chroma = (dst_desc->flags & AV_PIX_FMT_FLAG_PLANAR) && (plane == 1 || plane == 2);
+      const int shift = chroma ? chroma_shift : 0;
+      const size_t linesize = dst->linesize[plane];
+      const int copy_rows = (rows + (1 << shift) - 1) >> shift;
+      std::memcpy(dst->data[plane] + (first_row >> shift) * linesize,
+                  band_dst[plane] + ((first_row - src_first_row) >> shift) * linesize,
+                  copy_rows * linesize);
+    }
+  });
+
+  return success;
+}
@@ -0,0 +1,49 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Converts dumped frames to the pixel format of the encoder. Converting a 4K frame takes longer
+// than a frame, so frames are split into horizontal bands that are converted on several threads,
+// each with its own swscale context.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+#include "Common/CommonTypes.h"
+#include "Common/ForkJoinPool.h"
+
+struct SwsContext;
+
+class FrameConverter
+{
+public:
+  explicit FrameConverter(size_t num_threads);
+  ~FrameConverter();
+
+  FrameConverter(const FrameConverter&) = delete;
+  FrameConverter& operator=(const FrameConverter&) = delete;
+
+  // Converts the packed image in data to dst, which has to be allocated with the same size.
+  // The result is the same as converting the whole image with one context.
+  bool Convert(const u8* data, int stride, AVPixelFormat src_format, int width, int height,
+               AVFrame* dst);
+
+private:
+  struct Band
+  {
+    SwsContext* context = nullptr;
+    // The rows of the band and the rows around it, before the band's own rows are copied out.
+    std::array<std::vector<u8>, 4> planes;
+  };
+
+  Common::ForkJoinPool m_pool;
+  std::vector<Band> m_bands;
+};
@@ -4,11 +4,13 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -20,6 +22,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
+#include "Common/ForkJoinPool.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
@@ -35,6 +38,9 @@
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/ImageLoader.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/RoomUsageProfiler.h"
+#include "VideoCommon/TextureTranscoder.h"
 #include "VideoCommon/TextureUtil.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -105,9 +111,38 @@ struct EnvTextureCacheItem
 
 typedef std::unordered_map<std::string, HiresTextureCacheItem> HiresTextureCache;
 typedef std::unordered_map<std::string, EnvTextureCacheItem> EnvTextureCache;
+// The maps that ProccessTexture and ProccessEnviroment are filling in. Only used with
+// s_textureMapMutex held, until they are published.
 static HiresTextureCache s_textureMap;
 static EnvTextureCache s_enviromentMap;
-typedef std::unordered_map<std::string, std::shared_ptr<HiresTexture>> TextureCache;
+
+// The custom textures that can be used, and where their levels are. An index is never changed once
+// it is published, but replaced with a new one, so looking up textures doesn't need a lock and
+// doesn't wait for packages or directories that are being indexed in the background.
+struct TextureIndex
+{
+  HiresTextureCache textures;
+  EnvTextureCache enviroments;
+};
+static std::shared_ptr<const TextureIndex> s_textureIndex = std::make_shared<TextureIndex>();
+
+static std::shared_ptr<const TextureIndex> GetTextureIndex()
+{
+  return std::atomic_load(&s_textureIndex);
+}
+
+static void PublishTextureIndex(std::shared_ptr<const TextureIndex> index)
+{
+  std::atomic_store(&s_textureIndex, std::move(index));
+}
+
+struct TextureCacheEntry
+{
+  std::shared_ptr<HiresTexture> texture;
+  // The frame the texture was last used in, 0 if it was only prefetched so far.
+  int last_used;
+};
+typedef std::unordered_map<std::string, TextureCacheEntry> TextureCache;
 static TextureCache s_textureCache;
 static TextureCache s_enviromentCache;
 
@@ -115,10 +150,28 @@ static std::mutex s_textureCacheMutex;
 static std::mutex s_textureMapMutex;
 static Common::Flag s_textureCacheAbortLoading;
 
+// Bytes of custom textures in s_textureCache and s_enviromentCache.
+static std::atomic<size_t> s_cached_bytes;
+// Bytes of the Aether packages that were indexed.
 static std::atomic<size_t> size_sum;
 static size_t max_mem = 0;
 static std::thread s_prefetcher;
 
+static std::atomic<size_t> s_cache_hits;
+static std::atomic<size_t> s_cache_misses;
+static std::atomic<size_t> s_cache_evictions;
+
+// Custom textures used in each room, so that the ones of the next rooms can be loaded into the
+// cache before the player walks through the door. This matters when the full prefetch is still
+// running, or couldn't keep everything in memory.
+static RoomUsage::RoomUsageProfile<std::string> s_room_textures;
+static RoomUsage::RoomChangedCallbackID s_room_callback_id;
+static std::thread s_room_prefetcher;
+static std::mutex s_room_prefetch_mutex;
+static std::condition_variable s_room_prefetch_wake;
+static RoomUsage::RoomKey s_room_to_prefetch = RoomUsage::NO_ROOM;
+static bool s_room_prefetcher_stop = false;
+
 static const std::string s_format_prefix = "tex1_";
 static const std::string s_enviroment_prefix = "env_";
 
@@ -130,24 +183,48 @@ HiresTexture::HiresTexture()
 
 void HiresTexture::Init()
 {
-  size_sum.store(0);
+  s_cached_bytes.store(0);
+  s_cache_hits.store(0);
+  s_cache_misses.store(0);
+  s_cache_evictions.store(0);
   size_t sys_mem = Common::MemPhysical();
   size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
   // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
   max_mem = (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+
+  s_room_textures.Load(GetRoomProfilePath());
+  s_room_callback_id = RoomUsage::AddRoomChangedCallback([](RoomUsage::RoomKey room) {
+    {
+      std::lock_guard<std::mutex> lk(s_room_prefetch_mutex);
+      s_room_to_prefetch = room;
+    }
+    s_room_prefetch_wake.notify_one();
+  });
+  TextureTranscoder::Init();
+
   Update();
 }
 
 void HiresTexture::Shutdown()
 {
+  RoomUsage::RemoveRoomChangedCallback(s_room_callback_id);
+  StopRoomPrefetcher();
+  if (s_room_textures.GetRoomCount() > 0)
+  {
+    const std::string path = GetRoomProfilePath();
+    File::CreateFullPath(path);
+    s_room_textures.Save(path);
+  }
+  s_room_textures.Clear();
+
   if (s_prefetcher.joinable())
   {
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
-  s_textureMap.clear();
-  s_enviromentMap.clear();
+  PublishTextureIndex(std::make_shared<TextureIndex>());
   s_textureCache.clear();
+  TextureTranscoder::Shutdown();
   Aether::ShutDown();
 }
 
@@ -326,6 +403,7 @@ void HiresTexture::Update()
 {
   bool BuildMaterialMaps = g_ActiveConfig.bHiresMaterialMapsBuild;
 
+  StopRoomPrefetcher();
   {
     if (s_prefetcher.joinable())
     {
@@ -335,13 +413,16 @@ void HiresTexture::Update()
 
     std::scoped_lock lk{s_textureMapMutex, s_textureCacheMutex}; 
 
+    // Until the new index is published, textures are still looked up in the old one.
+    s_textureMap.clear();
+    s_enviromentMap.clear();
+
     if (!g_ActiveConfig.bHiresTextures || !Aether::TestForSnoopers())
     {
-      s_textureMap.clear();
-      s_enviromentMap.clear();
+      PublishTextureIndex(std::make_shared<TextureIndex>());
       s_textureCache.clear();
       s_enviromentCache.clear();
-      size_sum.store(0);
+      s_cached_bytes.store(0);
       return;
     }
 
@@ -349,11 +430,8 @@ void HiresTexture::Update()
     {
       s_textureCache.clear();
       s_enviromentCache.clear();
-      size_sum.store(0);
+      s_cached_bytes.store(0);
     }
-
-    s_textureMap.clear();
-    s_enviromentMap.clear();
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
@@ -371,6 +449,7 @@ void HiresTexture::Update()
   std::vector<std::string> Resourcefilenames =
       Common::DoFileSearch({resource_directory}, Extensions, /*recursive*/ true);
 
+  std::unique_lock<std::mutex> map_lock(s_textureMapMutex);
   for (std::string& fileitem : Resourcefilenames)
   {
     std::string filename;
@@ -408,34 +487,46 @@ void HiresTexture::Update()
     }
   }
 
-  if (g_ActiveConfig.bCacheHiresTextures && s_textureMap.size() > 0)
+  auto index = std::make_shared<TextureIndex>();
+  index->textures = std::move(s_textureMap);
+  index->enviroments = std::move(s_enviromentMap);
+  s_textureMap.clear();
+  s_enviromentMap.clear();
+  PublishTextureIndex(index);
+  map_lock.unlock();
+
+  if (g_ActiveConfig.bCacheHiresTextures && index->textures.size() > 0)
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
-    {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        size_sum.fetch_sub(iter->second->m_cached_data_size);
-        iter = s_textureCache.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
-    }
-    // remove cached but deleted enviroment textures
-    auto iterenv = s_enviromentCache.begin();
-    while (iterenv != s_enviromentCache.end())
     {
-      if (s_enviromentMap.find(iterenv->first) == s_enviromentMap.end())
+      // The GPU thread keeps loading textures from the old index while we prune the cache.
+      std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+      // remove cached but deleted textures
+      auto iter = s_textureCache.begin();
+      while (iter != s_textureCache.end())
       {
-        size_sum.fetch_sub(iterenv->second->m_cached_data_size);
-        iterenv = s_enviromentCache.erase(iterenv);
+        if (index->textures.find(iter->first) == index->textures.end())
+        {
+          s_cached_bytes.fetch_sub(iter->second.texture->m_cached_data_size);
+          iter = s_textureCache.erase(iter);
+        }
+        else
+        {
+          iter++;
+        }
       }
-      else
+      // remove cached but deleted enviroment textures
+      auto iterenv = s_enviromentCache.begin();
+      while (iterenv != s_enviromentCache.end())
       {
-        iterenv++;
+        if (index->enviroments.find(iterenv->first) == index->enviroments.end())
+        {
+          s_cached_bytes.fetch_sub(iterenv->second.texture->m_cached_data_size);
+          iterenv = s_enviromentCache.erase(iterenv);
+        }
+        else
+        {
+          iterenv++;
+        }
       }
     }
     s_textureCacheAbortLoading.Clear();
@@ -444,6 +535,7 @@ void HiresTexture::Update()
     {
       s_prefetcher.join();
     }
+    StartRoomPrefetcher();
   }
 }
 
@@ -451,12 +543,15 @@ void HiresTexture::Update(std::vector<std::string> paths)
 {
   bool BuildMaterialMaps = g_ActiveConfig.bHiresMaterialMapsBuild;
 
+  StopRoomPrefetcher();
   if (s_prefetcher.joinable())
   {
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
 
+  std::lock_guard<std::mutex> map_lock(s_textureMapMutex);
+  auto index = std::make_shared<TextureIndex>(*GetTextureIndex());
   for (int i = 0; i < paths.size(); i++) {
     std::string path = paths[i];
 
@@ -468,174 +563,309 @@ void HiresTexture::Update(std::vector<std::string> paths)
     std::unique_lock<std::mutex> lk(s_textureCacheMutex);
     auto iter = s_textureCache.find(filename);
     if (iter != s_textureCache.end()) {
+      s_cached_bytes.fetch_sub(iter->second.texture->m_cached_data_size);
       iter = s_textureCache.erase(iter);
       invalidate = true;
     }
 
-    std::unique_lock<std::mutex> lk2(s_textureMapMutex);
-    auto iter1 = s_textureMap.find(filename);
-    if (iter1 != s_textureMap.end()) {
-      iter1 = s_textureMap.erase(iter1);
+    auto iter1 = index->textures.find(filename);
+    if (iter1 != index->textures.end()) {
+      iter1 = index->textures.erase(iter1);
       invalidate = true;
     }
 
     if (invalidate)
       prime::AddInvalidateTexture(filename);
   }
+  PublishTextureIndex(index);
+
+  StartRoomPrefetcher();
 }
 
 void HiresTexture::Prefetch()
 {
   Common::SetCurrentThreadName("Prefetcher");
-  size_t total = s_textureMap.size() + s_enviromentMap.size();
-  size_t count = 0;
-  size_t notification = 10;
   u32 starttime = Common::Timer::GetTimeMs();
 
+  const auto index = GetTextureIndex();
+  std::vector<std::string> names;
+  names.reserve(index->textures.size() + index->enviroments.size());
+  for (const auto& entry : index->textures)
+    names.push_back(entry.first);
+  const size_t num_textures = names.size();
+  for (const auto& entry : index->enviroments)
+    names.push_back(entry.first);
+  const size_t total = names.size();
+
   std::unique_lock<std::mutex> dialog_lock (Aether::progress_mutex, std::try_to_lock);
 
-  for (const auto& entry : s_textureMap)
-  {
-    const std::string& base_filename = entry.first;
+  // Textures are loaded by a pool of workers, one texture per task, as reading and decoding the
+  // levels and material maps of a texture is independent of any other texture. If the game has
+  // to wait for us, use every core, otherwise leave two for the CPU and GPU threads.
+  const size_t num_cores = std::max<size_t>(std::thread::hardware_concurrency(), 3);
+  Common::ForkJoinPool pool(
+      g_ActiveConfig.bWaitForCacheHiresTextures ? num_cores - 1 : num_cores - 3, "Prefetcher");
 
-    std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  std::atomic<size_t> count{0};
+  std::atomic<bool> cache_full{false};
+  size_t notification = 10;
+  pool.Run(total, [&](size_t task, size_t worker) {
+    if (s_textureCacheAbortLoading.IsSet() || cache_full.load(std::memory_order_relaxed))
+      return;
 
-    auto iter = s_textureCache.find(base_filename);
-    if (iter == s_textureCache.end())
+    const std::string& base_filename = names[task];
+    const bool enviroment = task >= num_textures;
+    TextureCache& cache = enviroment ? s_enviromentCache : s_textureCache;
+
+    std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+    auto iter = cache.find(base_filename);
+    if (iter == cache.end())
     {
       lk.unlock();
-      HiresTexture* ptr = Load(
-          base_filename, [](size_t requested_size) { return new u8[requested_size]; }, true);
+      const auto allocate = [](size_t requested_size) { return new u8[requested_size]; };
+      HiresTexture* ptr = enviroment ? LoadEnviroment(base_filename, allocate, true) :
+                                       Load(base_filename, allocate, true);
       lk.lock();
       if (ptr != nullptr)
       {
-        size_sum.fetch_add(ptr->m_cached_data_size);
-        iter = s_textureCache.insert(
-            iter, std::make_pair(base_filename, std::shared_ptr<HiresTexture>(ptr)));
+        // Another worker can't have loaded it, but the game may have while we were loading.
+        iter = cache.find(base_filename);
+        if (iter == cache.end())
+        {
+          s_cached_bytes.fetch_add(ptr->m_cached_data_size);
+          cache.emplace(base_filename, TextureCacheEntry{std::shared_ptr<HiresTexture>(ptr), 0});
+        }
+        else
+        {
+          delete ptr;
+        }
       }
     }
+    lk.unlock();
 
-    if (s_textureCacheAbortLoading.IsSet())
+    if (s_cached_bytes.load() > GetCacheBudget())
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
-      {
-        Host_UpdateProgressDialog("", -1, -1);
-      }
+      // Whatever didn't fit is loaded when it is used, and evicts what wasn't used for longest.
+      cache_full.store(true, std::memory_order_relaxed);
       return;
     }
+    const size_t loaded = ++count;
 
-    if (size_sum.load() > max_mem)
-    {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          StringFromFormat(
-              "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
-      {
-        Host_UpdateProgressDialog("", -1, -1);
-      }
+    // The progress dialog lock belongs to this thread, so the other workers don't report.
+    if (worker != 0)
       return;
-    }
-    count++;
-    size_t percent = (count * 100) / total;
+    size_t percent = (loaded * 100) / total;
     if (percent >= notification)
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures && (dialog_lock.owns_lock() || dialog_lock.try_lock()))
+      if (g_ActiveConfig.bWaitForCacheHiresTextures &&
+          (dialog_lock.owns_lock() || dialog_lock.try_lock()))
       {
-      Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
-        static_cast<int>(count), static_cast<int>(total));
+        Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
+                                  static_cast<int>(loaded), static_cast<int>(total));
       }
       else
       {
-      OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
-        size_sum / (1024.0 * 1024.0), percent),
-        2000);
+        OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
+                                         s_cached_bytes / (1024.0 * 1024.0), percent),
+                        2000);
       }
-      notification += 10;
+      // Other workers may have loaded several textures since we last reported.
+      notification = (percent / 10 + 1) * 10;
     }
-  }
+  });
 
-  for (const auto& entry : s_enviromentMap)
+  if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
+  {
+    Host_UpdateProgressDialog("", -1, -1);
+  }
+  if (s_textureCacheAbortLoading.IsSet())
   {
-    const std::string& base_filename = entry.first;
+    return;
+  }
+  if (cache_full.load())
+  {
+    OSD::AddMessage(
+        StringFromFormat(
+            "Custom Textures prefetching stopped after %.1f MB, the texture cache is full",
+            s_cached_bytes / (1024.0 * 1024.0)),
+        10000);
+    return;
+  }
+  u32 stoptime = Common::Timer::GetTimeMs();
+  OSD::AddMessage(StringFromFormat("Custom Textures loaded, %.1f MB in %.1f s",
+    s_cached_bytes / (1024.0 * 1024.0), (stoptime - starttime) / 1000.0),
+    10000);
+}
 
-    std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+size_t HiresTexture::GetCacheBudget()
+{
+  const size_t budget =
+      static_cast<size_t>(std::max(g_ActiveConfig.iHiresTextureCacheBudget, 0)) * 1024 * 1024;
+  return budget ? std::min(budget, max_mem) : max_mem;
+}
+
+void HiresTexture::EvictCachedTextures(const std::string& keep)
+{
+  const size_t budget = GetCacheBudget();
+  if (s_cached_bytes.load() <= budget)
+    return;
 
-    auto iter = s_enviromentCache.find(base_filename);
-    if (iter == s_enviromentCache.end())
+  // The textures of the room the player is in, and of the rooms they are prefetched for, are
+  // about to be used, and so is the one that was just loaded.
+  std::unordered_set<std::string> pinned;
+  for (RoomUsage::RoomKey room : RoomUsage::GetRoomsToPrepare(RoomUsage::GetCurrentRoom()))
+  {
+    for (std::string& basename : s_room_textures.Get(room))
+      pinned.insert(std::move(basename));
+  }
+  pinned.insert(keep);
+
+  struct Candidate
+  {
+    int last_used;
+    TextureCache* cache;
+    TextureCache::iterator iter;
+  };
+  std::vector<Candidate> candidates;
+  for (TextureCache* cache : {&s_textureCache, &s_enviromentCache})
+  {
+    for (auto iter = cache->begin(); iter != cache->end(); ++iter)
     {
-      lk.unlock();
-      HiresTexture* ptr = LoadEnviroment(
-        base_filename, [](size_t requested_size) { return new u8[requested_size]; }, true);
-      lk.lock();
-      if (ptr != nullptr)
-      {
-        size_sum.fetch_add(ptr->m_cached_data_size);
-        iter = s_enviromentCache.insert(
-          iter, std::make_pair(base_filename, std::shared_ptr<HiresTexture>(ptr)));
-      }
+      if (pinned.find(iter->first) == pinned.end())
+        candidates.push_back({iter->second.last_used, cache, iter});
     }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.last_used < b.last_used; });
+
+  // Make some room below the budget, so that not every texture that is loaded afterwards has to
+  // go through all cached textures again. Evicted textures are simply loaded again from their
+  // file or package when they are used, as the texture index still knows where they are.
+  const size_t target = budget - budget / 8;
+  for (const Candidate& candidate : candidates)
+  {
+    if (s_cached_bytes.load() <= target)
+      break;
+    s_cached_bytes.fetch_sub(candidate.iter->second.texture->m_cached_data_size);
+    candidate.cache->erase(candidate.iter);
+    s_cache_evictions++;
+  }
+}
+
+HiresTexture::CacheStats HiresTexture::GetCacheStats()
+{
+  CacheStats result;
+  result.hits = s_cache_hits.load();
+  result.misses = s_cache_misses.load();
+  result.evictions = s_cache_evictions.load();
+  result.size = s_cached_bytes.load();
+  result.budget = GetCacheBudget();
+  return result;
+}
+
+std::string HiresTexture::GetRoomProfilePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".roomtex";
+}
 
-    if (s_textureCacheAbortLoading.IsSet())
+void HiresTexture::StartRoomPrefetcher()
+{
+  if (s_room_prefetcher.joinable() || !g_ActiveConfig.bCacheHiresTextures ||
+      g_ActiveConfig.iHiresRoomPrefetchBudget <= 0)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(s_room_prefetch_mutex);
+    s_room_prefetcher_stop = false;
+    // Catch up with the room the player is already in.
+    s_room_to_prefetch = RoomUsage::GetCurrentRoom();
+  }
+  s_room_prefetcher = std::thread(PrefetchRooms);
+}
+
+void HiresTexture::StopRoomPrefetcher()
+{
+  if (!s_room_prefetcher.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(s_room_prefetch_mutex);
+    s_room_prefetcher_stop = true;
+  }
+  s_room_prefetch_wake.notify_one();
+  s_room_prefetcher.join();
+}
+
+void HiresTexture::PrefetchRooms()
+{
+  Common::SetCurrentThreadName("Room Prefetcher");
+
+  while (true)
+  {
+    RoomUsage::RoomKey room;
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
-      {
-        Host_UpdateProgressDialog("", -1, -1);
-      }
-      return;
+      std::unique_lock<std::mutex> lk(s_room_prefetch_mutex);
+      s_room_prefetch_wake.wait(lk, [] {
+        return s_room_prefetcher_stop || s_room_to_prefetch != RoomUsage::NO_ROOM;
+      });
+      if (s_room_prefetcher_stop)
+        return;
+      room = s_room_to_prefetch;
+      s_room_to_prefetch = RoomUsage::NO_ROOM;
     }
 
-    if (size_sum.load() > max_mem)
-    {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
+    PrefetchRoom(room);
+  }
+}
 
-      OSD::AddMessage(
-        StringFromFormat(
-          "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
-          size_sum / (1024.0 * 1024.0)),
-        10000);
-      if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
+void HiresTexture::PrefetchRoom(u64 room)
+{
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iHiresRoomPrefetchBudget) * 1024 * 1024;
+  size_t loaded = 0;
+
+  // The current room comes first, as whatever it still needs is needed right now.
+  for (RoomUsage::RoomKey prepare : RoomUsage::GetRoomsToPrepare(room))
+  {
+    for (const std::string& basename : s_room_textures.Get(prepare))
+    {
       {
-        Host_UpdateProgressDialog("", -1, -1);
+        // Give up if the player has already moved on.
+        std::lock_guard<std::mutex> lk(s_room_prefetch_mutex);
+        if (s_room_prefetcher_stop || s_room_to_prefetch != RoomUsage::NO_ROOM)
+          return;
       }
-      return;
-    }
-    count++;
-    size_t percent = (count * 100) / total;
-    if (percent >= notification)
-    {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures &&
-        (dialog_lock.owns_lock() || dialog_lock.try_lock()))
+      if (loaded >= budget || s_cached_bytes.load() >= max_mem)
+        return;
+
       {
-        Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
-          static_cast<int>(count), static_cast<int>(total));
+        std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+        if (s_textureCache.find(basename) != s_textureCache.end())
+          continue;
       }
-      else
+
+      HiresTexture* ptr =
+          Load(basename, [](size_t requested_size) { return new u8[requested_size]; }, true);
+      if (!ptr)
+        continue;
+
+      std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+      if (s_textureCache.emplace(basename, TextureCacheEntry{std::shared_ptr<HiresTexture>(ptr), 0})
+              .second)
       {
-        OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
-          size_sum / (1024.0 * 1024.0), percent),
-          2000);
+        s_cached_bytes.fetch_add(ptr->m_cached_data_size);
+        loaded += ptr->m_cached_data_size;
+        EvictCachedTextures(basename);
       }
-      notification += 10;
     }
   }
-
-  if (g_ActiveConfig.bWaitForCacheHiresTextures && dialog_lock.owns_lock())
-  {
-    Host_UpdateProgressDialog("", -1, -1);
-  }
-  u32 stoptime = Common::Timer::GetTimeMs();
-  OSD::AddMessage(StringFromFormat("Custom Textures loaded, %.1f MB in %.1f s",
-    size_sum / (1024.0 * 1024.0), (stoptime - starttime) / 1000.0),
-    10000);
 }
 
 void HiresTexture::PrefetchAllAP()
 {
   u32 starttime = Common::Timer::GetTimeMs();
+  size_sum.store(0);
 
   // If the packages are still initialising, wait until they're done.
   std::scoped_lock<std::mutex> lock(Aether::init_mutex);
@@ -823,59 +1053,80 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
   std::string fullname = basename + tlutname + formatname;
   std::string wildcardname = basename + "_$" + formatname;
 
-  if (!dump && s_textureMap.find(wildcardname) != s_textureMap.end())
+  const auto index = GetTextureIndex();
+  if (!dump && index->textures.find(wildcardname) != index->textures.end())
     return wildcardname;
 
     // else generate the complete texture
-  if (dump || s_textureMap.find(fullname) != s_textureMap.end())
+  if (dump || index->textures.find(fullname) != index->textures.end())
     return fullname;
 
   return "";
 }
 
-inline u8* LoadImageFromFile(const char* path, int& width, int& height)
+// Reads the PNG file at path. Packed PNGs are read straight from their package, otherwise the
+// file is read into buffer.
+inline bool ReadImageFileData(const char* path, std::unique_ptr<u8[]>* buffer, u8** data,
+                              size_t* size)
 {
-  File::IFile* file;
-  bool ppng = false;
-  if (StringEndsWith(path, ".ppng")) {
-    file = new Aether::AFile();
-    ppng = true;
-  }
-  else {
-    file = new File::IOFile();
-  }
-
-  if (!file->Open(path, "rb")) {
-    return nullptr;
-  }
-
-  u8* buffer;
-  if (ppng) {
-    if (!static_cast<Aether::AFile*>(file)->RetrieveDataPtr(&buffer, file->GetSize())) {
-      return nullptr;
-    }
-  }
-  else
+  if (StringEndsWith(path, ".ppng"))
   {
-    buffer = new u8[file->GetSize()];
-    if (!file->ReadBytes(buffer, file->GetSize()))
-    {
-      return nullptr;
-    }
-  }
+    Aether::AFile file;
+    if (!file.Open(path, "rb") || !file.RetrieveDataPtr(data, file.GetSize()))
+      return false;
+    *size = file.GetSize();
 
-  if (ppng) {
     static unsigned char png_sig[8] = { 137,80,78,71,13,10,26,10 };
     for (int i = 0; i < 8; i++) {
-      buffer[i] = png_sig[i];
+      (*data)[i] = png_sig[i];
     }
+    return true;
   }
 
+  File::IOFile file;
+  if (!file.Open(path, "rb"))
+    return false;
+  *size = file.GetSize();
+  buffer->reset(new u8[*size]);
+  *data = buffer->get();
+  return file.ReadBytes(*data, *size);
+}
+
+inline u8* LoadImageFromFile(const char* path, int& width, int& height)
+{
+  std::unique_ptr<u8[]> buffer;
+  u8* data;
+  size_t size;
+  if (!ReadImageFileData(path, &buffer, &data, &size))
+    return nullptr;
+
   int image_channels;
-  return SOIL_load_image_from_memory(buffer, file->GetSize(), &width, &height,
+  return SOIL_load_image_from_memory(data, static_cast<int>(size), &width, &height,
                                      &image_channels, SOIL_LOAD_RGBA);
 }
 
+inline bool ReadTranscodedImage(ImageLoaderParams& ImgInfo, u64 hash)
+{
+  if (!TextureTranscoder::LoadCached(hash, [&](u32 width, u32 height, size_t size) -> u8* {
+        if (ImgInfo.desiredTex == PC_TEX_FMT_NONE &&
+            !TextureTranscoder::IsValidBaseLevelSize(width, height))
+        {
+          return nullptr;
+        }
+        ImgInfo.Width = width;
+        ImgInfo.Height = height;
+        ImgInfo.data_size = static_cast<u32>(size);
+        ImgInfo.dst = ImgInfo.request_buffer_delegate(size, false);
+        return ImgInfo.dst;
+      }))
+  {
+    return false;
+  }
+
+  ImgInfo.resultTex = PC_TEX_FMT_DXT5;
+  return true;
+}
+
 inline void ReadImageFile(ImageLoaderParams& ImgInfo)
 {
   // libpng path seems to fail with some png files using soil meanwhile
@@ -884,10 +1135,39 @@ inline void ReadImageFile(ImageLoaderParams& ImgInfo)
   ImgInfo.resultTex = PC_TEX_FMT_RGBA32;
   }
   */
+  ImgInfo.resultTex = PC_TEX_FMT_NONE;
+  std::unique_ptr<u8[]> buffer;
+  u8* data;
+  size_t size;
+  if (!ReadImageFileData(ImgInfo.Path, &buffer, &data, &size))
+  {
+    return;
+  }
+
+  // desiredTex is the format of the levels that were loaded before: the image has to be BC3 if
+  // they are, and mustn't be if they aren't. PC_TEX_FMT_NONE means there are none.
+  const bool transcode = TextureTranscoder::IsEnabled();
+  u64 hash = 0;
+  if (transcode)
+  {
+    hash = TextureTranscoder::HashImageFile(data, size);
+    if ((ImgInfo.desiredTex == PC_TEX_FMT_NONE || ImgInfo.desiredTex == PC_TEX_FMT_DXT5) &&
+        ReadTranscodedImage(ImgInfo, hash))
+    {
+      return;
+    }
+    // The encoded texture was found, but couldn't be read.
+    if (ImgInfo.dst)
+    {
+      return;
+    }
+  }
+
   int image_width;
   int image_height;
-  ImgInfo.resultTex = PC_TEX_FMT_NONE;
-  u8* decoded = LoadImageFromFile(ImgInfo.Path, image_width, image_height);
+  int image_channels;
+  u8* decoded = SOIL_load_image_from_memory(data, static_cast<int>(size), &image_width,
+                                            &image_height, &image_channels, SOIL_LOAD_RGBA);
   if (decoded == nullptr)
   {
     return;
@@ -896,13 +1176,36 @@ inline void ReadImageFile(ImageLoaderParams& ImgInfo)
   // Reallocate the memory so we can manage it
   ImgInfo.Width = image_width;
   ImgInfo.Height = image_height;
-  ImgInfo.data_size = image_width * image_height * 4;
 
-  ImgInfo.dst = ImgInfo.request_buffer_delegate(ImgInfo.data_size, false);
-  if (ImgInfo.dst)
+  if (transcode && ImgInfo.desiredTex == PC_TEX_FMT_DXT5)
   {
-    memcpy(ImgInfo.dst, decoded, ImgInfo.data_size);
-    ImgInfo.resultTex = PC_TEX_FMT_RGBA32;
+    // Usually a smaller level that wasn't encoded yet. Those are quick to encode right away.
+    ImgInfo.data_size = static_cast<u32>(TextureTranscoder::GetBC3Size(image_width, image_height));
+    ImgInfo.dst = ImgInfo.request_buffer_delegate(ImgInfo.data_size, false);
+    if (ImgInfo.dst)
+    {
+      TextureTranscoder::EncodeBC3(decoded, image_width, image_height, ImgInfo.dst);
+      TextureTranscoder::Store(hash, image_width, image_height, ImgInfo.dst, ImgInfo.data_size);
+      ImgInfo.resultTex = PC_TEX_FMT_DXT5;
+    }
+  }
+  else
+  {
+    ImgInfo.data_size = image_width * image_height * 4;
+    ImgInfo.dst = ImgInfo.request_buffer_delegate(ImgInfo.data_size, false);
+    if (ImgInfo.dst)
+    {
+      memcpy(ImgInfo.dst, decoded, ImgInfo.data_size);
+      ImgInfo.resultTex = PC_TEX_FMT_RGBA32;
+    }
+    // Only first levels are queued: smaller levels are encoded right away once the first level
+    // is BC3. A first level that can't be BC3 would be encoded again every session, as its
+    // encoded version is never used.
+    if (transcode && ImgInfo.desiredTex == PC_TEX_FMT_NONE &&
+        TextureTranscoder::IsValidBaseLevelSize(image_width, image_height))
+    {
+      TextureTranscoder::Queue(hash, data, size);
+    }
   }
 
   SOIL_free_image_data(decoded);
@@ -988,39 +1291,48 @@ HiresTexture::Search(const std::string& basename,
     auto iter = s_textureCache.find(basename);
     if (iter != s_textureCache.end())
     {
-      HiresTexture* current = iter->second.get();
-      u8* dst = request_buffer_delegate(current->m_cached_data_size);
-      memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
-      return iter->second;
+      iter->second.last_used = frameCount;
+      s_cache_hits++;
+      s_room_textures.Record(RoomUsage::GetCurrentRoom(), basename);
+      return iter->second.texture;
     }
     lk.unlock();
-    if (size_sum.load() < max_mem)
+    if (s_cached_bytes.load() < max_mem)
     {
       std::shared_ptr<HiresTexture> ptr(Load(
           basename, [](size_t requested_size) { return new u8[requested_size]; }, true));
       lk.lock();
       if (ptr)
       {
-        s_textureCache[basename] = ptr;
-        HiresTexture* current = ptr.get();
-        size_sum.fetch_add(current->m_cached_data_size);
-        u8* dst = request_buffer_delegate(current->m_cached_data_size);
-        memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+        if (s_textureCache.emplace(basename, TextureCacheEntry{ptr, frameCount}).second)
+        {
+          s_cached_bytes.fetch_add(ptr->m_cached_data_size);
+          EvictCachedTextures(basename);
+        }
+        s_cache_misses++;
+        s_room_textures.Record(RoomUsage::GetCurrentRoom(), basename);
       }
       return ptr;
     }
   }
-  return std::shared_ptr<HiresTexture>(Load(basename, request_buffer_delegate, false));
+  std::shared_ptr<HiresTexture> ptr(Load(basename, request_buffer_delegate, false));
+  if (ptr)
+  {
+    s_cache_misses++;
+    s_room_textures.Record(RoomUsage::GetCurrentRoom(), basename);
+  }
+  return ptr;
 }
 
 bool HiresTexture::EnviromentExists(const std::string& basename)
 {
-  if (s_enviromentMap.size() == 0 || !g_ActiveConfig.HiresMaterialMapsEnabled())
+  const auto index = GetTextureIndex();
+  if (index->enviroments.size() == 0 || !g_ActiveConfig.HiresMaterialMapsEnabled())
   {
     return false;
   }
-  EnvTextureCache::iterator iter = s_enviromentMap.find(basename);
-  if (iter == s_enviromentMap.end())
+  auto iter = index->enviroments.find(basename);
+  if (iter == index->enviroments.end())
   {
     return false;
   }
@@ -1038,24 +1350,24 @@ HiresTexture::SearchEnviroment(const std::string& basename,
     auto iter = s_enviromentCache.find(basename);
     if (iter != s_enviromentCache.end())
     {
-      HiresTexture* current = iter->second.get();
-      u8* dst = request_buffer_delegate(current->m_cached_data_size);
-      memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
-      return iter->second;
+      iter->second.last_used = frameCount;
+      s_cache_hits++;
+      return iter->second.texture;
     }
     lk.unlock();
-    if (size_sum.load() < max_mem)
+    if (s_cached_bytes.load() < max_mem)
     {
       std::shared_ptr<HiresTexture> ptr(LoadEnviroment(
           basename, [](size_t requested_size) { return new u8[requested_size]; }, true));
       lk.lock();
       if (ptr)
       {
-        s_enviromentCache[basename] = ptr;
-        HiresTexture* current = ptr.get();
-        size_sum.fetch_add(current->m_cached_data_size);
-        u8* dst = request_buffer_delegate(current->m_cached_data_size);
-        memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+        if (s_enviromentCache.emplace(basename, TextureCacheEntry{ptr, frameCount}).second)
+        {
+          s_cached_bytes.fetch_add(ptr->m_cached_data_size);
+          EvictCachedTextures(basename);
+        }
+        s_cache_misses++;
       }
       return ptr;
     }
@@ -1063,14 +1375,18 @@ HiresTexture::SearchEnviroment(const std::string& basename,
   return std::shared_ptr<HiresTexture>(LoadEnviroment(basename, request_buffer_delegate, false));
 }
 
+// PNG images are loaded as BC3 if desired_format allows it and they were transcoded before, see
+// ReadImageFile.
 ImageLoaderParams LoadMipLevel(const hires_mip_level& item,
                                const std::function<u8*(size_t, bool)>& bufferdelegate,
-                               bool cacheresult)
+                               bool cacheresult,
+                               HostTextureFormat desired_format = PC_TEX_FMT_RGBA32)
 {
   ImageLoaderParams imgInfo;
   imgInfo.releaseresourcesonerror = cacheresult;
   imgInfo.dst = nullptr;
   imgInfo.Path = item.path.c_str();
+  imgInfo.desiredTex = desired_format;
   imgInfo.request_buffer_delegate = bufferdelegate;
   if (item.is_compressed)
   {
@@ -1114,16 +1430,18 @@ HiresTexture* HiresTexture::Load(const std::string& basename,
                                  std::function<u8*(size_t)> request_buffer_delegate,
                                  bool cacheresult)
 {
-  if (s_textureMap.size() == 0)
+  // Keeps the index alive while current is used.
+  const auto index = GetTextureIndex();
+  if (index->textures.size() == 0)
   {
     return nullptr;
   }
-  HiresTextureCache::iterator iter = s_textureMap.find(basename);
-  if (iter == s_textureMap.end())
+  auto iter = index->textures.find(basename);
+  if (iter == index->textures.end())
   {
     return nullptr;
   }
-  HiresTextureCacheItem& current = iter->second;
+  const HiresTextureCacheItem& current = iter->second;
   if (current.maps[MapType::color].size() == 0)
   {
     return nullptr;
@@ -1184,7 +1502,8 @@ HiresTexture* HiresTexture::Load(const std::string& basename,
   {
     const hires_mip_level& item = current.maps[MapType::color][level];
     ImageLoaderParams imgInfo =
-        LoadMipLevel(item, level == 0 ? first_level_function : allocation_function, cacheresult);
+        LoadMipLevel(item, level == 0 ? first_level_function : allocation_function, cacheresult,
+                     level == 0 ? PC_TEX_FMT_NONE : ret->m_format);
     imgInfo.releaseresourcesonerror = cacheresult;
     nrm_posible = nrm_posible && current.maps[material_mat_index][level].path.size() > 0;
     emissive_posible = emissive_posible && current.maps[emissive_index][level].path.size() > 0;
@@ -1249,12 +1568,17 @@ HiresTexture* HiresTexture::Load(const std::string& basename,
     maxwidth = std::max(maxwidth >> 1, 1u);
     maxheight = std::max(maxheight >> 1, 1u);
   }
+  if (ret == nullptr)
+  {
+    return nullptr;
+  }
   if (nrm_posible)
   {
     for (size_t level = 0; level < current.maps[material_mat_index].size(); level++)
     {
       const hires_mip_level& item = current.maps[material_mat_index][level];
-      ImageLoaderParams imgInfo = LoadMipLevel(item, allocation_function, cacheresult);
+      ImageLoaderParams imgInfo =
+          LoadMipLevel(item, allocation_function, cacheresult, ret->m_format);
       bool ddsfile = item.is_compressed && TexDecoder::IsCompressed(imgInfo.resultTex);
       if ((level > 0 && ddsfile != last_level_is_dds) || imgInfo.dst == nullptr ||
           imgInfo.resultTex == PC_TEX_FMT_NONE)
@@ -1314,7 +1638,8 @@ HiresTexture* HiresTexture::Load(const std::string& basename,
     for (size_t level = 0; level < current.maps[emissive_index].size(); level++)
     {
       const hires_mip_level& item = current.maps[emissive_index][level];
-      ImageLoaderParams imgInfo = LoadMipLevel(item, allocation_function, cacheresult);
+      ImageLoaderParams imgInfo =
+          LoadMipLevel(item, allocation_function, cacheresult, ret->m_format);
       bool ddsfile = item.is_compressed && TexDecoder::IsCompressed(imgInfo.resultTex);
       if ((level > 0 && ddsfile != last_level_is_dds) || imgInfo.dst == nullptr ||
           imgInfo.resultTex == PC_TEX_FMT_NONE)
@@ -1380,17 +1705,19 @@ HiresTexture* HiresTexture::LoadEnviroment(const std::string& basename,
                                            std::function<u8*(size_t)> request_buffer_delegate,
                                            bool cacheresult)
 {
-  if (s_enviromentMap.size() == 0 || !g_ActiveConfig.HiresMaterialMapsEnabled())
+  // Keeps the index alive while current is used.
+  const auto index = GetTextureIndex();
+  if (index->enviroments.size() == 0 || !g_ActiveConfig.HiresMaterialMapsEnabled())
   {
     return nullptr;
   }
-  EnvTextureCache::iterator iter = s_enviromentMap.find(basename);
-  if (iter == s_enviromentMap.end())
+  auto iter = index->enviroments.find(basename);
+  if (iter == index->enviroments.end())
   {
     return nullptr;
   }
   // all enviroment faces are mandatory
-  EnvTextureCacheItem& current = iter->second;
+  const EnvTextureCacheItem& current = iter->second;
   bool complete = current.maps.size() == (EnvType::negativeZ + 1);
   size_t levels = SIZE_MAX;
   for (size_t i = 0; i < current.maps.size(); i++)
@@ -23,6 +23,8 @@ public:
   static void Update(std::vector<std::string> paths);
   static void Shutdown();
 
+  // If the texture is kept in the cache, its data is in m_cached_data and request_buffer_delegate
+  // isn't called. Otherwise the data is written to the buffer request_buffer_delegate returns.
   static std::shared_ptr<HiresTexture> Search(const std::string& basename,
                                               std::function<u8*(size_t)> request_buffer_delegate);
 
@@ -31,6 +33,17 @@ public:
 
   static bool EnviromentExists(const std::string& basename);
 
+  struct CacheStats
+  {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    // Bytes of custom textures in memory, and how many there may be.
+    size_t size;
+    size_t budget;
+  };
+  static CacheStats GetCacheStats();
+
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, int format,
                                  bool has_mipmaps, bool dump = false);
@@ -40,7 +53,9 @@ public:
 
   u32 m_width, m_height, m_levels, m_nrm_levels, m_lum_levels;
   bool has_arbitrary_mips;
-  std::unique_ptr<u8> m_cached_data;
+  // Never changed once the texture is in the cache, so it can be read without holding a lock for
+  // as long as the texture is referenced.
+  std::unique_ptr<u8[]> m_cached_data;
   size_t m_cached_data_size;
 
 private:
@@ -58,6 +73,16 @@ private:
   static void Prefetch();
   static void PrefetchAllAP();
 
+  static size_t GetCacheBudget();
+  // Has to be called with the texture cache locked.
+  static void EvictCachedTextures(const std::string& keep);
+
+  static std::string GetRoomProfilePath();
+  static void StartRoomPrefetcher();
+  static void StopRoomPrefetcher();
+  static void PrefetchRooms();
+  static void PrefetchRoom(u64 room);
+
   HiresTexture();
   static std::set<std::string> GetTextureDirectory(const std::string& game_id);
 };
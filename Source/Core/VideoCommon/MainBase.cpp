@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cstdint>
 #include <cstring>
 
 #include "Common/ChunkFile.h"
@@ -9,8 +10,10 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
 #include "Core/Host.h"
 #include "VideoCommon/AsyncRequests.h"
+#include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BPStructs.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
@@ -24,10 +27,12 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/RoomUsageProfiler.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VideoState.h"
 
@@ -104,6 +109,16 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 Inpu
     return 0;
   }
   u32 result = InputData;
+  if (type == EFBAccessType::PeekColor || type == EFBAccessType::PeekZ)
+  {
+    if (PeekEFBSnapshot(type, x, y, &result))
+      return result;
+  }
+  else
+  {
+    // The poke is only queued, later peeks must not see the old value.
+    InvalidateEFBPeekSnapshot();
+  }
   u32 efb_p_cache_stride = (y >> m_EFB_PCache_Divisor) * m_EFB_PCache_Width + (x >> m_EFB_PCache_Divisor);
   if (type == EFBAccessType::PokeColor || type == EFBAccessType::PokeZ)
   {
@@ -171,6 +186,76 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
 
   return g_perf_query->GetQueryResult(type);
 }
+
+void VideoBackendBase::Video_ResolveDeferredEFBCopies(u32 address, u32 size)
+{
+  if (!m_initialized)
+    return;
+
+  AsyncRequests::Event e;
+  e.time = 0;
+  e.type = AsyncRequests::Event::RESOLVE_EFB_COPIES;
+  e.resolve_efb_copies.address = address;
+  e.resolve_efb_copies.size = size;
+  AsyncRequests::GetInstance()->PushEvent(e, true);
+}
+
+u32* VideoBackendBase::BeginEFBPeekSnapshot(EFBAccessType type)
+{
+  EFBPeekSnapshot& snapshot = m_efb_peek_snapshots[type == EFBAccessType::PeekZ ? 0 : 1];
+  snapshot.generation.store(0, std::memory_order_relaxed);
+  snapshot.values.resize(EFB_WIDTH * EFB_HEIGHT);
+  return snapshot.values.data();
+}
+
+void VideoBackendBase::EndEFBPeekSnapshot(EFBAccessType type, u32 pixel_format)
+{
+  EFBPeekSnapshot& snapshot = m_efb_peek_snapshots[type == EFBAccessType::PeekZ ? 0 : 1];
+  snapshot.pixel_format = pixel_format;
+  snapshot.generation.store(m_efb_peek_generation.load(std::memory_order_acquire),
+                            std::memory_order_release);
+}
+
+bool VideoBackendBase::PeekEFBSnapshot(EFBAccessType type, u32 x, u32 y, u32* value) const
+{
+  const EFBPeekSnapshot& snapshot = m_efb_peek_snapshots[type == EFBAccessType::PeekZ ? 0 : 1];
+  if (snapshot.generation.load(std::memory_order_acquire) !=
+          m_efb_peek_generation.load(std::memory_order_acquire) ||
+      snapshot.values.empty() || x >= EFB_WIDTH || y >= EFB_HEIGHT)
+  {
+    return false;
+  }
+
+  u32 result = snapshot.values[y * EFB_WIDTH + x];
+  const auto pixel_format = static_cast<PEControl::PixelFormat>(snapshot.pixel_format);
+  if (type == EFBAccessType::PeekZ)
+  {
+    // if Z is in 16 bit format you must return a 16 bit integer
+    if (pixel_format == PEControl::RGB565_Z16)
+      result >>= 8;
+    *value = result;
+    return true;
+  }
+
+  // Although it may sound strange, this really is A8R8G8B8 and not RGBA or 24-bit...
+  if (pixel_format == PEControl::RGBA6_Z24)
+    result = RGBA8ToRGBA6ToRGBA8(result);
+  else if (pixel_format == PEControl::RGB565_Z16)
+    result = RGBA8ToRGB565ToRGBA8(result);
+  if (pixel_format != PEControl::RGBA6_Z24)
+    result |= 0xFF000000;
+
+  // check what to do with the alpha channel (GX_PokeAlphaRead)
+  const PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
+  if (alpha_read_mode.ReadMode == 1)
+    result |= 0xFF000000;  // GX_READ_FF
+  else if (alpha_read_mode.ReadMode == 0)
+    result &= 0x00FFFFFF;  // GX_READ_00
+
+  *value = result;
+  return true;
+}
+
 u16 VideoBackendBase::Video_GetBoundingBox(int index)
 {
   if (g_ActiveConfig.iBBoxMode == BBoxNone)
@@ -223,6 +308,7 @@ void VideoBackendBase::InitializeShared()
     VertexShaderManager::DisableDirtyRegions();
   }
   TessellationShaderManager::Init();
+  RoomUsage::Init(SConfig::GetInstance().GetGameID());
 
   // Notify the core that the video backend is ready
   Host_Message(WM_USER_CREATE);
@@ -234,10 +320,13 @@ void VideoBackendBase::ShutdownShared()
   OSD::DoCallbacks(OSD::CallbackType::Shutdown);
 
   m_initialized = false;
+  SetDeferredEFBCopyRange(0, 0);
+  InvalidateEFBPeekSnapshot();
 
   Fifo::Shutdown();
   GeometryShaderManager::Shutdown();
   TessellationShaderManager::Shutdown();
+  RoomUsage::Shutdown();
 }
 
 void VideoBackendBase::CleanupShared()
@@ -248,6 +337,11 @@ void VideoBackendBase::CleanupShared()
 // Run from the CPU thread
 void VideoBackendBase::DoState(PointerWrap& p)
 {
+  // Deferred EFB copies only exist on the GPU. They have to reach RAM before it is saved, and
+  // must not be written back over the RAM of a state that is loaded.
+  if (HasDeferredEFBCopies(0, UINT32_MAX))
+    Video_ResolveDeferredEFBCopies(0, UINT32_MAX);
+
   bool software = false;
   p.Do(software);
 
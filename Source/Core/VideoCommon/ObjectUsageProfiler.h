@@ -153,6 +153,17 @@ public:
     return nullptr;
   }
 
+  // Unlike GetOrAdd, doesn't count as a use of obj.
+  TInfo* GetInfoIfexists(const Tobj& obj)
+  {
+    auto it = m_objects.find(obj);
+    if (it != m_objects.end())
+    {
+      return &it->second.info;
+    }
+    return nullptr;
+  }
+
   size_t size() const
   {
     return m_objects.size();
@@ -12,8 +12,10 @@
 // Next frame, that one is scanned out and the other one gets the copy. = double buffering.
 // ---------------------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -79,6 +81,10 @@ std::unique_ptr<Renderer> g_renderer;
 // to the depth buffer that exceeds 2^24 - 1.
 const float Renderer::GX_MAX_DEPTH = 16777215.0f / 16777216.0f;
 
+// Queued frame dumps are uncompressed, so a few seconds of 4K frames would need gigabytes.
+static constexpr size_t MAX_FRAME_DUMP_QUEUE_MEMORY = 256 * 1024 * 1024;
+static constexpr size_t MAX_QUEUED_FRAME_DUMPS = 16;
+
 static float AspectToWidescreen(float aspect)
 {
   return aspect * ((16.0f / 9.0f) / (4.0f / 3.0f));
@@ -342,7 +348,13 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bShowFPS || SConfig::GetInstance().m_ShowFrameCount)
   {
     if (g_ActiveConfig.bShowFPS)
+    {
       final_cyan += StringFromFormat("FPS: %.2f", m_fps_counter.GetFPS());
+      if (SConfig::GetInstance().bPreciseFramePacing)
+        final_cyan += StringFromFormat(" (pacing error avg %.2f ms, max %.2f ms)",
+                                       m_fps_counter.GetPacingErrorAvg(),
+                                       m_fps_counter.GetPacingErrorMax());
+    }
 
     if (g_ActiveConfig.bShowFPS && SConfig::GetInstance().m_ShowFrameCount)
       final_cyan += " - ";
@@ -361,7 +373,8 @@ void Renderer::DrawDebugText()
 
   if (g_ActiveConfig.bPrimeHackInfo)
   {
-    final_purple = prime::GetDevInfo() + "\n";
+    prime::FormatDevInfo(&final_purple);
+    final_purple += "\n";
   }
 
   if (std::get<0>(prime::GetCheatsTime()) > Common::Timer::GetTimeMs()) // Noclip
@@ -914,18 +927,13 @@ void Renderer::FinishFrameData()
 void Renderer::RunFrameDumps()
 {
   Common::SetCurrentThreadName("FrameDumping");
-  bool dump_to_avi = !g_ActiveConfig.bDumpFramesAsImages;
-  bool frame_dump_started = false;
 
-  // If Dolphin was compiled without libav, we only support dumping to images.
-#if !defined(HAVE_LIBAV) && !defined(_WIN32)
-  if (dump_to_avi)
   {
-    WARN_LOG(VIDEO, "AVI frame dump requested, but Dolphin was compiled without libav. "
-      "Frame dump will be saved as images instead.");
-    dump_to_avi = false;
+    std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+    m_frame_dump_encoder_stop = false;
+    m_frame_dump_stats = {};
   }
-#endif
+  std::thread encoder_thread(&Renderer::RunFrameDumpEncoder, this);
 
   while (true)
   {
@@ -956,30 +964,139 @@ void Renderer::RunFrameDumps()
     }
 
     if (SConfig::GetInstance().m_DumpFrames)
+      QueueFrameDump(config);
+
+    m_frame_dump_done.Set();
+  }
+
+  // Let the encoder finish the frames that are still queued.
+  {
+    std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+    m_frame_dump_encoder_stop = true;
+  }
+  m_frame_dump_queued.notify_one();
+  encoder_thread.join();
+}
+
+void Renderer::QueueFrameDump(const FrameDumpConfig& config)
+{
+  // Limit the memory used by queued frames, but always allow a few so that the encoder and the
+  // GPU thread can work at the same time.
+  const size_t row_size = static_cast<size_t>(config.width) * 4;
+  const size_t frame_size = row_size * config.height;
+  const size_t max_frames = MathUtil::Clamp<size_t>(
+    MAX_FRAME_DUMP_QUEUE_MEMORY / std::max<size_t>(frame_size, 1), 2, MAX_QUEUED_FRAME_DUMPS);
+
+  std::vector<u8> buffer;
+  {
+    std::unique_lock<std::mutex> lock(m_frame_dump_queue_lock);
+    if (m_frame_dump_buffers_in_use >= max_frames)
     {
-      if (!frame_dump_started)
+      if (g_ActiveConfig.bDumpFramesDropWhenBehind)
       {
-        if (dump_to_avi)
-          frame_dump_started = StartFrameDumpToAVI(config);
-        else
-          frame_dump_started = StartFrameDumpToImage(config);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          SConfig::GetInstance().m_DumpFrames = false;
+        m_frame_dump_stats.frames_dropped++;
+        return;
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      m_frame_dump_stats.frames_blocked++;
+      m_frame_dump_freed.wait(lock, [&] { return m_frame_dump_buffers_in_use < max_frames; });
+    }
+
+    m_frame_dump_buffers_in_use++;
+    if (!m_frame_dump_free_buffers.empty())
+    {
+      buffer = std::move(m_frame_dump_free_buffers.back());
+      m_frame_dump_free_buffers.pop_back();
+    }
+  }
+
+  // The copy always ends up right side up and tightly packed.
+  buffer.resize(frame_size);
+  for (int y = 0; y < config.height; y++)
+    std::memcpy(&buffer[y * row_size], config.data + y * config.stride, row_size);
+
+  FrameDumpConfig queued_config = config;
+  queued_config.data = buffer.data();
+  queued_config.stride = static_cast<int>(row_size);
+  queued_config.upside_down = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+    m_frame_dump_queue.push_back({std::move(buffer), queued_config});
+    m_frame_dump_stats.frames_queued++;
+    m_frame_dump_stats.max_queue_depth =
+      std::max(m_frame_dump_stats.max_queue_depth, m_frame_dump_queue.size());
+  }
+  m_frame_dump_queued.notify_one();
+}
+
+void Renderer::RunFrameDumpEncoder()
+{
+  Common::SetCurrentThreadName("FrameDumpEncoder");
+  bool dump_to_avi = !g_ActiveConfig.bDumpFramesAsImages;
+  bool frame_dump_started = false;
+  bool frame_dump_failed = false;
+
+  // If Dolphin was compiled without libav, we only support dumping to images.
+#if !defined(HAVE_LIBAV) && !defined(_WIN32)
+  if (dump_to_avi)
+  {
+    WARN_LOG(VIDEO, "AVI frame dump requested, but Dolphin was compiled without libav. "
+      "Frame dump will be saved as images instead.");
+    dump_to_avi = false;
+  }
+#endif
+
+  while (true)
+  {
+    QueuedFrameDump frame;
+    {
+      std::unique_lock<std::mutex> lock(m_frame_dump_queue_lock);
+      m_frame_dump_queued.wait(lock, [this] {
+        return !m_frame_dump_queue.empty() || m_frame_dump_encoder_stop;
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+      frame = std::move(m_frame_dump_queue.front());
+      m_frame_dump_queue.pop_front();
+    }
+
+    if (!frame_dump_started && !frame_dump_failed)
+    {
+      if (dump_to_avi)
+        frame_dump_started = StartFrameDumpToAVI(frame.config);
+      else
+        frame_dump_started = StartFrameDumpToImage(frame.config);
+
+      // Stop frame dumping if we fail to start, and drop what is already queued.
+      if (!frame_dump_started)
       {
-        if (dump_to_avi)
-          DumpFrameToAVI(config);
-        else
-          DumpFrameToImage(config);
+        SConfig::GetInstance().m_DumpFrames = false;
+        frame_dump_failed = true;
       }
     }
 
-    m_frame_dump_done.Set();
+    if (frame_dump_started)
+    {
+      if (dump_to_avi)
+        DumpFrameToAVI(frame.config);
+      else
+        DumpFrameToImage(frame.config);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+      m_frame_dump_free_buffers.push_back(std::move(frame.data));
+      m_frame_dump_buffers_in_use--;
+    }
+    m_frame_dump_freed.notify_one();
+  }
+
+  FrameDumpStats dump_stats;
+  {
+    std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+    m_frame_dump_free_buffers.clear();
+    dump_stats = m_frame_dump_stats;
   }
 
   if (frame_dump_started)
@@ -987,9 +1104,24 @@ void Renderer::RunFrameDumps()
     // No additional cleanup is needed when dumping to images.
     if (dump_to_avi)
       StopFrameDumpToAVI();
+
+    NOTICE_LOG(VIDEO, "Frame dump: %" PRIu64 " frames, %" PRIu64 " dropped, %" PRIu64
+      " waited for the encoder, up to %zu queued", dump_stats.frames_queued,
+      dump_stats.frames_dropped, dump_stats.frames_blocked, dump_stats.max_queue_depth);
+    if (dump_stats.frames_dropped)
+    {
+      OSD::AddMessage(StringFromFormat("Frame dump fell behind, %" PRIu64 " frames dropped",
+        dump_stats.frames_dropped), OSD::Duration::VERY_LONG);
+    }
   }
 }
 
+Renderer::FrameDumpStats Renderer::GetFrameDumpStats() const
+{
+  std::lock_guard<std::mutex> lock(m_frame_dump_queue_lock);
+  return m_frame_dump_stats;
+}
+
 #if defined(HAVE_LIBAV) || defined(_WIN32)
 
 bool Renderer::StartFrameDumpToAVI(const FrameDumpConfig& config)
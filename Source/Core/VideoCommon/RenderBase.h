@@ -14,6 +14,7 @@
 
 #pragma once
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -126,6 +127,19 @@ public:
   void SaveScreenshot(const std::string& filename, bool wait_for_completion);
   void DrawDebugText();
 
+  // Counters for the current (or last) frame dump.
+  struct FrameDumpStats
+  {
+    u64 frames_queued = 0;
+    // Frames that weren't dumped because the encoder was too far behind (see
+    // bDumpFramesDropWhenBehind).
+    u64 frames_dropped = 0;
+    // Frames for which the GPU thread had to wait for the encoder to catch up.
+    u64 frames_blocked = 0;
+    size_t max_queue_depth = 0;
+  };
+  FrameDumpStats GetFrameDumpStats() const;
+
   virtual void RenderText(const std::string& str, int left, int top, u32 color) = 0;
 
   virtual void ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable, u32 color, u32 z) = 0;
@@ -193,6 +207,7 @@ protected:
   void* m_new_surface_handle = nullptr;
 private:
   void RunFrameDumps();
+  void RunFrameDumpEncoder();
   void ShutdownFrameDumping();
   PEControl::PixelFormat m_prev_efb_format = PEControl::INVALID_FMT;
   u32 m_efb_scale_numeratorX = 1;
@@ -224,7 +239,25 @@ private:
     AVIDump::Frame state;
   } m_frame_dump_config;
 
-  // NOTE: The methods below are called on the framedumping thread.
+  // Frames are copied out of the backend's readback buffer into a pooled buffer and queued, so
+  // that the GPU thread only has to wait for the copy and not for the encoder.
+  struct QueuedFrameDump
+  {
+    std::vector<u8> data;
+    FrameDumpConfig config;
+  };
+  void QueueFrameDump(const FrameDumpConfig& config);
+
+  mutable std::mutex m_frame_dump_queue_lock;
+  std::condition_variable m_frame_dump_queued;
+  std::condition_variable m_frame_dump_freed;
+  std::deque<QueuedFrameDump> m_frame_dump_queue;
+  std::vector<std::vector<u8>> m_frame_dump_free_buffers;
+  size_t m_frame_dump_buffers_in_use = 0;
+  bool m_frame_dump_encoder_stop = false;
+  FrameDumpStats m_frame_dump_stats;
+
+  // NOTE: The methods below are called on the frame dump encoder thread.
   bool StartFrameDumpToAVI(const FrameDumpConfig& config);
   void DumpFrameToAVI(const FrameDumpConfig& config);
   void StopFrameDumpToAVI();
@@ -0,0 +1,214 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/RoomUsageProfiler.h"
+
+#include <algorithm>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+
+namespace RoomUsage
+{
+static constexpr u32 GRAPH_MAGIC = 0x52475231;  // "RGR1"
+
+// How many of the rooms that followed a room are prepared when it is entered. Most rooms have
+// two or three doors, and the ones that were never used from a room aren't worth the memory.
+static constexpr size_t MAX_ROOMS_TO_PREPARE = 3;
+
+bool RoomGraph::Enter(RoomKey room)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const RoomKey previous = m_current_room.load(std::memory_order_relaxed);
+  if (previous == room)
+    return false;
+
+  if (previous != NO_ROOM && room != NO_ROOM)
+  {
+    u32& count = m_transitions[previous][room];
+    if (count != UINT32_MAX)
+      count++;
+  }
+  m_current_room.store(room, std::memory_order_release);
+  m_room_serial.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
+void RoomGraph::Leave()
+{
+  Enter(NO_ROOM);
+}
+
+std::vector<RoomKey> RoomGraph::GetNextRooms(RoomKey room, size_t max_count) const
+{
+  std::vector<std::pair<u32, RoomKey>> next;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_transitions.find(room);
+    if (it == m_transitions.end())
+      return {};
+    for (const auto& transition : it->second)
+      next.emplace_back(transition.second, transition.first);
+  }
+
+  // Most frequent first; ties are broken by the key so that the order doesn't change between runs.
+  std::sort(next.begin(), next.end(), [](const auto& a, const auto& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+  });
+
+  std::vector<RoomKey> result;
+  for (size_t i = 0; i < next.size() && i < max_count; i++)
+    result.push_back(next[i].second);
+  return result;
+}
+
+bool RoomGraph::IsEmpty() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_transitions.empty();
+}
+
+void RoomGraph::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_transitions.clear();
+  m_current_room.store(NO_ROOM, std::memory_order_release);
+  m_room_serial.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool RoomGraph::Save(const std::string& path) const
+{
+  File::IOFile file(path, "wb");
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  u32 count = 0;
+  for (const auto& from : m_transitions)
+    count += static_cast<u32>(from.second.size());
+  const u32 header[2] = {GRAPH_MAGIC, count};
+  if (!file.WriteArray(header, 2))
+    return false;
+
+  for (const auto& from : m_transitions)
+  {
+    for (const auto& to : from.second)
+    {
+      if (!file.WriteArray(&from.first, 1) || !file.WriteArray(&to.first, 1) ||
+          !file.WriteArray(&to.second, 1))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RoomGraph::Load(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  u32 header[2];
+  if (!file.ReadArray(header, 2) || header[0] != GRAPH_MAGIC)
+    return false;
+
+  decltype(m_transitions) transitions;
+  for (u32 i = 0; i < header[1]; i++)
+  {
+    RoomKey from, to;
+    u32 count;
+    if (!file.ReadArray(&from, 1) || !file.ReadArray(&to, 1) || !file.ReadArray(&count, 1))
+      return false;
+    transitions[from][to] = count;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_transitions = std::move(transitions);
+  return true;
+}
+
+static RoomGraph s_graph;
+static std::string s_graph_path;
+
+static std::mutex s_callback_mutex;
+static std::vector<std::pair<RoomChangedCallbackID, RoomChangedCallback>> s_callbacks;
+static RoomChangedCallbackID s_next_callback_id = 0;
+
+void Init(const std::string& game_id)
+{
+  s_graph.Clear();
+  s_graph_path = File::GetUserPath(D_CACHE_IDX) + game_id + ".rooms";
+  s_graph.Load(s_graph_path);
+}
+
+void Shutdown()
+{
+  LeaveRoom();
+  if (!s_graph_path.empty() && !s_graph.IsEmpty())
+  {
+    File::CreateFullPath(s_graph_path);
+    s_graph.Save(s_graph_path);
+  }
+  s_graph_path.clear();
+}
+
+void EnterRoom(u32 world, u32 area)
+{
+  const RoomKey room = MakeRoomKey(world, area);
+  if (!s_graph.Enter(room))
+    return;
+
+  // Copy the callbacks, so that they can add or remove callbacks themselves.
+  decltype(s_callbacks) callbacks;
+  {
+    std::lock_guard<std::mutex> lock(s_callback_mutex);
+    callbacks = s_callbacks;
+  }
+  for (const auto& callback : callbacks)
+    callback.second(room);
+}
+
+void LeaveRoom()
+{
+  s_graph.Leave();
+}
+
+RoomKey GetCurrentRoom()
+{
+  return s_graph.GetCurrentRoom();
+}
+
+u32 GetRoomSerial()
+{
+  return s_graph.GetRoomSerial();
+}
+
+std::vector<RoomKey> GetNextRooms(RoomKey room, size_t max_count)
+{
+  return s_graph.GetNextRooms(room, max_count);
+}
+
+std::vector<RoomKey> GetRoomsToPrepare(RoomKey room)
+{
+  if (room == NO_ROOM)
+    return {};
+
+  std::vector<RoomKey> rooms = GetNextRooms(room, MAX_ROOMS_TO_PREPARE);
+  rooms.insert(rooms.begin(), room);
+  return rooms;
+}
+
+RoomChangedCallbackID AddRoomChangedCallback(RoomChangedCallback callback)
+{
+  std::lock_guard<std::mutex> lock(s_callback_mutex);
+  const RoomChangedCallbackID id = s_next_callback_id++;
+  s_callbacks.emplace_back(id, std::move(callback));
+  return id;
+}
+
+void RemoveRoomChangedCallback(RoomChangedCallbackID id)
+{
+  std::lock_guard<std::mutex> lock(s_callback_mutex);
+  s_callbacks.erase(std::remove_if(s_callbacks.begin(), s_callbacks.end(),
+                                   [id](const auto& callback) { return callback.first == id; }),
+                    s_callbacks.end());
+}
+}  // namespace RoomUsage
@@ -0,0 +1,216 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Keeps track of the room the player is in and which objects (custom textures, shaders) each
+// room uses, so that what the player is likely to need next can be loaded in the background
+// before it is drawn for the first time.
+//
+// Rooms are identified by the game-specific code (e.g. the world and area IDs of the Prime games)
+// and the rooms that can follow a room are learned from the rooms the player actually walked
+// into from it, so nothing here knows about the layout of a game.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+
+namespace RoomUsage
+{
+using RoomKey = u64;
+constexpr RoomKey NO_ROOM = UINT64_MAX;
+
+constexpr RoomKey MakeRoomKey(u32 world, u32 area)
+{
+  return (static_cast<u64>(world) << 32) | area;
+}
+
+// The rooms of one game and how often the player went from one to the other.
+class RoomGraph
+{
+public:
+  // Returns false if room is already the current room.
+  bool Enter(RoomKey room);
+  void Leave();
+
+  RoomKey GetCurrentRoom() const { return m_current_room.load(std::memory_order_acquire); }
+  // Changes every time the player enters another room.
+  u32 GetRoomSerial() const { return m_room_serial.load(std::memory_order_acquire); }
+
+  // The rooms that were entered from room before, most frequent first.
+  std::vector<RoomKey> GetNextRooms(RoomKey room, size_t max_count) const;
+
+  bool IsEmpty() const;
+  void Clear();
+  bool Save(const std::string& path) const;
+  bool Load(const std::string& path);
+
+private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<RoomKey, std::unordered_map<RoomKey, u32>> m_transitions;
+  std::atomic<RoomKey> m_current_room{NO_ROOM};
+  std::atomic<u32> m_room_serial{0};
+};
+
+// The room graph of the running game. EnterRoom() can be called from any thread; the callbacks
+// run on the thread that called it and should only hand the work off to another thread.
+void Init(const std::string& game_id);
+void Shutdown();
+void EnterRoom(u32 world, u32 area);
+void LeaveRoom();
+RoomKey GetCurrentRoom();
+u32 GetRoomSerial();
+std::vector<RoomKey> GetNextRooms(RoomKey room, size_t max_count);
+
+using RoomChangedCallback = std::function<void(RoomKey room)>;
+using RoomChangedCallbackID = size_t;
+RoomChangedCallbackID AddRoomChangedCallback(RoomChangedCallback callback);
+void RemoveRoomChangedCallback(RoomChangedCallbackID id);
+
+// The rooms that should be prepared when the player is in room: the room itself first, then the
+// rooms most often entered from it.
+std::vector<RoomKey> GetRoomsToPrepare(RoomKey room);
+
+namespace detail
+{
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type
+WriteObject(File::IOFile& file, const T& obj)
+{
+  return file.WriteArray(&obj, 1);
+}
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type
+ReadObject(File::IOFile& file, T* obj)
+{
+  return file.ReadArray(obj, 1);
+}
+
+inline bool WriteObject(File::IOFile& file, const std::string& obj)
+{
+  const u32 size = static_cast<u32>(obj.size());
+  return file.WriteArray(&size, 1) && file.WriteBytes(obj.data(), size);
+}
+
+inline bool ReadObject(File::IOFile& file, std::string* obj)
+{
+  u32 size;
+  if (!file.ReadArray(&size, 1) || size > 0x10000)
+    return false;
+  obj->resize(size);
+  return file.ReadBytes(&(*obj)[0], size);
+}
+}  // namespace detail
+
+// Which objects each room uses. T has to be trivially copyable or a std::string to be saved.
+template <typename T, typename Hasher = std::hash<T>>
+class RoomUsageProfile
+{
+public:
+  explicit RoomUsageProfile(u64 version = 0) : m_version(version) {}
+
+  void Record(RoomKey room, const T& obj)
+  {
+    if (room == NO_ROOM)
+      return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rooms[room].insert(obj);
+  }
+
+  std::vector<T> Get(RoomKey room) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_rooms.find(room);
+    if (it == m_rooms.end())
+      return {};
+    return std::vector<T>(it->second.begin(), it->second.end());
+  }
+
+  size_t GetRoomCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rooms.size();
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rooms.clear();
+  }
+
+  bool Save(const std::string& path) const
+  {
+    File::IOFile file(path, "wb");
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const u32 header[2] = {PROFILE_MAGIC, static_cast<u32>(m_rooms.size())};
+    if (!file.WriteArray(&m_version, 1) || !file.WriteArray(header, 2))
+      return false;
+
+    for (const auto& room : m_rooms)
+    {
+      const u32 count = static_cast<u32>(room.second.size());
+      if (!file.WriteArray(&room.first, 1) || !file.WriteArray(&count, 1))
+        return false;
+      for (const T& obj : room.second)
+      {
+        if (!detail::WriteObject(file, obj))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  // Replaces the current profile. Files written with another version are ignored.
+  bool Load(const std::string& path)
+  {
+    File::IOFile file(path, "rb");
+    u64 version;
+    u32 header[2];
+    if (!file.ReadArray(&version, 1) || version != m_version || !file.ReadArray(header, 2) ||
+        header[0] != PROFILE_MAGIC)
+    {
+      return false;
+    }
+
+    decltype(m_rooms) rooms;
+    for (u32 i = 0; i < header[1]; i++)
+    {
+      RoomKey room;
+      u32 count;
+      if (!file.ReadArray(&room, 1) || !file.ReadArray(&count, 1))
+        return false;
+      auto& objects = rooms[room];
+      for (u32 j = 0; j < count; j++)
+      {
+        T obj;
+        if (!detail::ReadObject(file, &obj))
+          return false;
+        objects.insert(std::move(obj));
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rooms = std::move(rooms);
+    return true;
+  }
+
+private:
+  static constexpr u32 PROFILE_MAGIC = 0x52505531;  // "RPU1"
+
+  u64 m_version;
+  mutable std::mutex m_mutex;
+  std::unordered_map<RoomKey, std::unordered_set<T, Hasher>> m_rooms;
+};
+}  // namespace RoomUsage
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "Common/StringUtil.h"
+#include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -70,6 +71,15 @@ std::string Statistics::ToString()
   str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
   str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
   str += StringFromFormat("Vertex Loaders: %i\n", stats.numVertexLoaders);
+  if (g_ActiveConfig.bHiresTextures && g_ActiveConfig.bCacheHiresTextures)
+  {
+    const HiresTexture::CacheStats hires = HiresTexture::GetCacheStats();
+    str += StringFromFormat("Custom textures cached: %zu / %zu MB\n", hires.size / (1024 * 1024),
+                            hires.budget / (1024 * 1024));
+    str += StringFromFormat("Custom texture hits: %zu\n", hires.hits);
+    str += StringFromFormat("Custom texture misses: %zu\n", hires.misses);
+    str += StringFromFormat("Custom texture evictions: %zu\n", hires.evictions);
+  }
 
   std::string vertex_list;
   VertexLoaderManager::AppendListToString(&vertex_list);
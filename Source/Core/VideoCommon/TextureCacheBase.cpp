@@ -28,12 +28,17 @@
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureScalerCommon.h"
 #include "VideoCommon/TextureUtil.h"
+#include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/PrimePixelErrorTextures.h"
 
 static const u64 MAX_TEXTURE_BINARY_SIZE =
     1024 * 1024 * 4;  // 1024 x 1024 texel times 8 nibbles per texel
+// The RAM under a deferred EFB copy is hashed to notice it being overwritten. All of it is hashed
+// (0 samples), as a write that only sampling missed would be lost under the written back copy.
+// That is still a small fraction of what the readback costs.
+static const u32 DEFERRED_EFB_COPY_HASH_SAMPLES = 0;
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
 TextureCacheBase::TCacheEntry::TCacheEntry(std::unique_ptr<HostTexture> tex, bool material,
@@ -88,6 +93,7 @@ void TextureCacheBase::Invalidate()
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  m_upload_queue.Clear();
 }
 
 void TextureCacheBase::InvalidateByNames(std::vector<std::string>& base_names)
@@ -173,6 +179,8 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 
 void TextureCacheBase::Cleanup(s32 _frameCount)
 {
+  ProcessPendingUploads();
+
   s32 texture_kill_threshold = TEXTURE_KILL_THRESHOLD;
   if (texture_pool_memory_usage < (TEXTURE_POOL_MEMORY_LIMIT / 2))
   {
@@ -604,7 +612,8 @@ void TextureCacheBase::LoadEnviromentTexture(std::string basename)
     entry->is_efb_copy = false;
 
     int currentlayer = 0;
-    u8* Bufferptr = TextureCacheBase::temp;
+    // Cached textures are read straight from the cache.
+    const u8* Bufferptr = env_tex->m_cached_data ? env_tex->m_cached_data.get() : temp;
     for (size_t i = 0; i < 6; i++)
     {
       entry->texture->Load(Bufferptr, config.width, config.height, config.width, 0, currentlayer);
@@ -621,6 +630,54 @@ void TextureCacheBase::LoadEnviromentTexture(std::string basename)
   }
 }
 
+void TextureCacheBase::LoadHiresLevels(HostTexture* texture, const u8* data,
+                                       const TextureConfig& config, u32 expanded_width)
+{
+  for (u32 layer = 0; layer != config.layers; ++layer)
+  {
+    texture->Load(data, config.width, config.height, layer == 0 ? expanded_width : config.width,
+                  0, layer);
+    data += TextureUtil::GetTextureSizeInBytes(config.width, config.height, config.pcformat);
+    for (u32 level = 1; level != config.levels; ++level)
+    {
+      u32 mip_width = TextureUtil::CalculateLevelSize(config.width, level);
+      u32 mip_height = TextureUtil::CalculateLevelSize(config.height, level);
+      texture->Load(data, mip_width, mip_height, mip_width, level, layer);
+      data += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, config.pcformat);
+    }
+  }
+}
+
+void TextureCacheBase::ProcessPendingUploads()
+{
+  if (m_upload_queue.IsEmpty())
+    return;
+
+  // A budget of zero means deferral was switched off, so drain everything that is left.
+  const size_t budget = g_ActiveConfig.iHiresUploadBudget > 0 ?
+                            static_cast<size_t>(g_ActiveConfig.iHiresUploadBudget) * 1024 * 1024 :
+                            m_upload_queue.GetPendingBytes();
+  m_upload_queue.Process(budget, [this](const TextureUploadQueue::Upload& upload,
+                                        const u8* data) {
+    TCacheEntry* entry = static_cast<TCacheEntry*>(upload.owner);
+    // Swapping the texture would drop EFB copies already merged into the fallback.
+    if (!entry->references.empty())
+      return;
+
+    std::unique_ptr<HostTexture> texture = AllocateTexture(upload.config);
+    if (!texture)
+      return;
+
+    LoadHiresLevels(texture.get(), data, upload.config, upload.expanded_width);
+    DisposeTexture(entry->texture);
+    entry->texture = std::move(texture);
+    entry->material_map = upload.material_map;
+    entry->SetHiresParams(true, upload.basename, false, upload.emissive, upload.arbitrary_mips,
+                          false);
+  });
+  InvalidateAllBindPoints();
+}
+
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 {
   // if this stage was not invalidated by changes to texture registers, keep the current texture
@@ -729,6 +786,36 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   {
     full_hash = tex_hash;
   }
+
+  // Deferred EFB copies have to reach RAM before it is decoded, unless the copy's own VRAM entry
+  // is going to be used for this texture anyway.
+  if (!from_tmem && !m_deferred_efb_copies.empty())
+  {
+    const u32 range_size = texture_size + additional_mips_size;
+    bool resolved = false;
+    for (auto it = m_deferred_efb_copies.begin(); it != m_deferred_efb_copies.end();)
+    {
+      const TCacheEntry* entry = it->entry;
+      if (it->dst_addr >= address + range_size || it->dst_addr + it->covered_range <= address ||
+          (it->dst_addr == address && tex_hash == entry->hash && entry->native_width >= nativeW &&
+           entry->native_height >= nativeH))
+      {
+        ++it;
+        continue;
+      }
+      WriteBackDeferredEFBCopy(*it);
+      it = m_deferred_efb_copies.erase(it);
+      resolved = true;
+    }
+
+    if (resolved)
+    {
+      UpdateDeferredEFBCopyRange();
+      tex_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+      full_hash = isPaletteTexture ? tex_hash ^ tlut_hash : tex_hash;
+    }
+  }
+
   // Search the texture cache for textures by address
   //
   // Find all texture cache entries for the current texture address, and decide whether to use one
@@ -920,6 +1007,60 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       }
     }
   }
+  // Cached custom textures are uploaded straight from the cache, the others were loaded to temp.
+  const u8* hires_data = nullptr;
+  if (hires_tex)
+    hires_data = hires_tex->m_cached_data ? hires_tex->m_cached_data.get() : temp;
+  // Large custom textures are staged and uploaded over the following frames within the upload
+  // budget. Until then the entry is backed by the decoded game texture.
+  TextureUploadQueue::Upload deferred_upload;
+  std::shared_ptr<const u8> deferred_data;
+  size_t deferred_size = 0;
+  if (hires_tex && g_ActiveConfig.iHiresUploadBudget > 0)
+  {
+    TextureConfig hires_config;
+    hires_config.width = width;
+    hires_config.height = height;
+    hires_config.levels = hires_tex->m_levels;
+    hires_config.pcformat = pcfmt;
+    const bool hires_material_map =
+        hires_tex->m_nrm_levels && g_ActiveConfig.HiresMaterialMapsEnabled();
+    const bool hires_emissive =
+        hires_tex->m_lum_levels && g_ActiveConfig.HiresMaterialMapsEnabled();
+    hires_config.layers += hires_material_map ? 1 : 0;
+    hires_config.layers += hires_emissive ? 1 : 0;
+
+    size_t hires_size = TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
+    for (u32 level = 1; level != hires_config.levels; ++level)
+    {
+      const u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
+      const u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
+      hires_size += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
+    }
+    hires_size *= hires_config.layers;
+
+    // Cached textures don't need room in the staging ring, the upload keeps the texture alive.
+    if (hires_tex->m_cached_data)
+      deferred_data = std::shared_ptr<const u8>(hires_tex, hires_data);
+    if (hires_size >= TextureUploadQueue::MIN_DEFERRED_UPLOAD_SIZE &&
+        (deferred_data || m_upload_queue.CanPush(hires_size)))
+    {
+      deferred_upload.config = hires_config;
+      deferred_upload.expanded_width = expandedWidth;
+      deferred_upload.material_map = hires_material_map;
+      deferred_upload.emissive = hires_emissive;
+      deferred_upload.arbitrary_mips = hires_tex->has_arbitrary_mips;
+      deferred_upload.basename = basename;
+      deferred_size = hires_size;
+
+      hires_tex.reset();
+      width = nativeW;
+      height = nativeH;
+      expandedWidth = Common::AlignUpSizePow2(width, bsw);
+      expandedHeight = Common::AlignUpSizePow2(height, bsh);
+      pcfmt = PC_TEX_FMT_NONE;
+    }
+  }
   if (isPaletteTexture && !hires_tex)
   {
     g_texture_cache->LoadLut(tlutfmt, &texMem[tlutaddr], palette_size);
@@ -981,46 +1122,19 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   entry->SetHashes(full_hash, tex_hash);
   entry->is_efb_copy = false;
 
+  if (deferred_size != 0)
+  {
+    deferred_upload.owner = entry;
+    if (deferred_data)
+      m_upload_queue.Push(std::move(deferred_upload), std::move(deferred_data), deferred_size);
+    else
+      m_upload_queue.Push(std::move(deferred_upload), hires_data, deferred_size);
+  }
+
   // load texture
   if (hires_tex)
   {
-    int currentlayer = 0;
-    entry->texture->Load(TextureCacheBase::temp, width, height, expandedWidth, 0, currentlayer);
-    u8* Bufferptr = TextureCacheBase::temp;
-    Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
-    for (u32 level = 1; level != texLevels; ++level)
-    {
-      u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
-      u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-      entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
-      Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
-    }
-    if (materialmap)
-    {
-      currentlayer++;
-      entry->texture->Load(Bufferptr, width, height, width, 0, currentlayer);
-      Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
-      for (u32 level = 1; level != texLevels; ++level)
-      {
-        u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
-        u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-        entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
-        Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
-      }
-    }
-    if (emissivematerial)
-    {
-      currentlayer++;
-      entry->texture->Load(Bufferptr, width, height, width, 0, currentlayer);
-      Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
-      for (u32 level = 1; level != texLevels; ++level)
-      {
-        u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
-        u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-        entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
-        Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
-      }
-    }
+    LoadHiresLevels(entry->texture.get(), hires_data, config, expandedWidth);
   }
   else
   {
@@ -1548,11 +1662,25 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
       g_renderer->GetPostProcessor()->OnEFBCopy(&targetSource);
     }
   }
+  // Older deferred copies to this range must not be written back over the new one.
+  if (!m_deferred_efb_copies.empty())
+    SupersedeDeferredEFBCopies(dstAddr, covered_range);
+
+  u32 deferred_handle = 0;
   if (copy_to_ram)
   {
     EFBCopyFormat format(srcFormat, static_cast<TextureFormat>(dstFormat));
-    CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
-            scaleByHalf);
+    // Only unstrided copies are deferred, as only those are loaded straight from VRAM.
+    if (g_ActiveConfig.UseDeferredEFBCopies() && dstStride == bytes_per_row)
+    {
+      deferred_handle = EncodeEFBCopyDeferred(format, tex_w, bytes_per_row, num_blocks_y,
+                                              is_depth_copy, srcRect, scaleByHalf);
+    }
+    if (!deferred_handle)
+    {
+      CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
+              scaleByHalf);
+    }
   }
   else
   {
@@ -1615,6 +1743,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
     ++iter.first;
   }
 
+  TCacheEntry* entry = nullptr;
   if (copy_to_vram)
   {
     // create the texture
@@ -1626,7 +1755,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
     config.height = scaled_tex_h;
     config.layers = FramebufferManagerBase::GetEFBLayers();
 
-    TCacheEntry* entry = AllocateCacheEntry(config, false);
+    entry = AllocateCacheEntry(config, false);
 
     if (entry)
     {
@@ -1655,6 +1784,91 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
       textures_by_address.emplace(dstAddr, entry);
     }
   }
+
+  if (deferred_handle)
+  {
+    // Without a VRAM copy to stand in for it, the data has to go to RAM now.
+    if (!entry)
+    {
+      ReadBackEFBCopy(deferred_handle, dst, bytes_per_row, num_blocks_y, dstStride);
+      return;
+    }
+    m_deferred_efb_copies.push_back(
+        {deferred_handle, dstAddr, covered_range, bytes_per_row, num_blocks_y, dstStride,
+         GetHash64(dst, covered_range, DEFERRED_EFB_COPY_HASH_SAMPLES), entry});
+    UpdateDeferredEFBCopyRange();
+  }
+}
+
+void TextureCacheBase::ResolveDeferredEFBCopies(u32 address, u32 size)
+{
+  auto it = m_deferred_efb_copies.begin();
+  while (it != m_deferred_efb_copies.end())
+  {
+    if (it->dst_addr < address + size && it->dst_addr + it->covered_range > address)
+    {
+      WriteBackDeferredEFBCopy(*it);
+      it = m_deferred_efb_copies.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  UpdateDeferredEFBCopyRange();
+}
+
+void TextureCacheBase::SupersedeDeferredEFBCopies(u32 address, u32 size)
+{
+  auto it = m_deferred_efb_copies.begin();
+  while (it != m_deferred_efb_copies.end())
+  {
+    if (it->dst_addr >= address + size || it->dst_addr + it->covered_range <= address)
+    {
+      ++it;
+      continue;
+    }
+
+    if (it->dst_addr >= address && it->dst_addr + it->covered_range <= address + size)
+      ReleaseEFBCopy(it->handle);
+    else
+      WriteBackDeferredEFBCopy(*it);
+    it = m_deferred_efb_copies.erase(it);
+  }
+  UpdateDeferredEFBCopyRange();
+}
+
+void TextureCacheBase::WriteBackDeferredEFBCopy(const DeferredEFBCopy& copy)
+{
+  // If the CPU or a DMA replaced the memory in the meantime, that data is newer than the copy.
+  u8* dst = Memory::GetPointer(copy.dst_addr);
+  if (!dst ||
+      GetHash64(dst, copy.covered_range, DEFERRED_EFB_COPY_HASH_SAMPLES) != copy.ram_hash)
+  {
+    ReleaseEFBCopy(copy.handle);
+    return;
+  }
+
+  ReadBackEFBCopy(copy.handle, dst, copy.bytes_per_row, copy.num_blocks_y, copy.memory_stride);
+
+  // The VRAM copy is still valid, make sure Load doesn't mistake the new RAM contents for a change.
+  if (copy.entry)
+  {
+    const u64 hash = copy.entry->CalculateHash();
+    copy.entry->SetHashes(hash, hash);
+  }
+}
+
+void TextureCacheBase::UpdateDeferredEFBCopyRange()
+{
+  u32 begin = 0;
+  u32 end = 0;
+  for (const DeferredEFBCopy& copy : m_deferred_efb_copies)
+  {
+    begin = end == 0 ? copy.dst_addr : std::min(begin, copy.dst_addr);
+    end = std::max(end, copy.dst_addr + copy.covered_range);
+  }
+  g_video_backend->SetDeferredEFBCopyRange(begin, end);
 }
 
 std::unique_ptr<HostTexture> TextureCacheBase::AllocateTexture(const TextureConfig& config)
@@ -1700,6 +1914,23 @@ void TextureCacheBase::DisposeTexture(std::unique_ptr<HostTexture>& texture)
 
 void TextureCacheBase::DisposeCacheEntry(TCacheEntry* entry)
 {
+  m_upload_queue.Cancel(entry);
+
+  // Nothing will stand in for a deferred EFB copy once its VRAM copy is gone.
+  if (entry->is_efb_copy)
+  {
+    auto copy = std::find_if(m_deferred_efb_copies.begin(), m_deferred_efb_copies.end(),
+                             [entry](const DeferredEFBCopy& c) { return c.entry == entry; });
+    if (copy != m_deferred_efb_copies.end())
+    {
+      DeferredEFBCopy resolved = *copy;
+      resolved.entry = nullptr;
+      m_deferred_efb_copies.erase(copy);
+      WriteBackDeferredEFBCopy(resolved);
+      UpdateDeferredEFBCopyRange();
+    }
+  }
+
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
     textures_by_hash.erase(entry->textures_by_hash_iter);
@@ -20,6 +20,7 @@
 #include "VideoCommon/HostTexture.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureUploadQueue.h"
 #include "VideoCommon/VideoCommon.h"
 
 struct VideoConfig;
@@ -157,6 +158,20 @@ public:
   virtual void CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
                        u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
                        const EFBRectangle& src_rect, bool scale_by_half) = 0;
+  // Deferred EFB copies: encodes like CopyEFB, but leaves the result in a staging buffer without
+  // waiting for the GPU. Returns 0 if the backend can't (currently) do this.
+  virtual u32 EncodeEFBCopyDeferred(const EFBCopyFormat& format, u32 native_width,
+                                    u32 bytes_per_row, u32 num_blocks_y, bool is_depth_copy,
+                                    const EFBRectangle& src_rect, bool scale_by_half)
+  {
+    return 0;
+  }
+  // Waits for a deferred copy and writes it to dst. Both this and ReleaseEFBCopy free the handle.
+  virtual void ReadBackEFBCopy(u32 handle, u8* dst, u32 bytes_per_row, u32 num_blocks_y,
+                               u32 memory_stride)
+  {
+  }
+  virtual void ReleaseEFBCopy(u32 handle) {}
 
   virtual bool CompileShaders() = 0;  // currently only implemented by OGL
   virtual void DeleteShaders() = 0;   // currently only implemented by OGL
@@ -171,6 +186,8 @@ public:
   void LoadEnviromentTexture(std::string basename);
   void CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32 dstStride, bool is_depth_copy,
                                  const EFBRectangle& srcRect, bool isIntensity, bool scaleByHalf);
+  // Writes deferred EFB copies overlapping [address, address + size) to RAM.
+  void ResolveDeferredEFBCopies(u32 address, u32 size);
   u8* GetTemporalBuffer() { return temp; }
   // Returns true if the texture data and palette formats are supported by the GPU decoder.
   virtual bool SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format)
@@ -224,6 +241,21 @@ private:
     EnvCacheEntry(TCacheEntry* tex) : envtexture(tex) {}
   };
 
+  // An EFB copy that went to VRAM right away but has not been written to RAM yet. RAM keeps its
+  // previous contents until something other than the copy's own cache entry reads it.
+  struct DeferredEFBCopy
+  {
+    u32 handle;
+    u32 dst_addr;
+    u32 covered_range;
+    u32 bytes_per_row;
+    u32 num_blocks_y;
+    u32 memory_stride;
+    // Sampled hash of the RAM range at copy time; if it changed, the copy was overwritten.
+    u64 ram_hash;
+    TCacheEntry* entry;
+  };
+
   using TexAddrCache = std::multimap<u32, TCacheEntry*>;
   using TexHashCache = std::multimap<u64, TCacheEntry*>;
   using EnviromentCache = std::unordered_map<std::string, EnvCacheEntry>;
@@ -237,6 +269,17 @@ private:
                                        u32 palette_size);
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, u32 tlutaddr, u32 tlutfmt, u32 palette_size);
   void DumpTexture(TCacheEntry* entry, std::string basename, u32 level);
+  // Uploads all levels and material layers of a custom texture laid out contiguously in data.
+  void LoadHiresLevels(HostTexture* texture, const u8* data, const TextureConfig& config,
+                       u32 expanded_width);
+  // Promotes deferred custom textures, limited by the per-frame upload budget.
+  void ProcessPendingUploads();
+
+  void WriteBackDeferredEFBCopy(const DeferredEFBCopy& copy);
+  // Drops deferred copies that a new copy to [address, address + size) fully replaces, and
+  // writes back the ones it only partially overlaps.
+  void SupersedeDeferredEFBCopies(u32 address, u32 size);
+  void UpdateDeferredEFBCopyRange();
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config, bool materialmap = false,
                                   bool luma = false);
@@ -257,6 +300,8 @@ private:
   EnviromentCache enviroment_cache;
   TexPool texture_pool;
   size_t texture_pool_memory_usage = {};
+  TextureUploadQueue m_upload_queue;
+  std::vector<DeferredEFBCopy> m_deferred_efb_copies;
 
   // Backup configuration values
   struct BackupConfig
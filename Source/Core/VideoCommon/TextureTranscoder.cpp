@@ -0,0 +1,398 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureTranscoder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include <SOIL/SOIL.h>
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace TextureTranscoder
+{
+static constexpr u32 CACHE_MAGIC = 0x33434254;  // "TBC3"
+static constexpr u32 CACHE_VERSION = 1;
+
+struct CacheHeader  // 32 bytes
+{
+  u32 magic;
+  u32 version;
+  u64 hash;
+  u32 width;
+  u32 height;
+  u32 data_size;
+  u32 reserved;
+};
+
+// PNG files that wait to be encoded. If more than this is queued, textures are only queued again
+// when they are loaded the next time, rather than holding on to all of a pack at once.
+static constexpr size_t MAX_QUEUED_BYTES = 64 * 1024 * 1024;
+
+struct QueuedImage
+{
+  u64 hash;
+  std::vector<u8> png;
+};
+
+static std::thread s_worker;
+static std::mutex s_queue_mutex;
+static std::condition_variable s_queue_wake;
+static std::deque<QueuedImage> s_queue;
+static size_t s_queued_bytes = 0;
+static bool s_stop = false;
+// Images that were queued this session, so that images that are loaded again before they are
+// encoded, or that can't be decoded, aren't queued over and over.
+static std::unordered_set<u64> s_queued_hashes;
+
+static std::mutex s_store_mutex;
+static size_t s_stored_count = 0;
+static size_t s_stored_rgba_bytes = 0;
+static size_t s_stored_bc3_bytes = 0;
+
+static std::string GetCachePath(u64 hash)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "HiresTextures" DIR_SEP +
+         StringFromFormat("%016" PRIx64 ".bc3", hash);
+}
+
+static void EncodeWorker()
+{
+  Common::SetCurrentThreadName("Texture Transcoder");
+
+  while (true)
+  {
+    QueuedImage image;
+    {
+      std::unique_lock<std::mutex> lk(s_queue_mutex);
+      s_queue_wake.wait(lk, [] { return s_stop || !s_queue.empty(); });
+      // Whatever is still queued is encoded when it is loaded the next time.
+      if (s_stop)
+        return;
+      image = std::move(s_queue.front());
+      s_queue.pop_front();
+      s_queued_bytes -= image.png.size();
+    }
+
+    int width, height, channels;
+    u8* rgba = SOIL_load_image_from_memory(image.png.data(), static_cast<int>(image.png.size()),
+                                           &width, &height, &channels, SOIL_LOAD_RGBA);
+    if (!rgba)
+      continue;
+
+    std::vector<u8> encoded(GetBC3Size(width, height));
+    EncodeBC3(rgba, width, height, encoded.data());
+    SOIL_free_image_data(rgba);
+    Store(image.hash, width, height, encoded.data(), encoded.size());
+  }
+}
+
+void Init()
+{
+  if (s_worker.joinable())
+    return;
+
+  s_stop = false;
+  s_worker = std::thread(EncodeWorker);
+}
+
+void Shutdown()
+{
+  if (s_worker.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lk(s_queue_mutex);
+      s_stop = true;
+    }
+    s_queue_wake.notify_one();
+    s_worker.join();
+  }
+
+  s_queue.clear();
+  s_queued_bytes = 0;
+  s_queued_hashes.clear();
+
+  std::lock_guard<std::mutex> lk(s_store_mutex);
+  if (s_stored_count)
+  {
+    INFO_LOG(VIDEO, "Transcoded %zu custom textures from %.1f MB of RGBA8 to %.1f MB of BC3",
+             s_stored_count, s_stored_rgba_bytes / (1024.0 * 1024.0),
+             s_stored_bc3_bytes / (1024.0 * 1024.0));
+  }
+  s_stored_count = 0;
+  s_stored_rgba_bytes = 0;
+  s_stored_bc3_bytes = 0;
+}
+
+bool IsEnabled()
+{
+  // Building material maps needs the normal maps as RGBA8.
+  return g_ActiveConfig.bCompressHiresTextures && !g_ActiveConfig.bHiresMaterialMapsBuild &&
+         g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_DXT5];
+}
+
+u64 HashImageFile(const u8* data, size_t size)
+{
+  return XXH64(data, size, 0);
+}
+
+bool LoadCached(u64 hash,
+                const std::function<u8*(u32 width, u32 height, size_t size)>& request_buffer)
+{
+  File::IOFile file(GetCachePath(hash), "rb");
+  CacheHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != CACHE_MAGIC ||
+      header.version != CACHE_VERSION || header.hash != hash ||
+      header.data_size != GetBC3Size(header.width, header.height) ||
+      file.GetSize() != sizeof(header) + header.data_size)
+  {
+    return false;
+  }
+
+  u8* dst = request_buffer(header.width, header.height, header.data_size);
+  return dst && file.ReadBytes(dst, header.data_size);
+}
+
+void Queue(u64 hash, const u8* png_data, size_t png_size)
+{
+  {
+    std::lock_guard<std::mutex> lk(s_queue_mutex);
+    if (!s_worker.joinable() || s_queued_bytes + png_size > MAX_QUEUED_BYTES ||
+        !s_queued_hashes.insert(hash).second)
+    {
+      return;
+    }
+    s_queue.push_back({hash, std::vector<u8>(png_data, png_data + png_size)});
+    s_queued_bytes += png_size;
+  }
+  s_queue_wake.notify_one();
+}
+
+void Store(u64 hash, u32 width, u32 height, const u8* data, size_t data_size)
+{
+  const std::string path = GetCachePath(hash);
+  const std::string temp_path = path + ".tmp";
+
+  std::lock_guard<std::mutex> lk(s_store_mutex);
+  if (File::Exists(path))
+    return;
+
+  // Write to another file first, so that a texture is never read while it is being written.
+  File::CreateFullPath(path);
+  {
+    File::IOFile file(temp_path, "wb");
+    const CacheHeader header = {CACHE_MAGIC, CACHE_VERSION, hash, width, height,
+                                static_cast<u32>(data_size), 0};
+    if (!file.WriteArray(&header, 1) || !file.WriteBytes(data, data_size))
+    {
+      file.Close();
+      File::Delete(temp_path);
+      return;
+    }
+  }
+  if (!File::Rename(temp_path, path))
+    return;
+
+  s_stored_count++;
+  s_stored_rgba_bytes += static_cast<size_t>(width) * height * 4;
+  s_stored_bc3_bytes += data_size;
+}
+
+size_t GetBC3Size(u32 width, u32 height)
+{
+  return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
+
+bool IsValidBaseLevelSize(u32 width, u32 height)
+{
+  return width % 4 == 0 && height % 4 == 0;
+}
+
+// The encoder below fits the end points to the bounding box of each block, which is nowhere near
+// as good as what texture tools do offline, but fast enough to keep up with loading a pack and good
+// enough for the color maps most packs consist of.
+
+static u16 To565(const u8* rgb)
+{
+  const u32 r = (rgb[0] * 31 + 127) / 255;
+  const u32 g = (rgb[1] * 63 + 127) / 255;
+  const u32 b = (rgb[2] * 31 + 127) / 255;
+  return static_cast<u16>((r << 11) | (g << 5) | b);
+}
+
+static void From565(u16 color, u8* rgb)
+{
+  const u32 r = color >> 11;
+  const u32 g = (color >> 5) & 0x3f;
+  const u32 b = color & 0x1f;
+  rgb[0] = static_cast<u8>((r << 3) | (r >> 2));
+  rgb[1] = static_cast<u8>((g << 2) | (g >> 4));
+  rgb[2] = static_cast<u8>((b << 3) | (b >> 2));
+}
+
+static void EncodeAlphaBlock(const u8 (&block)[16][4], u8* dst)
+{
+  u8 min = 255;
+  u8 max = 0;
+  for (const auto& pixel : block)
+  {
+    min = std::min(min, pixel[3]);
+    max = std::max(max, pixel[3]);
+  }
+
+  dst[0] = max;
+  dst[1] = min;
+  std::memset(dst + 2, 0, 6);
+  if (min == max)
+    return;
+
+  // With alpha0 > alpha1, there are 6 interpolated values between them.
+  u8 palette[8] = {max, min};
+  for (int i = 2; i < 8; i++)
+    palette[i] = static_cast<u8>(((8 - i) * max + (i - 1) * min) / 7);
+
+  u64 indices = 0;
+  for (int i = 0; i < 16; i++)
+  {
+    int best = 0;
+    int best_error = 256;
+    for (int j = 0; j < 8; j++)
+    {
+      const int error = std::abs(block[i][3] - palette[j]);
+      if (error < best_error)
+      {
+        best = j;
+        best_error = error;
+      }
+    }
+    indices |= static_cast<u64>(best) << (3 * i);
+  }
+  for (int i = 0; i < 6; i++)
+    dst[2 + i] = static_cast<u8>(indices >> (8 * i));
+}
+
+static void EncodeColorBlock(const u8 (&block)[16][4], u8* dst)
+{
+  u8 min[3] = {255, 255, 255};
+  u8 max[3] = {0, 0, 0};
+  for (const auto& pixel : block)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      min[c] = std::min(min[c], pixel[c]);
+      max[c] = std::max(max[c], pixel[c]);
+    }
+  }
+
+  // Move the end points inwards a little, as the colors at the very edges of the box are rare.
+  for (int c = 0; c < 3; c++)
+  {
+    const u8 inset = (max[c] - min[c]) / 16;
+    min[c] += inset;
+    max[c] -= inset;
+  }
+
+  // The end points are opposite corners of the box. Pick the diagonal that follows the colors of
+  // the block: if green or blue get smaller where red gets larger, swap them.
+  int covariance[3] = {};
+  for (const auto& pixel : block)
+  {
+    const int red = 2 * pixel[0] - min[0] - max[0];
+    for (int c = 1; c < 3; c++)
+      covariance[c] += red * (2 * pixel[c] - min[c] - max[c]);
+  }
+  for (int c = 1; c < 3; c++)
+  {
+    if (covariance[c] < 0)
+      std::swap(min[c], max[c]);
+  }
+
+  // BC3 always uses the four color mode, so the order of the end points doesn't matter.
+  const u16 color0 = To565(max);
+  const u16 color1 = To565(min);
+
+  u32 indices = 0;
+  if (color0 != color1)
+  {
+    u8 palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+      palette[2][c] = static_cast<u8>((2 * palette[0][c] + palette[1][c]) / 3);
+      palette[3][c] = static_cast<u8>((palette[0][c] + 2 * palette[1][c]) / 3);
+    }
+
+    for (int i = 0; i < 16; i++)
+    {
+      int best = 0;
+      int best_error = INT32_MAX;
+      for (int j = 0; j < 4; j++)
+      {
+        int error = 0;
+        for (int c = 0; c < 3; c++)
+        {
+          const int diff = block[i][c] - palette[j][c];
+          error += diff * diff;
+        }
+        if (error < best_error)
+        {
+          best = j;
+          best_error = error;
+        }
+      }
+      indices |= static_cast<u32>(best) << (2 * i);
+    }
+  }
+
+  dst[0] = static_cast<u8>(color0);
+  dst[1] = static_cast<u8>(color0 >> 8);
+  dst[2] = static_cast<u8>(color1);
+  dst[3] = static_cast<u8>(color1 >> 8);
+  for (int i = 0; i < 4; i++)
+    dst[4 + i] = static_cast<u8>(indices >> (8 * i));
+}
+
+void EncodeBC3(const u8* src, u32 width, u32 height, u8* dst)
+{
+  for (u32 block_y = 0; block_y < height; block_y += 4)
+  {
+    for (u32 block_x = 0; block_x < width; block_x += 4)
+    {
+      u8 block[16][4];
+      for (u32 y = 0; y < 4; y++)
+      {
+        const u32 src_y = std::min(block_y + y, height - 1);
+        for (u32 x = 0; x < 4; x++)
+        {
+          const u32 src_x = std::min(block_x + x, width - 1);
+          std::memcpy(block[y * 4 + x], src + (static_cast<size_t>(src_y) * width + src_x) * 4, 4);
+        }
+      }
+
+      EncodeAlphaBlock(block, dst);
+      EncodeColorBlock(block, dst + 8);
+      dst += 16;
+    }
+  }
+}
+}  // namespace TextureTranscoder
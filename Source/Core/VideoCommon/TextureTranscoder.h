@@ -0,0 +1,51 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Converts custom textures that were shipped as PNG to BC3 (DXT5), which takes a quarter of the
+// memory and upload bandwidth of RGBA8. As encoding is too slow to do while a texture is needed,
+// textures are encoded on a background thread the first time they are loaded, and kept in a disk
+// cache that is keyed on the contents of the PNG file. Later loads read the encoded texture from
+// the cache instead of decoding the PNG.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace TextureTranscoder
+{
+void Init();
+void Shutdown();
+
+// Whether PNG textures should be replaced with their BC3 versions. Needs the setting to be enabled
+// and a backend that supports BC3 textures.
+bool IsEnabled();
+
+u64 HashImageFile(const u8* data, size_t size);
+
+// Reads the encoded texture for the PNG file with the given hash from the disk cache, into the
+// buffer returned by request_buffer. If request_buffer returns nullptr, nothing is read.
+bool LoadCached(u64 hash,
+                const std::function<u8*(u32 width, u32 height, size_t size)>& request_buffer);
+
+// Encodes the PNG file with the given hash on the background thread and adds it to the disk cache.
+void Queue(u64 hash, const u8* png_data, size_t png_size);
+
+// Adds a texture that was already encoded to the disk cache.
+void Store(u64 hash, u32 width, u32 height, const u8* data, size_t data_size);
+
+size_t GetBC3Size(u32 width, u32 height);
+
+// Backends can only create BC3 textures if the first level is made of whole blocks, so other
+// images are only transcoded when they are smaller levels of a texture.
+bool IsValidBaseLevelSize(u32 width, u32 height);
+
+// Encodes an RGBA8 image with the given size and a pitch of width * 4 bytes to BC3. dst has to be
+// GetBC3Size(width, height) bytes. Images that aren't a multiple of 4 in size are padded by
+// repeating the last row and column.
+void EncodeBC3(const u8* src, u32 width, u32 height, u8* dst);
+}  // namespace TextureTranscoder
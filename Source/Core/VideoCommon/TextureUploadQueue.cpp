@@ -0,0 +1,101 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureUploadQueue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+bool TextureUploadQueue::Allocate(size_t size, size_t* offset) const
+{
+  if (size > STAGING_RING_SIZE)
+    return false;
+
+  const auto uses_ring = [](const Upload& upload) { return !upload.data; };
+  const auto oldest = std::find_if(m_uploads.begin(), m_uploads.end(), uses_ring);
+  if (oldest == m_uploads.end())
+  {
+    *offset = 0;
+    return true;
+  }
+  const auto newest = std::find_if(m_uploads.rbegin(), m_uploads.rend(), uses_ring);
+
+  // Space is released in submission order (cancelled uploads stay in the queue until they reach
+  // the front), so the live region always runs from the oldest to the newest upload in the ring.
+  const size_t tail = oldest->offset;
+  const size_t head = newest->offset + newest->size;
+  if (head > tail)
+  {
+    if (STAGING_RING_SIZE - head >= size)
+    {
+      *offset = head;
+      return true;
+    }
+    if (tail >= size)
+    {
+      *offset = 0;
+      return true;
+    }
+    return false;
+  }
+
+  if (tail - head >= size)
+  {
+    *offset = head;
+    return true;
+  }
+  return false;
+}
+
+bool TextureUploadQueue::Push(Upload upload, const u8* data, size_t size)
+{
+  size_t offset;
+  if (!Allocate(size, &offset))
+    return false;
+
+  // The ring is allocated on first use and kept for the lifetime of the texture cache.
+  if (m_ring.empty())
+    m_ring.resize(STAGING_RING_SIZE);
+
+  std::memcpy(m_ring.data() + offset, data, size);
+  upload.offset = offset;
+  upload.size = size;
+  m_uploads.push_back(std::move(upload));
+  m_pending_bytes += size;
+  return true;
+}
+
+void TextureUploadQueue::Push(Upload upload, std::shared_ptr<const u8> data, size_t size)
+{
+  upload.data = std::move(data);
+  upload.offset = 0;
+  upload.size = size;
+  m_uploads.push_back(std::move(upload));
+  m_pending_bytes += size;
+}
+
+bool TextureUploadQueue::CanPush(size_t size) const
+{
+  size_t offset;
+  return Allocate(size, &offset);
+}
+
+void TextureUploadQueue::Cancel(const void* owner)
+{
+  for (Upload& upload : m_uploads)
+  {
+    if (upload.owner != owner)
+      continue;
+
+    upload.owner = nullptr;
+    m_pending_bytes -= upload.size;
+  }
+}
+
+void TextureUploadQueue::Clear()
+{
+  m_uploads.clear();
+  m_pending_bytes = 0;
+}
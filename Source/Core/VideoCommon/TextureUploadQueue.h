@@ -0,0 +1,87 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+#include "VideoCommon/TextureConfig.h"
+
+// Defers large texture uploads so that only a limited amount of data is handed to the driver
+// each frame. Texture data is copied into a persistent staging ring when the texture is first
+// requested, unless it is kept in memory anyway (e.g. cached custom textures), in which case the
+// upload holds on to the data instead. The owner keeps using a fallback texture until its upload
+// is processed.
+class TextureUploadQueue
+{
+public:
+  struct Upload
+  {
+    void* owner = nullptr;
+    TextureConfig config;
+    u32 expanded_width = 0;
+    bool material_map = false;
+    bool emissive = false;
+    bool arbitrary_mips = false;
+    std::string basename;
+
+    // If set, the upload reads from here instead of the staging ring.
+    std::shared_ptr<const u8> data;
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  // Uploads smaller than this are cheap enough to do immediately.
+  static constexpr size_t MIN_DEFERRED_UPLOAD_SIZE = 512 * 1024;
+  static constexpr size_t STAGING_RING_SIZE = 64 * 1024 * 1024;
+
+  // Copies size bytes of data into the staging ring and queues the upload. Returns false if the
+  // ring does not have enough room, in which case the caller should upload synchronously.
+  bool Push(Upload upload, const u8* data, size_t size);
+  // Queues the upload without copying data, which has to stay unchanged until it is processed.
+  void Push(Upload upload, std::shared_ptr<const u8> data, size_t size);
+  bool CanPush(size_t size) const;
+
+  // Drops any queued upload belonging to owner.
+  void Cancel(const void* owner);
+  void Clear();
+
+  bool IsEmpty() const { return m_uploads.empty(); }
+  size_t GetPendingBytes() const { return m_pending_bytes; }
+
+  // Hands queued uploads to func in submission order until budget bytes have been processed.
+  // At least one upload is processed per call so that oversized textures cannot stall the queue.
+  template <typename Func>
+  void Process(size_t budget, Func func)
+  {
+    size_t processed = 0;
+    while (!m_uploads.empty())
+    {
+      const Upload& upload = m_uploads.front();
+      if (upload.owner)
+      {
+        if (processed != 0 && processed + upload.size > budget)
+          break;
+
+        func(upload, upload.data ? upload.data.get() : m_ring.data() + upload.offset);
+        processed += upload.size;
+        m_pending_bytes -= upload.size;
+      }
+      m_uploads.pop_front();
+    }
+  }
+
+private:
+  bool Allocate(size_t size, size_t* offset) const;
+
+  std::vector<u8> m_ring;
+  std::deque<Upload> m_uploads;
+  size_t m_pending_bytes = 0;
+};
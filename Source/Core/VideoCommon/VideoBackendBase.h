@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -99,6 +101,33 @@ public:
   u32 Video_AccessEFB(EFBAccessType, u32, u32, u32);
   u32 Video_GetQueryResult(PerfQueryType type);
   u16 Video_GetBoundingBox(int index);
+  // Writes back deferred EFB copies overlapping the given physical range and waits for them.
+  void Video_ResolveDeferredEFBCopies(u32 address, u32 size);
+
+  // Bounds of the physical memory covered by deferred EFB copies, maintained by the texture
+  // cache. Checked by the CPU thread on every slow memory access, so it is lock-free and coarse.
+  bool HasDeferredEFBCopies(u32 address, u32 size) const
+  {
+    return address < m_deferred_efb_copies_end.load(std::memory_order_relaxed) &&
+           address + size > m_deferred_efb_copies_begin.load(std::memory_order_relaxed);
+  }
+  void SetDeferredEFBCopyRange(u32 begin, u32 end)
+  {
+    m_deferred_efb_copies_begin.store(begin, std::memory_order_relaxed);
+    m_deferred_efb_copies_end.store(end, std::memory_order_relaxed);
+  }
+
+  // Full-EFB snapshot used to answer peeks without a GPU round-trip. Backends fill it on the GPU
+  // thread while servicing a peek (the CPU thread is blocked then), and it stays valid until the
+  // EFB is drawn to, cleared or poked. Returns the EFB_WIDTH * EFB_HEIGHT buffer to fill.
+  u32* BeginEFBPeekSnapshot(EFBAccessType type);
+  void EndEFBPeekSnapshot(EFBAccessType type, u32 pixel_format);
+  void InvalidateEFBPeekSnapshot()
+  {
+    m_efb_peek_generation.fetch_add(1, std::memory_order_acq_rel);
+  }
+  // Returns the peek result for (x, y) if a valid snapshot covers it.
+  bool PeekEFBSnapshot(EFBAccessType type, u32 x, u32 y, u32* value) const;
 
   static void PopulateList();
   static void ClearList();
@@ -122,6 +151,18 @@ protected:
   u32 m_EFB_PCache_Divisor;
   u32 m_EFB_PCache_Life;
   EFBPeekCacheElement* m_EFB_PCache;
+  std::atomic<u32> m_deferred_efb_copies_begin{0};
+  std::atomic<u32> m_deferred_efb_copies_end{0};
+
+  struct EFBPeekSnapshot
+  {
+    std::vector<u32> values;
+    u32 pixel_format = 0;
+    // Matches m_efb_peek_generation while the snapshot is valid.
+    std::atomic<u32> generation{0};
+  };
+  std::array<EFBPeekSnapshot, 2> m_efb_peek_snapshots;
+  std::atomic<u32> m_efb_peek_generation{1};
 };
 
 extern std::vector<std::unique_ptr<VideoBackendBase>> g_available_video_backends;
@@ -102,8 +102,13 @@ void VideoConfig::Refresh()
   bHiresMaterialMapsBuild = Config::Get(Config::GFX_HIRES_MATERIAL_MAPS_BUILD);  
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);  
   bWaitForCacheHiresTextures = Config::Get(Config::GFX_WAIT_CACHE_HIRES_TEXTURES);  
+  iHiresUploadBudget = Config::Get(Config::GFX_HIRES_UPLOAD_BUDGET);
+  iHiresRoomPrefetchBudget = Config::Get(Config::GFX_HIRES_ROOM_PREFETCH_BUDGET);
+  iHiresTextureCacheBudget = Config::Get(Config::GFX_HIRES_TEXTURE_CACHE_BUDGET);
+  bCompressHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURE_COMPRESSION);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
+  bDumpFramesDropWhenBehind = Config::Get(Config::GFX_DUMP_FRAMES_DROP_WHEN_BEHIND);
   bFreeLook = Config::Get(Config::GFX_FREE_LOOK);
   bCompileShaderOnStartup = Config::Get(Config::GFX_COMPILE_SHADERS_ON_STARTUP);
   bUseFFV1 = Config::Get(Config::GFX_USE_FFV1);
@@ -194,6 +199,7 @@ void VideoConfig::Refresh()
   iBBoxMode = Config::Get(Config::GFX_HACK_BBOX_MODE);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  bDeferEFBCopies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_SCALED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUDING);
@@ -170,8 +170,13 @@ struct VideoConfig final
   bool bHiresMaterialMapsBuild;
   bool bCacheHiresTextures;
   bool bWaitForCacheHiresTextures;
+  int iHiresUploadBudget;  // MB of custom texture data uploaded per frame, 0 = unlimited
+  int iHiresRoomPrefetchBudget;  // MB of custom textures loaded ahead per room, 0 = disabled
+  int iHiresTextureCacheBudget;  // MB of custom textures kept in memory, 0 = automatic
+  bool bCompressHiresTextures;  // transcode PNG custom textures to BC3 and cache them on disk
   bool bDumpEFBTarget;
   bool bDumpFramesAsImages;
+  bool bDumpFramesDropWhenBehind;  // drop frames instead of waiting when the encoder falls behind
   bool bUseFFV1;
   std::string sDumpCodec;
   std::string sDumpFormat;
@@ -193,6 +198,7 @@ struct VideoConfig final
   bool bEnableComputeTextureEncoding;
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
+  bool bDeferEFBCopies;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
   ProjectionHackConfig phack;
@@ -317,6 +323,7 @@ struct VideoConfig final
     bool bSupportsDynamicSamplerIndexing;  // Needed by UberShaders, so must stay in VideoCommon
     bool bSupportsUberShaders;
     bool bSupportsHighPrecisionFrameBuffer;
+    bool bSupportsDeferredEFBCopies;
   } backend_info;
 
   // Utility
@@ -345,6 +352,10 @@ struct VideoConfig final
   {
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
+  inline bool UseDeferredEFBCopies() const
+  {
+    return backend_info.bSupportsDeferredEFBCopies && bDeferEFBCopies;
+  }
   inline bool UseHPFrameBuffer()
   {
     return backend_info.bSupportsHighPrecisionFrameBuffer && bHPFrameBuffer;
@@ -0,0 +1,57 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "Common/Config/CachedValue.h"
+#include "Common/Config/Config.h"
+
+namespace
+{
+const Config::ConfigInfo<int> TEST_VALUE{{Config::System::Main, "Test", "Value"}, 5};
+
+class CachedValueTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::AddLayer(std::make_unique<Config::Layer>(Config::LayerType::Base));
+  }
+  void TearDown() override { Config::Shutdown(); }
+};
+}
+
+TEST_F(CachedValueTest, FollowsConfigChanges)
+{
+  Config::CachedValue<int> value(TEST_VALUE);
+  EXPECT_EQ(5, value.Get());
+
+  Config::SetBase(TEST_VALUE, 7);
+  EXPECT_EQ(7, value.Get());
+
+  // Higher layers override the base layer, even when they are changed directly.
+  Config::GetLayer(Config::LayerType::CurrentRun)->Set(TEST_VALUE, 9);
+  EXPECT_EQ(9, value.Get());
+
+  Config::ClearCurrentRunLayer();
+  EXPECT_EQ(7, value.Get());
+
+  Config::GetLayer(Config::LayerType::Base)->DeleteKey(TEST_VALUE.location);
+  EXPECT_EQ(5, value.Get());
+}
+
+TEST_F(CachedValueTest, RemoveCallback)
+{
+  int calls = 0;
+  const Config::ConfigChangedCallbackID id = Config::AddConfigChangedCallback([&] { ++calls; });
+
+  Config::SetBase(TEST_VALUE, 1);
+  EXPECT_EQ(1, calls);
+
+  Config::RemoveConfigChangedCallback(id);
+  Config::SetBase(TEST_VALUE, 2);
+  EXPECT_EQ(1, calls);
+}
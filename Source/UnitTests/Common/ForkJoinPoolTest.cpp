@@ -0,0 +1,45 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/ForkJoinPool.h"
+
+using Common::ForkJoinPool;
+
+TEST(ForkJoinPool, RunsEveryTaskOnce)
+{
+  ForkJoinPool pool(3, "ForkJoinPoolTest");
+  EXPECT_EQ(4u, pool.GetWorkerCount());
+
+  for (size_t num_tasks = 0; num_tasks < 100; ++num_tasks)
+  {
+    std::vector<std::atomic<int>> runs(num_tasks);
+    std::atomic<bool> bad_worker{false};
+    pool.Run(num_tasks, [&](size_t task, size_t worker) {
+      if (worker >= pool.GetWorkerCount())
+        bad_worker = true;
+      ++runs[task];
+    });
+
+    EXPECT_FALSE(bad_worker);
+    for (const std::atomic<int>& count : runs)
+      EXPECT_EQ(1, count);
+  }
+}
+
+TEST(ForkJoinPool, NoThreads)
+{
+  ForkJoinPool pool(0, "ForkJoinPoolTest");
+  EXPECT_EQ(1u, pool.GetWorkerCount());
+
+  std::vector<size_t> order;
+  pool.Run(5, [&](size_t task, size_t worker) {
+    EXPECT_EQ(0u, worker);
+    order.push_back(task);
+  });
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2, 3, 4}), order);
+}
@@ -0,0 +1,67 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MemArena.h"
+
+TEST(MemArena, DirtyPageTracking)
+{
+  const size_t page_size = MemArena::GetPageSize();
+  MemArena arena;
+  arena.GrabSHMSegment(page_size * 4);
+
+  if (!MemArena::IsDirtyTrackingSupported())
+  {
+    // Without tracking, callers have to be told so instead of seeing every page as clean, and
+    // views still have to work.
+    u8* view = static_cast<u8*>(arena.CreateView(0, page_size * 4));
+    ASSERT_NE(view, nullptr);
+    std::vector<bool> dirty;
+    EXPECT_FALSE(arena.ResetDirtyPages());
+    view[page_size] = 1;
+    EXPECT_EQ(1, view[page_size]);
+    EXPECT_FALSE(arena.GetDirtyPages(0, page_size * 4, &dirty));
+    arena.ReleaseView(view, page_size * 4);
+    arena.ReleaseSHMSegment();
+    return;
+  }
+
+  u8* view = static_cast<u8*>(arena.CreateView(0, page_size * 4));
+  u8* mirror = static_cast<u8*>(arena.CreateView(page_size * 2, page_size * 2));
+  ASSERT_NE(view, nullptr);
+  ASSERT_NE(mirror, nullptr);
+
+  // Writes through either view are attributed to the same segment page.
+  ASSERT_TRUE(arena.ResetDirtyPages());
+  view[0] = 1;
+  mirror[page_size] = 1;
+
+  std::vector<bool> dirty;
+  ASSERT_TRUE(arena.GetDirtyPages(0, page_size * 4, &dirty));
+  EXPECT_EQ(std::vector<bool>({true, false, false, true}), dirty);
+
+  ASSERT_TRUE(arena.ResetDirtyPages());
+  ASSERT_TRUE(arena.GetDirtyPages(0, page_size * 4, &dirty));
+  EXPECT_EQ(std::vector<bool>({false, false, false, false}), dirty);
+
+  // Releasing a view must not lose the writes that went through it.
+  mirror[0] = 2;
+  arena.ReleaseView(mirror, page_size * 2);
+  ASSERT_TRUE(arena.GetDirtyPages(0, page_size * 4, &dirty));
+  EXPECT_EQ(std::vector<bool>({false, false, true, false}), dirty);
+
+  // Views created while tracking are tracked from the start.
+  u8* late = static_cast<u8*>(arena.CreateView(page_size, page_size));
+  ASSERT_NE(late, nullptr);
+  late[0] = 3;
+  ASSERT_TRUE(arena.GetDirtyPages(0, page_size * 4, &dirty));
+  EXPECT_EQ(std::vector<bool>({false, true, true, false}), dirty);
+
+  arena.ReleaseView(late, page_size);
+  arena.ReleaseView(view, page_size * 4);
+  arena.ReleaseSHMSegment();
+}
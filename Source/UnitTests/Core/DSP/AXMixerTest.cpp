@@ -0,0 +1,228 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
+
+using DSP::HLE::AXMixTarget;
+using DSP::HLE::MixAddPath;
+
+namespace
+{
+struct Bus
+{
+  std::vector<int> out;
+  std::array<u16, 2> volume;
+  s16 dpop;
+  bool ramp;
+};
+
+std::vector<Bus> MakeBuses(std::mt19937& rng, size_t num_buses, u32 count)
+{
+  std::uniform_int_distribution<int> dist(0, 0xFFFF);
+  std::vector<Bus> buses(num_buses);
+  for (Bus& bus : buses)
+  {
+    for (u32 i = 0; i < count; ++i)
+      bus.out.push_back(dist(rng) - 0x8000);
+    bus.volume = {static_cast<u16>(dist(rng)), static_cast<u16>(dist(rng))};
+    bus.dpop = static_cast<s16>(dist(rng));
+    bus.ramp = (dist(rng) & 1) != 0;
+  }
+  return buses;
+}
+
+std::vector<AXMixTarget> GetTargets(std::vector<Bus>& buses)
+{
+  std::vector<AXMixTarget> targets;
+  for (Bus& bus : buses)
+    targets.push_back({bus.out.data(), bus.volume.data(), &bus.dpop, bus.ramp});
+  return targets;
+}
+}  // namespace
+
+// Each test runs with every implementation, so that a host with AVX2 also checks SSE4.1. The
+// ones the host can't run pass without doing anything.
+class AXMixerPathTest : public testing::TestWithParam<MixAddPath>
+{
+};
+
+INSTANTIATE_TEST_CASE_P(AllPaths, AXMixerPathTest,
+                        testing::Values(MixAddPath::Generic, MixAddPath::SSE41, MixAddPath::AVX2,
+                                        MixAddPath::NEON));
+
+// Every SIMD mixer must give exactly the same results as mixing one bus at a time, for every bus
+// count and for sample counts that do and don't fill whole vectors. More buses than any voice has
+// take the generic path.
+TEST_P(AXMixerPathTest, MatchesScalarMix)
+{
+  if (!DSP::HLE::IsMixAddPathSupported(GetParam()))
+    return;
+
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 0xFFFF);
+
+  for (size_t num_buses = 1; num_buses <= DSP::HLE::MAX_MIX_TARGETS + 1; ++num_buses)
+  {
+    for (u32 count : {0u, 1u, 3u, 6u, 18u, 32u, 37u, 96u})
+    {
+      std::vector<s16> input(count);
+      for (s16& sample : input)
+        sample = static_cast<s16>(dist(rng));
+      // Exercise the clamping with full-scale samples.
+      if (count > 1)
+      {
+        input[0] = -32768;
+        input[1] = 32767;
+      }
+
+      std::vector<Bus> expected = MakeBuses(rng, num_buses, count);
+      std::vector<Bus> actual = expected;
+
+      std::vector<AXMixTarget> expected_targets = GetTargets(expected);
+      std::vector<AXMixTarget> actual_targets = GetTargets(actual);
+      DSP::HLE::MixAddMultiGeneric(input.data(), count, expected_targets.data(), num_buses);
+      DSP::HLE::MixAddMultiWithPath(GetParam(), input.data(), count, actual_targets.data(),
+                                    num_buses);
+
+      for (size_t b = 0; b < num_buses; ++b)
+      {
+        EXPECT_EQ(expected[b].out, actual[b].out) << num_buses << " buses, " << count << " samples";
+        EXPECT_EQ(expected[b].volume, actual[b].volume);
+        EXPECT_EQ(expected[b].dpop, actual[b].dpop);
+      }
+    }
+  }
+}
+
+TEST_P(AXMixerPathTest, VolumeRampWraps)
+{
+  if (!DSP::HLE::IsMixAddPathSupported(GetParam()))
+    return;
+
+  std::vector<s16> input(96, 0x4000);
+  Bus bus{std::vector<int>(96), {0xFFF0, 0x0003}, 0, true};
+  Bus expected = bus;
+
+  std::vector<Bus> buses{bus};
+  std::vector<AXMixTarget> targets = GetTargets(buses);
+  DSP::HLE::MixAddMultiWithPath(GetParam(), input.data(), 96, targets.data(), 1);
+  DSP::HLE::MixAdd(expected.out.data(), input.data(), 96, expected.volume.data(), &expected.dpop,
+                   true);
+
+  EXPECT_EQ(expected.out, buses[0].out);
+  EXPECT_EQ(expected.volume, buses[0].volume);
+  EXPECT_EQ(static_cast<u16>(0xFFF0 + 96 * 3), buses[0].volume[0]);
+}
+
+namespace
+{
+// A voice of a PB list, with its own volume state for every bus it mixes into.
+struct Voice
+{
+  std::vector<s16> main_input;
+  std::vector<s16> remote_input;
+  std::vector<Bus> buses;
+  std::vector<size_t> bus_indices;
+};
+
+// Laid out like AX Wii: 12 main and aux buses, then 8 smaller buses for the Wii remotes.
+constexpr size_t NUM_MAIN_BUSES = 12;
+constexpr size_t NUM_BUSES = 20;
+constexpr u32 MAIN_BUS_SIZE = 96;
+constexpr u32 REMOTE_BUS_SIZE = 18;
+
+u32 GetBusSize(size_t bus)
+{
+  return bus < NUM_MAIN_BUSES ? MAIN_BUS_SIZE : REMOTE_BUS_SIZE;
+}
+
+void MixVoice(Voice& voice, int* const* buses)
+{
+  std::vector<AXMixTarget> main_targets;
+  std::vector<AXMixTarget> remote_targets;
+  for (size_t i = 0; i < voice.buses.size(); ++i)
+  {
+    const size_t bus = voice.bus_indices[i];
+    Bus& state = voice.buses[i];
+    (bus < NUM_MAIN_BUSES ? main_targets : remote_targets)
+        .push_back({buses[bus], state.volume.data(), &state.dpop, state.ramp});
+  }
+  DSP::HLE::MixAddMulti(voice.main_input.data(), MAIN_BUS_SIZE, main_targets.data(),
+                        main_targets.size());
+  DSP::HLE::MixAddMulti(voice.remote_input.data(), REMOTE_BUS_SIZE, remote_targets.data(),
+                        remote_targets.size());
+}
+}  // namespace
+
+// Mixing the voices of a PB list on worker threads gives exactly the same buses and voice states
+// as mixing them one after the other.
+TEST(AXMixer, ParallelVoicesMatchSerial)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 0xFFFF);
+
+  std::vector<Voice> serial_voices(64);
+  for (Voice& voice : serial_voices)
+  {
+    for (u32 i = 0; i < MAIN_BUS_SIZE; ++i)
+      voice.main_input.push_back(static_cast<s16>(dist(rng)));
+    for (u32 i = 0; i < REMOTE_BUS_SIZE; ++i)
+      voice.remote_input.push_back(static_cast<s16>(dist(rng)));
+    for (size_t bus = 0; bus < NUM_BUSES; ++bus)
+    {
+      if (dist(rng) & 1)
+      {
+        voice.bus_indices.push_back(bus);
+        voice.buses.push_back(MakeBuses(rng, 1, 0)[0]);
+      }
+    }
+  }
+  std::vector<Voice> parallel_voices = serial_voices;
+
+  std::vector<std::vector<int>> serial_buses(NUM_BUSES);
+  for (size_t bus = 0; bus < NUM_BUSES; ++bus)
+  {
+    for (u32 i = 0; i < GetBusSize(bus); ++i)
+      serial_buses[bus].push_back(dist(rng) - 0x8000);
+  }
+  std::vector<std::vector<int>> parallel_buses = serial_buses;
+
+  int* serial_bus_ptrs[NUM_BUSES];
+  int* parallel_bus_ptrs[NUM_BUSES];
+  u32 bus_sizes[NUM_BUSES];
+  for (size_t bus = 0; bus < NUM_BUSES; ++bus)
+  {
+    serial_bus_ptrs[bus] = serial_buses[bus].data();
+    parallel_bus_ptrs[bus] = parallel_buses[bus].data();
+    bus_sizes[bus] = GetBusSize(bus);
+  }
+
+  DSP::HLE::ParallelVoiceMixer mixer(3, "AX Voice Test");
+  ASSERT_EQ(4u, mixer.GetWorkerCount());
+  // Two frames, so that the second one starts with the worker buses the first one left behind.
+  for (int frame = 0; frame < 2; ++frame)
+  {
+    for (Voice& voice : serial_voices)
+      MixVoice(voice, serial_bus_ptrs);
+    mixer.Mix(parallel_voices.size(), parallel_bus_ptrs, bus_sizes, NUM_BUSES,
+              [&](size_t voice, int* const* buses) { MixVoice(parallel_voices[voice], buses); });
+  }
+
+  EXPECT_EQ(serial_buses, parallel_buses);
+  for (size_t v = 0; v < serial_voices.size(); ++v)
+  {
+    for (size_t b = 0; b < serial_voices[v].buses.size(); ++b)
+    {
+      EXPECT_EQ(serial_voices[v].buses[b].volume, parallel_voices[v].buses[b].volume);
+      EXPECT_EQ(serial_voices[v].buses[b].dpop, parallel_voices[v].buses[b].dpop);
+    }
+  }
+}
@@ -0,0 +1,88 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/HostHooks.h"
+#include "Core/PrimeHack/HackManager.h"
+
+namespace
+{
+struct HookRecord
+{
+  std::vector<u32> hits;
+};
+
+void RecordHit(void* userdata, u32 address)
+{
+  static_cast<HookRecord*>(userdata)->hits.push_back(address);
+}
+
+// The owners are only compared, never dereferenced.
+const prime::PrimeMod* MakeOwner(uintptr_t id)
+{
+  return reinterpret_cast<const prime::PrimeMod*>(id);
+}
+}  // namespace
+
+TEST(HostHooks, RunsHookAtAddress)
+{
+  HookRecord record;
+  HostHooks::Add(0x80003100, RecordHit, &record);
+  EXPECT_FALSE(HostHooks::IsEmpty());
+
+  HostHooks::Run(0x80003100);
+  HostHooks::Run(0x80003104);
+  EXPECT_EQ(std::vector<u32>{0x80003100}, record.hits);
+
+  HostHooks::Remove(0x80003100);
+  HostHooks::Run(0x80003100);
+  EXPECT_EQ(1u, record.hits.size());
+  EXPECT_TRUE(HostHooks::IsEmpty());
+}
+
+TEST(HostHooks, AddReplacesHook)
+{
+  HookRecord first, second;
+  HostHooks::Add(0x80003100, RecordHit, &first);
+  HostHooks::Add(0x80003100, RecordHit, &second);
+
+  const HostHooks::Hook* hook = HostHooks::Find(0x80003100);
+  ASSERT_NE(nullptr, hook);
+  EXPECT_EQ(&second, hook->userdata);
+
+  HostHooks::Run(0x80003100);
+  EXPECT_TRUE(first.hits.empty());
+  EXPECT_EQ(1u, second.hits.size());
+
+  HostHooks::Clear();
+  EXPECT_EQ(nullptr, HostHooks::Find(0x80003100));
+}
+
+TEST(HostHooks, HackManagerPcHooks)
+{
+  prime::HackManager manager;
+  std::vector<int> hits;
+  manager.add_pc_hook(0x80003100, MakeOwner(1), [&](u32 pc) {
+    EXPECT_EQ(0x80003100u, pc);
+    hits.push_back(1);
+  });
+  manager.add_pc_hook(0x80003100, MakeOwner(2), [&](u32) { hits.push_back(2); });
+
+  // Both callbacks share one host hook.
+  HostHooks::Run(0x80003100);
+  EXPECT_EQ((std::vector<int>{1, 2}), hits);
+
+  hits.clear();
+  manager.remove_hooks(MakeOwner(1));
+  HostHooks::Run(0x80003100);
+  EXPECT_EQ(std::vector<int>{2}, hits);
+
+  manager.remove_hooks(MakeOwner(2));
+  EXPECT_TRUE(HostHooks::IsEmpty());
+}
@@ -0,0 +1,80 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "BlobTestUtil.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+
+namespace BlobTestUtil
+{
+std::vector<u8> MakeImage(size_t block_size, size_t size)
+{
+  std::vector<u8> image(size);
+  std::mt19937 rng(1234);
+  const std::string text = "The quick brown fox jumps over the lazy dog. ";
+  for (size_t begin = 0; begin < size; begin += block_size)
+  {
+    const size_t end = std::min(begin + block_size, size);
+    switch ((begin / block_size) % 7)
+    {
+    case 0:
+      std::generate(image.begin() + begin, image.begin() + end,
+                    [&rng] { return static_cast<u8>(rng()); });
+      break;
+    case 1:
+      std::copy(image.begin() + begin - block_size, image.begin() + end - block_size,
+                image.begin() + begin);
+      break;
+    case 2:
+      break;
+    default:
+      for (size_t i = begin; i < end; ++i)
+        image[i] = text[i % text.size()];
+      break;
+    }
+  }
+  return image;
+}
+
+bool WriteFile(const std::string& path, const std::vector<u8>& data)
+{
+  File::IOFile file(path, "wb");
+  return file.WriteBytes(data.data(), data.size());
+}
+
+std::vector<u8> ReadFile(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  std::vector<u8> data(file.GetSize());
+  file.ReadBytes(data.data(), data.size());
+  return data;
+}
+
+bool IgnoreProgress(const std::string&, float, void*)
+{
+  return true;
+}
+
+void ImageTest::SetUp()
+{
+  m_dir = File::CreateTempDir();
+  m_image_path = m_dir + "/image.iso";
+}
+
+void ImageTest::TearDown()
+{
+  File::DeleteDirRecursively(m_dir);
+}
+
+void ImageTest::WriteImage(std::vector<u8> image)
+{
+  m_image = std::move(image);
+  ASSERT_TRUE(WriteFile(m_image_path, m_image));
+}
+}  // namespace BlobTestUtil
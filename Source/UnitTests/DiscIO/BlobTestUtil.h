@@ -0,0 +1,39 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+
+namespace BlobTestUtil
+{
+// A disc image of size bytes that repeats a pattern of block_size blocks: random data (which
+// doesn't compress), a copy of that block, zeroes and text.
+std::vector<u8> MakeImage(size_t block_size, size_t size);
+
+bool WriteFile(const std::string& path, const std::vector<u8>& data);
+std::vector<u8> ReadFile(const std::string& path);
+
+// A CompressCB that never cancels.
+bool IgnoreProgress(const std::string& text, float percent, void* arg);
+
+// Writes image to image.iso in a temporary directory, which is deleted after the test.
+class ImageTest : public testing::Test
+{
+protected:
+  void SetUp() override;
+  void TearDown() override;
+
+  void WriteImage(std::vector<u8> image);
+
+  std::string m_dir;
+  std::string m_image_path;
+  std::vector<u8> m_image;
+};
+}  // namespace BlobTestUtil
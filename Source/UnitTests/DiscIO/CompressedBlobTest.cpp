@@ -0,0 +1,114 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/CompressedBlob.h"
+
+#include "BlobTestUtil.h"
+
+namespace
+{
+constexpr u32 BLOCK_SIZE = 16384;
+// More than one compression batch and many read-ahead batches.
+constexpr u32 NUM_BLOCKS = 300;
+
+class CompressedBlobTest : public BlobTestUtil::ImageTest
+{
+protected:
+  void SetUp() override
+  {
+    ImageTest::SetUp();
+    WriteImage(BlobTestUtil::MakeImage(BLOCK_SIZE, BLOCK_SIZE * NUM_BLOCKS));
+    ASSERT_TRUE(DiscIO::CompressFileToBlob(m_image_path, m_dir + "/image.gcz", 0,
+                                           BLOCK_SIZE, BlobTestUtil::IgnoreProgress));
+  }
+};
+}  // namespace
+
+TEST_F(CompressedBlobTest, ReadsBackImage)
+{
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(m_dir + "/image.gcz");
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(DiscIO::BlobType::GCZ, reader->GetBlobType());
+  EXPECT_LT(reader->GetRawSize(), m_image.size());
+  ASSERT_EQ(m_image.size(), reader->GetDataSize());
+
+  // Sequential reads go through the read-ahead.
+  std::vector<u8> data(m_image.size());
+  for (u64 offset = 0; offset < data.size(); offset += BLOCK_SIZE)
+    ASSERT_TRUE(reader->Read(offset, BLOCK_SIZE, &data[offset]));
+  EXPECT_TRUE(data == m_image);
+
+  // Random reads don't, and start in the middle of blocks.
+  std::mt19937 rng(5678);
+  std::vector<u8> part(3000);
+  for (int i = 0; i < 50; ++i)
+  {
+    const u64 offset = rng() % (m_image.size() - part.size());
+    ASSERT_TRUE(reader->Read(offset, part.size(), part.data()));
+    EXPECT_TRUE(std::equal(part.begin(), part.end(), m_image.begin() + offset)) << offset;
+  }
+}
+
+TEST_F(CompressedBlobTest, ThreadedReadsMatchSerialReads)
+{
+  // Going backwards, every block is read on its own on this thread. Going forwards, the
+  // read-ahead decompresses batches of blocks on the worker threads.
+  std::unique_ptr<DiscIO::BlobReader> serial_reader =
+      DiscIO::CreateBlobReader(m_dir + "/image.gcz");
+  std::unique_ptr<DiscIO::BlobReader> threaded_reader =
+      DiscIO::CreateBlobReader(m_dir + "/image.gcz");
+  ASSERT_NE(nullptr, serial_reader);
+  ASSERT_NE(nullptr, threaded_reader);
+
+  std::vector<u8> serial(m_image.size());
+  for (u64 block = NUM_BLOCKS; block-- > 0;)
+    ASSERT_TRUE(serial_reader->Read(block * BLOCK_SIZE, BLOCK_SIZE, &serial[block * BLOCK_SIZE]));
+
+  std::vector<u8> threaded(m_image.size());
+  ASSERT_TRUE(threaded_reader->Read(0, threaded.size(), threaded.data()));
+
+  EXPECT_TRUE(serial == threaded);
+  EXPECT_TRUE(serial == m_image);
+}
+
+TEST_F(CompressedBlobTest, Decompress)
+{
+  ASSERT_TRUE(DiscIO::DecompressBlobToFile(m_dir + "/image.gcz", m_dir + "/decompressed.iso",
+                                           BlobTestUtil::IgnoreProgress));
+  EXPECT_TRUE(BlobTestUtil::ReadFile(m_dir + "/decompressed.iso") == m_image);
+}
+
+TEST_F(CompressedBlobTest, RejectsOutOfOrderBlocks)
+{
+  // Point block 10 at the start of the data, which makes the size of block 9 underflow.
+  {
+    File::IOFile file(m_dir + "/image.gcz", "r+b");
+    u64 pointers[2];
+    ASSERT_TRUE(file.Seek(sizeof(DiscIO::CompressedBlobHeader) + 9 * sizeof(u64), SEEK_SET));
+    ASSERT_TRUE(file.ReadArray(pointers, 2));
+    pointers[1] = 0;
+    ASSERT_TRUE(file.Seek(sizeof(DiscIO::CompressedBlobHeader) + 9 * sizeof(u64), SEEK_SET));
+    ASSERT_TRUE(file.WriteArray(pointers, 2));
+  }
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(m_dir + "/image.gcz");
+  ASSERT_NE(nullptr, reader);
+  std::vector<u8> data(BLOCK_SIZE * 8);
+  // The first blocks of the read-ahead batch are still fine.
+  ASSERT_TRUE(reader->Read(0, data.size(), data.data()));
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), m_image.begin()));
+  EXPECT_FALSE(reader->Read(BLOCK_SIZE * 9, BLOCK_SIZE, data.data()));
+}
@@ -0,0 +1,105 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DCZBlob.h"
+
+#include "BlobTestUtil.h"
+
+namespace
+{
+constexpr u32 CHUNK_SIZE = DiscIO::DCZ_MIN_CHUNK_SIZE;
+
+class DCZBlobTest : public BlobTestUtil::ImageTest
+{
+protected:
+  void SetUp() override
+  {
+    ImageTest::SetUp();
+    // Random data, a copy of it, zeroes and text, with a partial last chunk.
+    WriteImage(BlobTestUtil::MakeImage(CHUNK_SIZE, CHUNK_SIZE * 5 + 1000));
+    ASSERT_TRUE(DiscIO::ConvertToDCZ(m_image_path, m_dir + "/image.dcz",
+                                     DiscIO::DCZCodec::Deflate, CHUNK_SIZE, false));
+  }
+};
+}  // namespace
+
+TEST_F(DCZBlobTest, ReadsBackImage)
+{
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(m_dir + "/image.dcz");
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(DiscIO::BlobType::DCZ, reader->GetBlobType());
+  ASSERT_EQ(m_image.size(), reader->GetDataSize());
+
+  std::vector<u8> data(m_image.size());
+  ASSERT_TRUE(reader->Read(0, data.size(), data.data()));
+  EXPECT_TRUE(data == m_image);
+
+  // A read across chunks that are stored differently.
+  const u64 offset = CHUNK_SIZE * 2 - 100;
+  std::vector<u8> part(CHUNK_SIZE + 200);
+  ASSERT_TRUE(reader->Read(offset, part.size(), part.data()));
+  EXPECT_TRUE(std::equal(part.begin(), part.end(), m_image.begin() + offset));
+}
+
+TEST_F(DCZBlobTest, StoresDuplicateChunksOnce)
+{
+  // The two random chunks can't be compressed, so without deduplication they alone would be as
+  // big as this.
+  EXPECT_LT(File::GetSize(m_dir + "/image.dcz"), CHUNK_SIZE * 2);
+}
+
+TEST_F(DCZBlobTest, Decompress)
+{
+  ASSERT_TRUE(DiscIO::DecompressDCZToFile(m_dir + "/image.dcz", m_dir + "/decompressed.iso"));
+  EXPECT_TRUE(BlobTestUtil::ReadFile(m_dir + "/decompressed.iso") == m_image);
+}
+
+TEST_F(DCZBlobTest, RejectsInvalidChunkSize)
+{
+  EXPECT_FALSE(DiscIO::ConvertToDCZ(m_image_path, m_dir + "/bad.dcz",
+                                    DiscIO::DCZCodec::Deflate, CHUNK_SIZE + 1, false));
+  EXPECT_FALSE(File::Exists(m_dir + "/bad.dcz"));
+}
+
+TEST_F(DCZBlobTest, RejectsCorruptHeaders)
+{
+  // A chunk table far bigger than the file.
+  DiscIO::DCZHeader header = {};
+  header.magic_cookie = DiscIO::DCZ_MAGIC;
+  header.version = DiscIO::DCZ_VERSION;
+  header.codec = static_cast<u32>(DiscIO::DCZCodec::Deflate);
+  header.chunk_size = CHUNK_SIZE;
+  header.num_chunks = UINT32_MAX;
+  header.data_size = static_cast<u64>(header.num_chunks) * CHUNK_SIZE;
+  {
+    File::IOFile file(m_dir + "/huge.dcz", "wb");
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+  }
+  EXPECT_EQ(nullptr, DiscIO::CreateBlobReader(m_dir + "/huge.dcz"));
+
+  // A chunk whose offset wraps around when its size is added.
+  header.num_chunks = 1;
+  header.data_size = CHUNK_SIZE;
+  DiscIO::DCZChunkEntry entry = {};
+  entry.offset = UINT64_MAX - 10;
+  entry.stored_size = 100;
+  {
+    File::IOFile file(m_dir + "/wrap.dcz", "wb");
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+    ASSERT_TRUE(file.WriteArray(&entry, 1));
+  }
+  EXPECT_EQ(nullptr, DiscIO::CreateBlobReader(m_dir + "/wrap.dcz"));
+}
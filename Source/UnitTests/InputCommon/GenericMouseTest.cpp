@@ -0,0 +1,179 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/Flag.h"
+#include "InputCommon/GenericMouse.h"
+
+// Measures how old mouse motion is by the time a frame latches it, using synthetic motion events
+// instead of a real mouse. This simulates the emulator's threads: SI polls at 120 Hz, and the
+// PrimeHack mods latch the mouse once per 60 Hz frame.
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+class SyntheticMouse final : public prime::GenericMouse
+{
+public:
+  SyntheticMouse() { cursor_locked = true; }
+  ~SyntheticMouse() override { StopInputThread(); }
+
+  void Inject(int32_t delta)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_injected.push_back(Clock::now());
+    m_injected_total += delta;
+  }
+
+  void PollDeltas() override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AddDeltas(static_cast<int32_t>(m_injected_total), 0);
+    m_injected_total = 0;
+    m_polled.insert(m_polled.end(), m_injected.begin(), m_injected.end());
+    m_injected.clear();
+  }
+
+  void LockCursorToGameWindow() override {}
+
+  // Latches like the frame hook does, and records how long ago each latched event happened.
+  void LatchFrame(std::vector<double>* latencies_ms)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    LatchDeltas();
+    const Clock::time_point now = Clock::now();
+    for (const Clock::time_point& time : m_polled)
+      latencies_ms->push_back(std::chrono::duration<double, std::milli>(now - time).count());
+    m_polled.clear();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<Clock::time_point> m_injected;
+  std::vector<Clock::time_point> m_polled;
+  s64 m_injected_total = 0;
+};
+
+struct LatencyResult
+{
+  s64 injected = 0;
+  s64 latched = 0;
+  std::vector<double> latencies_ms;
+};
+
+LatencyResult MeasureLatency(bool use_input_thread)
+{
+  SyntheticMouse mouse;
+  if (use_input_thread)
+    mouse.StartInputThread();
+
+  Common::Flag running(true);
+  LatencyResult result;
+
+  std::thread input([&] {
+    while (running.IsSet())
+    {
+      mouse.Inject(1);
+      ++result.injected;
+      std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  });
+  std::thread si([&] {
+    while (running.IsSet())
+    {
+      mouse.UpdateInput();
+      std::this_thread::sleep_for(std::chrono::microseconds(8333));
+    }
+  });
+
+  for (int frame = 0; frame < 30; ++frame)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(16667));
+    mouse.LatchFrame(&result.latencies_ms);
+    result.latched += mouse.GetDeltaHorizontalAxis();
+  }
+
+  running.Clear();
+  input.join();
+  si.join();
+  mouse.StopInputThread();
+
+  // Everything that was injected has to show up eventually.
+  mouse.PollDeltas();
+  mouse.LatchFrame(&result.latencies_ms);
+  result.latched += mouse.GetDeltaHorizontalAxis();
+  return result;
+}
+
+class CountingMouse final : public prime::GenericMouse
+{
+public:
+  ~CountingMouse() override { StopInputThread(); }
+
+  void PollDeltas() override { ++polls; }
+  void LockCursorToGameWindow() override {}
+  void SetCursorLocked(bool locked) { cursor_locked = locked; }
+
+  std::atomic<int> polls{0};
+};
+
+void Report(const char* name, LatencyResult* result)
+{
+  std::vector<double>& latencies = result->latencies_ms;
+  if (latencies.empty())
+    return;
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%s: median %.2f ms, 99th percentile %.2f ms over %zu events\n", name,
+              latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+              latencies.size());
+}
+}
+
+TEST(GenericMouse, SIPollingLatency)
+{
+  LatencyResult result = MeasureLatency(false);
+  EXPECT_EQ(result.injected, result.latched);
+  Report("SI polling", &result);
+}
+
+TEST(GenericMouse, InputThreadLatency)
+{
+  LatencyResult result = MeasureLatency(true);
+  EXPECT_EQ(result.injected, result.latched);
+  Report("Input thread", &result);
+}
+
+TEST(GenericMouse, InputThreadParksWhileCursorUnlocked)
+{
+  CountingMouse mouse;
+  mouse.StartInputThread();
+
+  // Only SI polls while the cursor isn't locked.
+  mouse.UpdateInput();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(1, mouse.polls);
+
+  mouse.SetCursorLocked(true);
+  mouse.UpdateInput();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LT(10, mouse.polls);
+
+  // Losing the lock parks the thread again.
+  mouse.SetCursorLocked(false);
+  mouse.UpdateInput();
+  const int polls = mouse.polls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(polls, mouse.polls);
+
+  mouse.StopInputThread();
+}
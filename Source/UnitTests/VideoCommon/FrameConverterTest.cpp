@@ -0,0 +1,95 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+}
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FrameConverter.h"
+
+namespace
+{
+struct FrameDeleter
+{
+  void operator()(AVFrame* frame) const { av_frame_free(&frame); }
+};
+using FramePtr = std::unique_ptr<AVFrame, FrameDeleter>;
+
+FramePtr AllocateFrame(AVPixelFormat format, int width, int height)
+{
+  FramePtr frame(av_frame_alloc());
+  frame->format = format;
+  frame->width = width;
+  frame->height = height;
+  if (av_frame_get_buffer(frame.get(), 0) < 0)
+    return nullptr;
+  return frame;
+}
+
+// Noise changes from row to row as much as anything can, so a filter that is cut off at the edge
+// of a band is bound to show.
+std::vector<u8> MakeNoise(size_t size)
+{
+  std::vector<u8> image(size);
+  std::mt19937 rng(1234);
+  for (u8& value : image)
+    value = static_cast<u8>(rng());
+  return image;
+}
+
+void ExpectSameConversion(AVPixelFormat src_format, int bytes_per_pixel, int width, int height)
+{
+  const AVPixelFormat dst_format = AV_PIX_FMT_YUV420P;
+  const std::vector<u8> image = MakeNoise(static_cast<size_t>(width) * height * bytes_per_pixel);
+  const int stride = width * bytes_per_pixel;
+
+  FramePtr single = AllocateFrame(dst_format, width, height);
+  FramePtr banded = AllocateFrame(dst_format, width, height);
+  ASSERT_NE(nullptr, single);
+  ASSERT_NE(nullptr, banded);
+
+  FrameConverter single_converter(1);
+  FrameConverter banded_converter(4);
+  ASSERT_TRUE(single_converter.Convert(image.data(), stride, src_format, width, height,
+                                       single.get()));
+  ASSERT_TRUE(banded_converter.Convert(image.data(), stride, src_format, width, height,
+                                       banded.get()));
+
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(dst_format);
+  for (int plane = 0; plane < 3; plane++)
+  {
+    const int shift_x = plane == 0 ? 0 : desc->log2_chroma_w;
+    const int shift_y = plane == 0 ? 0 : desc->log2_chroma_h;
+    const int plane_width = (width + (1 << shift_x) - 1) >> shift_x;
+    const int plane_height = (height + (1 << shift_y) - 1) >> shift_y;
+    for (int y = 0; y < plane_height; y++)
+    {
+      const u8* single_row = single->data[plane] + y * single->linesize[plane];
+      const u8* banded_row = banded->data[plane] + y * banded->linesize[plane];
+      ASSERT_TRUE(std::equal(single_row, single_row + plane_width, banded_row))
+          << "plane " << plane << ", row " << y;
+    }
+  }
+}
+}  // namespace
+
+TEST(FrameConverter, BandsMatchSingleContext)
+{
+  ExpectSameConversion(AV_PIX_FMT_BGR24, 3, 1280, 720);
+  ExpectSameConversion(AV_PIX_FMT_RGBA, 4, 1280, 720);
+}
+
+TEST(FrameConverter, PartialLastBand)
+{
+  ExpectSameConversion(AV_PIX_FMT_RGBA, 4, 640, 482);
+}
@@ -0,0 +1,133 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/RoomUsageProfiler.h"
+
+using namespace RoomUsage;
+
+namespace
+{
+constexpr RoomKey ROOM_A = MakeRoomKey(1, 1);
+constexpr RoomKey ROOM_B = MakeRoomKey(1, 2);
+constexpr RoomKey ROOM_C = MakeRoomKey(2, 1);
+
+std::vector<std::string> Sorted(std::vector<std::string> values)
+{
+  std::sort(values.begin(), values.end());
+  return values;
+}
+}
+
+TEST(RoomGraph, LearnsTransitions)
+{
+  RoomGraph graph;
+  EXPECT_EQ(NO_ROOM, graph.GetCurrentRoom());
+  EXPECT_TRUE(graph.IsEmpty());
+
+  const u32 serial = graph.GetRoomSerial();
+  EXPECT_TRUE(graph.Enter(ROOM_A));
+  EXPECT_FALSE(graph.Enter(ROOM_A));
+  EXPECT_EQ(ROOM_A, graph.GetCurrentRoom());
+  EXPECT_EQ(serial + 1, graph.GetRoomSerial());
+
+  // A -> B twice, A -> C once.
+  graph.Enter(ROOM_B);
+  graph.Enter(ROOM_A);
+  graph.Enter(ROOM_C);
+  graph.Enter(ROOM_A);
+  graph.Enter(ROOM_B);
+
+  EXPECT_EQ(std::vector<RoomKey>({ROOM_B, ROOM_C}), graph.GetNextRooms(ROOM_A, 3));
+  EXPECT_EQ(std::vector<RoomKey>({ROOM_B}), graph.GetNextRooms(ROOM_A, 1));
+  EXPECT_EQ(std::vector<RoomKey>({ROOM_A}), graph.GetNextRooms(ROOM_C, 3));
+}
+
+TEST(RoomGraph, LeavingIsNotATransition)
+{
+  RoomGraph graph;
+  graph.Enter(ROOM_A);
+  graph.Leave();
+  EXPECT_EQ(NO_ROOM, graph.GetCurrentRoom());
+  graph.Enter(ROOM_B);
+
+  EXPECT_TRUE(graph.IsEmpty());
+  EXPECT_TRUE(graph.GetNextRooms(ROOM_A, 3).empty());
+}
+
+TEST(RoomGraph, SaveAndLoad)
+{
+  const std::string dir = File::CreateTempDir();
+  const std::string path = dir + "/test.rooms";
+
+  RoomGraph graph;
+  graph.Enter(ROOM_A);
+  graph.Enter(ROOM_B);
+  graph.Enter(ROOM_A);
+  graph.Enter(ROOM_C);
+  graph.Enter(ROOM_A);
+  graph.Enter(ROOM_C);
+  ASSERT_TRUE(graph.Save(path));
+
+  RoomGraph loaded;
+  ASSERT_TRUE(loaded.Load(path));
+  EXPECT_EQ(std::vector<RoomKey>({ROOM_C, ROOM_B}), loaded.GetNextRooms(ROOM_A, 3));
+  EXPECT_EQ(std::vector<RoomKey>({ROOM_A}), loaded.GetNextRooms(ROOM_B, 3));
+
+  File::DeleteDirRecursively(dir);
+}
+
+TEST(RoomUsageProfile, RecordsPerRoom)
+{
+  RoomUsageProfile<std::string> profile;
+  profile.Record(ROOM_A, "tex1");
+  profile.Record(ROOM_A, "tex2");
+  profile.Record(ROOM_A, "tex1");
+  profile.Record(ROOM_B, "tex3");
+  // Objects used outside of any room aren't attributed to one.
+  profile.Record(NO_ROOM, "tex4");
+
+  EXPECT_EQ(2u, profile.GetRoomCount());
+  EXPECT_EQ(std::vector<std::string>({"tex1", "tex2"}), Sorted(profile.Get(ROOM_A)));
+  EXPECT_EQ(std::vector<std::string>({"tex3"}), profile.Get(ROOM_B));
+  EXPECT_TRUE(profile.Get(ROOM_C).empty());
+}
+
+TEST(RoomUsageProfile, SaveAndLoad)
+{
+  const std::string dir = File::CreateTempDir();
+  const std::string path = dir + "/test.roomtex";
+
+  RoomUsageProfile<std::string> profile(1);
+  profile.Record(ROOM_A, "tex1");
+  profile.Record(ROOM_A, "tex2");
+  profile.Record(ROOM_C, "");
+  ASSERT_TRUE(profile.Save(path));
+
+  RoomUsageProfile<std::string> loaded(1);
+  ASSERT_TRUE(loaded.Load(path));
+  EXPECT_EQ(2u, loaded.GetRoomCount());
+  EXPECT_EQ(std::vector<std::string>({"tex1", "tex2"}), Sorted(loaded.Get(ROOM_A)));
+  EXPECT_EQ(std::vector<std::string>({""}), loaded.Get(ROOM_C));
+
+  // Profiles of another version are ignored.
+  RoomUsageProfile<std::string> other_version(2);
+  EXPECT_FALSE(other_version.Load(path));
+  EXPECT_EQ(0u, other_version.GetRoomCount());
+
+  RoomUsageProfile<u32> trivial;
+  trivial.Record(ROOM_B, 42);
+  ASSERT_TRUE(trivial.Save(path));
+  RoomUsageProfile<u32> trivial_loaded;
+  ASSERT_TRUE(trivial_loaded.Load(path));
+  EXPECT_EQ(std::vector<u32>({42}), trivial_loaded.Get(ROOM_B));
+
+  File::DeleteDirRecursively(dir);
+}
@@ -0,0 +1,318 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SOIL/SOIL.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/ImageWrite.h"
+#include "VideoCommon/TextureTranscoder.h"
+
+namespace
+{
+void Expand565(u16 color, int* rgb)
+{
+  const int r = color >> 11;
+  const int g = (color >> 5) & 0x3f;
+  const int b = color & 0x1f;
+  rgb[0] = (r << 3) | (r >> 2);
+  rgb[1] = (g << 2) | (g >> 4);
+  rgb[2] = (b << 3) | (b >> 2);
+}
+
+// A plain BC3 decoder, to check the encoder against.
+std::vector<u8> DecodeBC3(const std::vector<u8>& src, u32 width, u32 height)
+{
+  std::vector<u8> dst(width * height * 4);
+  const u8* block = src.data();
+  for (u32 block_y = 0; block_y < height; block_y += 4)
+  {
+    for (u32 block_x = 0; block_x < width; block_x += 4, block += 16)
+    {
+      int alpha[8] = {block[0], block[1]};
+      for (int i = 2; i < 8; i++)
+      {
+        alpha[i] = alpha[0] > alpha[1] ? ((8 - i) * alpha[0] + (i - 1) * alpha[1]) / 7 :
+                                         i < 6 ? ((6 - i) * alpha[0] + (i - 1) * alpha[1]) / 5 :
+                                                 i == 6 ? 0 : 255;
+      }
+      u64 alpha_indices = 0;
+      for (int i = 0; i < 6; i++)
+        alpha_indices |= static_cast<u64>(block[2 + i]) << (8 * i);
+
+      const u16 color0 = block[8] | (block[9] << 8);
+      const u16 color1 = block[10] | (block[11] << 8);
+      int colors[4][3];
+      Expand565(color0, colors[0]);
+      Expand565(color1, colors[1]);
+      for (int c = 0; c < 3; c++)
+      {
+        colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+        colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+      }
+      const u32 color_indices =
+          block[12] | (block[13] << 8) | (block[14] << 16) | (static_cast<u32>(block[15]) << 24);
+
+      for (u32 i = 0; i < 16; i++)
+      {
+        const u32 x = block_x + i % 4;
+        const u32 y = block_y + i / 4;
+        if (x >= width || y >= height)
+          continue;
+        u8* pixel = &dst[(y * width + x) * 4];
+        const int* color = colors[(color_indices >> (2 * i)) & 3];
+        for (int c = 0; c < 3; c++)
+          pixel[c] = static_cast<u8>(color[c]);
+        pixel[3] = static_cast<u8>(alpha[(alpha_indices >> (3 * i)) & 7]);
+      }
+    }
+  }
+  return dst;
+}
+
+int MaxError(const std::vector<u8>& a, const std::vector<u8>& b, int component)
+{
+  int error = 0;
+  for (size_t i = component; i < a.size(); i += 4)
+    error = std::max(error, std::abs(a[i] - b[i]));
+  return error;
+}
+
+std::vector<u8> EncodeAndDecode(const std::vector<u8>& image, u32 width, u32 height)
+{
+  std::vector<u8> encoded(TextureTranscoder::GetBC3Size(width, height));
+  TextureTranscoder::EncodeBC3(image.data(), width, height, encoded.data());
+  return DecodeBC3(encoded, width, height);
+}
+
+struct PackTexture
+{
+  std::string path;
+  u32 width;
+  u32 height;
+};
+
+// Writes a stand-in for a texture pack: noisy gradients, which compress about as well as painted
+// textures do, in the sizes most packs are made of.
+std::vector<PackTexture> WritePack(const std::string& dir)
+{
+  static constexpr struct
+  {
+    u32 size;
+    u32 count;
+  } sizes[] = {{1024, 8}, {512, 16}, {256, 32}};
+
+  std::vector<PackTexture> pack;
+  std::mt19937 rng(1234);
+  for (const auto& entry : sizes)
+  {
+    std::vector<u8> image(entry.size * entry.size * 4);
+    for (u32 i = 0; i < entry.count; i++)
+    {
+      for (u32 y = 0; y < entry.size; y++)
+      {
+        for (u32 x = 0; x < entry.size; x++)
+        {
+          u8* pixel = &image[(y * entry.size + x) * 4];
+          const u32 noise = rng() % 32;
+          pixel[0] = static_cast<u8>(x * 224 / entry.size + noise);
+          pixel[1] = static_cast<u8>(y * 224 / entry.size + noise);
+          pixel[2] = static_cast<u8>(i * 16 + noise);
+          pixel[3] = 255;
+        }
+      }
+
+      const std::string path = StringFromFormat("%s/tex_%u_%u.png", dir.c_str(), entry.size, i);
+      if (!TextureToPng(image.data(), entry.size * 4, path, entry.size, entry.size, true))
+        return {};
+      pack.push_back({path, entry.size, entry.size});
+    }
+  }
+  return pack;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+TEST(TextureTranscoder, BC3Size)
+{
+  EXPECT_EQ(16u, TextureTranscoder::GetBC3Size(1, 1));
+  EXPECT_EQ(16u, TextureTranscoder::GetBC3Size(4, 4));
+  EXPECT_EQ(64u, TextureTranscoder::GetBC3Size(5, 5));
+  EXPECT_EQ(256u * 256, TextureTranscoder::GetBC3Size(256, 256));
+}
+
+TEST(TextureTranscoder, BaseLevelSize)
+{
+  EXPECT_TRUE(TextureTranscoder::IsValidBaseLevelSize(256, 128));
+  EXPECT_TRUE(TextureTranscoder::IsValidBaseLevelSize(4, 4));
+  EXPECT_FALSE(TextureTranscoder::IsValidBaseLevelSize(250, 256));
+  EXPECT_FALSE(TextureTranscoder::IsValidBaseLevelSize(256, 2));
+}
+
+TEST(TextureTranscoder, SolidColor)
+{
+  std::vector<u8> image(8 * 8 * 4);
+  for (size_t i = 0; i < image.size(); i += 4)
+  {
+    image[i] = 200;
+    image[i + 1] = 100;
+    image[i + 2] = 50;
+    image[i + 3] = 255;
+  }
+
+  const std::vector<u8> decoded = EncodeAndDecode(image, 8, 8);
+  // Only limited by the precision of 565.
+  EXPECT_LE(MaxError(image, decoded, 0), 4);
+  EXPECT_LE(MaxError(image, decoded, 1), 2);
+  EXPECT_LE(MaxError(image, decoded, 2), 4);
+  EXPECT_EQ(0, MaxError(image, decoded, 3));
+}
+
+TEST(TextureTranscoder, Gradient)
+{
+  std::vector<u8> image(16 * 16 * 4);
+  for (u32 y = 0; y < 16; y++)
+  {
+    for (u32 x = 0; x < 16; x++)
+    {
+      u8* pixel = &image[(y * 16 + x) * 4];
+      // Green goes the other way, so the encoder has to pick the right diagonal.
+      pixel[0] = static_cast<u8>(x * 16);
+      pixel[1] = static_cast<u8>(255 - x * 16);
+      pixel[2] = static_cast<u8>(64 + x * 8);
+      pixel[3] = static_cast<u8>((x + y) * 8);
+    }
+  }
+
+  const std::vector<u8> decoded = EncodeAndDecode(image, 16, 16);
+  for (int c = 0; c < 4; c++)
+    EXPECT_LE(MaxError(image, decoded, c), 16) << "component " << c;
+}
+
+TEST(TextureTranscoder, PunchThroughAlpha)
+{
+  std::vector<u8> image(4 * 4 * 4, 255);
+  for (size_t i = 0; i < image.size(); i += 8)
+    image[i + 3] = 0;
+
+  const std::vector<u8> decoded = EncodeAndDecode(image, 4, 4);
+  EXPECT_EQ(0, MaxError(image, decoded, 3));
+}
+
+TEST(TextureTranscoder, PartialBlocks)
+{
+  // The padding repeats the edge pixels, so it doesn't add colors that aren't in the image.
+  const u32 width = 5;
+  const u32 height = 3;
+  std::vector<u8> image(width * height * 4);
+  for (size_t i = 0; i < image.size(); i += 4)
+  {
+    const bool left = (i / 4) % width < 4;
+    image[i] = left ? 0 : 255;
+    image[i + 1] = left ? 0 : 255;
+    image[i + 2] = left ? 0 : 255;
+    image[i + 3] = 255;
+  }
+
+  const std::vector<u8> decoded = EncodeAndDecode(image, width, height);
+  for (int c = 0; c < 4; c++)
+    EXPECT_EQ(0, MaxError(image, decoded, c)) << "component " << c;
+}
+
+// Follows what loading a PNG texture costs with CompressHiresTextures off, in the first session
+// with it on, and once the disk cache is filled.
+TEST(TextureTranscoder, PackLoadSpeed)
+{
+  const std::string dir = File::CreateTempDir();
+  ASSERT_FALSE(dir.empty());
+  File::SetUserPath(D_USER_IDX, dir + DIR_SEP "User" DIR_SEP);
+  const std::vector<PackTexture> pack = WritePack(dir);
+  ASSERT_FALSE(pack.empty());
+
+  size_t png_bytes = 0;
+  size_t rgba_bytes = 0;
+  size_t bc3_bytes = 0;
+  double plain_ms = 0;
+  double cold_ms = 0;
+  double encode_ms = 0;
+  double warm_ms = 0;
+  for (const PackTexture& texture : pack)
+  {
+    // Off: the PNG is decoded every time.
+    auto start = std::chrono::steady_clock::now();
+    std::string png;
+    ASSERT_TRUE(File::ReadFileToString(texture.path, png));
+    int width, height, channels;
+    u8* rgba = SOIL_load_image_from_memory(reinterpret_cast<const u8*>(png.data()),
+                                           static_cast<int>(png.size()), &width, &height,
+                                           &channels, SOIL_LOAD_RGBA);
+    ASSERT_NE(nullptr, rgba);
+    plain_ms += MillisecondsSince(start);
+    SOIL_free_image_data(rgba);
+    png_bytes += png.size();
+    rgba_bytes += static_cast<size_t>(width) * height * 4;
+
+    // First session: the cache misses and the PNG is decoded, then encoded in the background.
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(File::ReadFileToString(texture.path, png));
+    const u8* png_data = reinterpret_cast<const u8*>(png.data());
+    const u64 hash = TextureTranscoder::HashImageFile(png_data, png.size());
+    EXPECT_FALSE(TextureTranscoder::LoadCached(hash, [](u32, u32, size_t) { return nullptr; }));
+    rgba = SOIL_load_image_from_memory(png_data, static_cast<int>(png.size()), &width, &height,
+                                       &channels, SOIL_LOAD_RGBA);
+    ASSERT_NE(nullptr, rgba);
+    cold_ms += MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<u8> encoded(TextureTranscoder::GetBC3Size(width, height));
+    TextureTranscoder::EncodeBC3(rgba, width, height, encoded.data());
+    TextureTranscoder::Store(hash, width, height, encoded.data(), encoded.size());
+    encode_ms += MillisecondsSince(start);
+    SOIL_free_image_data(rgba);
+
+    // Later sessions: the PNG is only hashed, and BC3 is read from the cache.
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(File::ReadFileToString(texture.path, png));
+    std::vector<u8> cached;
+    ASSERT_TRUE(TextureTranscoder::LoadCached(
+        TextureTranscoder::HashImageFile(reinterpret_cast<const u8*>(png.data()), png.size()),
+        [&](u32 cached_width, u32 cached_height, size_t size) {
+          EXPECT_EQ(texture.width, cached_width);
+          EXPECT_EQ(texture.height, cached_height);
+          cached.resize(size);
+          return cached.data();
+        }));
+    warm_ms += MillisecondsSince(start);
+    EXPECT_TRUE(cached == encoded);
+    bc3_bytes += cached.size();
+  }
+
+  printf("%zu textures, %.1f MB of PNG\n", pack.size(), png_bytes / (1024.0 * 1024.0));
+  printf("CompressHiresTextures off:  load %.1f ms, resident %.1f MB\n", plain_ms,
+         rgba_bytes / (1024.0 * 1024.0));
+  printf("CompressHiresTextures cold: load %.1f ms (+%.1f ms encoding), resident %.1f MB\n",
+         cold_ms, encode_ms, rgba_bytes / (1024.0 * 1024.0));
+  printf("CompressHiresTextures warm: load %.1f ms, resident %.1f MB\n", warm_ms,
+         bc3_bytes / (1024.0 * 1024.0));
+  EXPECT_EQ(rgba_bytes, bc3_bytes * 4);
+
+  File::DeleteDirRecursively(dir);
+}
@@ -0,0 +1,87 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureUploadQueue.h"
+
+namespace
+{
+TextureUploadQueue::Upload MakeUpload(void* owner)
+{
+  TextureUploadQueue::Upload upload;
+  upload.owner = owner;
+  return upload;
+}
+}  // namespace
+
+TEST(TextureUploadQueue, CopiesIntoRing)
+{
+  TextureUploadQueue queue;
+  int owner;
+  std::vector<u8> data(1024, 0x5a);
+  ASSERT_TRUE(queue.Push(MakeUpload(&owner), data.data(), data.size()));
+  data.assign(data.size(), 0);
+
+  size_t processed = 0;
+  queue.Process(SIZE_MAX, [&](const TextureUploadQueue::Upload& upload, const u8* ptr) {
+    EXPECT_EQ(&owner, upload.owner);
+    EXPECT_NE(data.data(), ptr);
+    EXPECT_EQ(0x5a, ptr[0]);
+    EXPECT_EQ(0x5a, ptr[1023]);
+    processed++;
+  });
+  EXPECT_EQ(1u, processed);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(TextureUploadQueue, SharedDataIsNotCopied)
+{
+  TextureUploadQueue queue;
+  int owner;
+  auto data = std::make_shared<std::vector<u8>>(1024, 0x5a);
+  std::shared_ptr<const u8> ptr(data, data->data());
+  queue.Push(MakeUpload(&owner), ptr, data->size());
+  EXPECT_EQ(1024u, queue.GetPendingBytes());
+
+  // The queue keeps the data alive.
+  const u8* raw = ptr.get();
+  data.reset();
+  ptr.reset();
+
+  size_t processed = 0;
+  queue.Process(SIZE_MAX, [&](const TextureUploadQueue::Upload& upload, const u8* upload_data) {
+    EXPECT_EQ(raw, upload_data);
+    EXPECT_EQ(0x5a, upload_data[0]);
+    processed++;
+  });
+  EXPECT_EQ(1u, processed);
+  EXPECT_EQ(0u, queue.GetPendingBytes());
+}
+
+TEST(TextureUploadQueue, SharedDataTakesNoRingSpace)
+{
+  TextureUploadQueue queue;
+  int owner;
+  std::vector<u8> full(TextureUploadQueue::STAGING_RING_SIZE);
+  auto shared = std::make_shared<u8>(0);
+
+  // A shared upload in front of the ring uploads doesn't change where they are allocated.
+  queue.Push(MakeUpload(&owner), shared, 1);
+  EXPECT_TRUE(queue.CanPush(full.size()));
+  ASSERT_TRUE(queue.Push(MakeUpload(&owner), full.data(), full.size()));
+  EXPECT_FALSE(queue.CanPush(1));
+
+  queue.Push(MakeUpload(&owner), shared, 1);
+  EXPECT_EQ(full.size() + 2, queue.GetPendingBytes());
+
+  // Processing the ring upload frees the whole ring, even with a shared upload queued after it.
+  queue.Process(full.size() + 1, [](const TextureUploadQueue::Upload&, const u8*) {});
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_TRUE(queue.CanPush(full.size()));
+}